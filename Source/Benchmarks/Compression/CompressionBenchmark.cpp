@@ -0,0 +1,254 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+// Measures throughput of message compression, comparing the reusable per-thread zlib contexts
+// used by Compress/Decompress against creating a new zlib stream for every message (which is
+// what the server used to do).
+//
+// Also measures splicing a precompressed payload behind a freshly compressed message header, which
+// is what cached list responses (see ListResponseCache) do instead of compressing each response.
+//
+// Usage: CompressionBenchmark [iterations] [payload files ...]
+//
+// Each payload file should contain a single uncompressed message payload, eg. a ghost or bloodstain
+// list response captured from a running server. If none are given, synthetic payloads that roughly
+// resemble ghost replay data are used instead.
+
+#include "Shared/Core/Utils/Compression.h"
+#include "Shared/Core/Utils/File.h"
+
+#include "zlib.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <string>
+#include <functional>
+
+namespace
+{
+    struct Payload
+    {
+        std::string Name;
+        std::vector<uint8_t> Data;
+    };
+
+    // Compression as it was before the contexts were reused, kept here as the baseline.
+    bool LegacyCompress(const std::vector<uint8_t>& Input, std::vector<uint8_t>& Output)
+    {
+        Output.resize(compressBound((uLong)Input.size()));
+
+        z_stream defstream;
+        defstream.zalloc = Z_NULL;
+        defstream.zfree = Z_NULL;
+        defstream.opaque = Z_NULL;
+        defstream.avail_in = (uInt)Input.size();
+        defstream.next_in = (Bytef*)Input.data();
+        defstream.avail_out = (uInt)Output.size();
+        defstream.next_out = (Bytef*)Output.data();
+
+        if (deflateInit2(&defstream, 7, Z_DEFLATED, 13, 9, Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+            return false;
+        }
+        if (deflate(&defstream, Z_FINISH) != Z_STREAM_END)
+        {
+            return false;
+        }
+        if (deflateEnd(&defstream) != Z_OK)
+        {
+            return false;
+        }
+
+        Output.resize(defstream.total_out);
+
+        return true;
+    }
+
+    bool LegacyDecompress(const std::vector<uint8_t>& Input, std::vector<uint8_t>& Output, uint32_t DecompressedSize)
+    {
+        Output.resize(DecompressedSize);
+
+        uLongf DestinationLength = (uLongf)Output.size();
+        uLongf SourceLength = (uLongf)Input.size();
+
+        if (uncompress2(Output.data(), &DestinationLength, Input.data(), &SourceLength) != Z_OK)
+        {
+            return false;
+        }
+
+        Output.resize(DestinationLength);
+
+        return true;
+    }
+
+    // Ghost replay data is mostly a stream of frames with slowly changing positions and
+    // rotations plus the odd animation id, so generate something along those lines.
+    std::vector<uint8_t> MakeSyntheticReplay(size_t Size, uint32_t Seed)
+    {
+        std::mt19937 Random(Seed);
+        std::uniform_real_distribution<float> Jitter(-0.05f, 0.05f);
+
+        std::vector<uint8_t> Result;
+        Result.reserve(Size);
+
+        float Position[3] = { 100.0f, 20.0f, -340.0f };
+        float Heading = 0.0f;
+        uint16_t Animation = 1000;
+
+        while (Result.size() < Size)
+        {
+            Position[0] += std::cos(Heading) * 0.3f + Jitter(Random);
+            Position[2] += std::sin(Heading) * 0.3f + Jitter(Random);
+            Heading += Jitter(Random);
+
+            if ((Random() % 16) == 0)
+            {
+                Animation = (uint16_t)(1000 + (Random() % 64));
+            }
+
+            uint8_t Frame[20];
+            memcpy(Frame + 0, &Position[0], 4);
+            memcpy(Frame + 4, &Position[1], 4);
+            memcpy(Frame + 8, &Position[2], 4);
+            memcpy(Frame + 12, &Heading, 4);
+            memcpy(Frame + 16, &Animation, 2);
+            Frame[18] = 0;
+            Frame[19] = 0;
+
+            Result.insert(Result.end(), Frame, Frame + std::min(sizeof(Frame), Size - Result.size()));
+        }
+
+        return Result;
+    }
+
+    bool Run(const char* Name, const Payload& Input, int Iterations, const std::function<bool()>& Body)
+    {
+        // Warm up caches and the per-thread contexts.
+        for (int i = 0; i < Iterations / 10; i++)
+        {
+            if (!Body())
+            {
+                printf("%-24s %-24s FAILED\n", Name, Input.Name.c_str());
+                return false;
+            }
+        }
+
+        auto Start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < Iterations; i++)
+        {
+            if (!Body())
+            {
+                printf("%-24s %-24s FAILED\n", Name, Input.Name.c_str());
+                return false;
+            }
+        }
+        auto End = std::chrono::high_resolution_clock::now();
+
+        double Seconds = std::chrono::duration<double>(End - Start).count();
+        double UsPerMessage = (Seconds * 1e6) / Iterations;
+        double MegabytesPerSecond = ((double)Input.Data.size() * Iterations) / (1024.0 * 1024.0) / Seconds;
+
+        printf("%-24s %-24s %8zu B  %10.2f us/message  %10.1f MB/s\n", Name, Input.Name.c_str(), Input.Data.size(), UsPerMessage, MegabytesPerSecond);
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int Iterations = (argc > 1) ? atoi(argv[1]) : 20000;
+    if (Iterations <= 0)
+    {
+        printf("Invalid iteration count.\n");
+        return 1;
+    }
+
+    std::vector<Payload> Payloads;
+    for (int i = 2; i < argc; i++)
+    {
+        Payload& Entry = Payloads.emplace_back();
+        Entry.Name = std::filesystem::path(argv[i]).filename().string();
+        if (!ReadBytesFromFile(argv[i], Entry.Data))
+        {
+            printf("Failed to read payload from: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (Payloads.empty())
+    {
+        printf("No payloads given, using synthetic replay data.\n\n");
+
+        // Smallest message that gets compressed, a typical bloodstain, and a large ghost list.
+        for (size_t Size : { 512, 2 * 1024, 16 * 1024 })
+        {
+            Payloads.push_back({ "synthetic-" + std::to_string(Size), MakeSyntheticReplay(Size, (uint32_t)Size) });
+        }
+    }
+
+    bool Success = true;
+
+    for (const Payload& Input : Payloads)
+    {
+        // The game checks the stream header, so the output has to be identical to what we produced before.
+        std::vector<uint8_t> Expected;
+        std::vector<uint8_t> Compressed;
+        if (!LegacyCompress(Input.Data, Expected) || !Compress(Input.Data, Compressed) || Compressed != Expected)
+        {
+            printf("%s: compressed output differs from the legacy implementation.\n", Input.Name.c_str());
+            return 1;
+        }
+
+        std::vector<uint8_t> Decompressed;
+        if (!Decompress(Compressed, Decompressed, (uint32_t)Input.Data.size()) || Decompressed != Input.Data)
+        {
+            printf("%s: decompressed output does not match the original payload.\n", Input.Name.c_str());
+            return 1;
+        }
+
+        printf("%s: %zu -> %zu bytes (%.1f%%)\n", Input.Name.c_str(), Input.Data.size(), Compressed.size(), 100.0 * Compressed.size() / Input.Data.size());
+
+        // Cached list responses only compress the message header per-client and splice in the rest.
+        uint8_t MessageHeader[28] = {};
+        CompressedChunk Chunk;
+        std::vector<uint8_t> Spliced;
+        if (!CompressChunk(Input.Data.data(), Input.Data.size(), Chunk) ||
+            !CompressSpliced(MessageHeader, sizeof(MessageHeader), { &Chunk }, Spliced) ||
+            !Decompress(Spliced, Decompressed, (uint32_t)(sizeof(MessageHeader) + Input.Data.size())) ||
+            memcmp(Decompressed.data() + sizeof(MessageHeader), Input.Data.data(), Input.Data.size()) != 0)
+        {
+            printf("%s: spliced output does not match the original payload.\n", Input.Name.c_str());
+            return 1;
+        }
+
+        std::vector<uint8_t> Output;
+        Success &= Run("Compress (legacy)", Input, Iterations, [&]() {
+            return LegacyCompress(Input.Data, Output);
+        });
+        Success &= Run("Compress", Input, Iterations, [&]() {
+            return Compress(Input.Data, Output);
+        });
+        Success &= Run("Compress (spliced)", Input, Iterations, [&]() {
+            return CompressSpliced(MessageHeader, sizeof(MessageHeader), { &Chunk }, Output);
+        });
+        Success &= Run("Decompress (legacy)", Input, Iterations, [&]() {
+            return LegacyDecompress(Compressed, Output, (uint32_t)Input.Data.size());
+        });
+        Success &= Run("Decompress", Input, Iterations, [&]() {
+            return Decompress(Compressed, Output, (uint32_t)Input.Data.size());
+        });
+
+        printf("\n");
+    }
+
+    return Success ? 0 : 1;
+}
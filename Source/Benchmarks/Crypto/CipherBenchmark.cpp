@@ -0,0 +1,321 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+// Measures throughput of the udp ciphers for typical packet sizes, comparing the
+// vector based api against the in-place one used by the packet streams.
+//
+// Before timing anything the accelerated cwc backend (cwc_ni) is checked bit-for-bit against 
+// the portable cwc code, using the published test vectors and a spread of random messages.
+//
+// Usage: CipherBenchmark [iterations] [path to aes_modes/testvals/cwc.1]
+
+#include "Shared/Core/Crypto/CWCServerUDPCipher.h"
+#include "Shared/Core/Crypto/CWCClientUDPCipher.h"
+#include "Shared/Core/Utils/Random.h"
+
+#include "cwc.h"
+#include "cwc_ni.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    const size_t k_payload_sizes[] = { 64, 512, 1400 };
+    const uint64_t k_auth_token = 0x0123456789ABCDEF;
+
+    const size_t k_cwc_iv_size = 11;
+    const size_t k_cwc_tag_size = 16;
+    const int k_cwc_random_checks = 2000;
+
+    struct CwcTestVector
+    {
+        int Index = 0;
+        std::vector<uint8_t> Key;
+        std::vector<uint8_t> Iv;
+        std::vector<uint8_t> Header;
+        std::vector<uint8_t> Plaintext;
+        std::vector<uint8_t> Ciphertext;
+    };
+
+    std::vector<uint8_t> ParseHex(const std::string& Text)
+    {
+        std::vector<uint8_t> Result;
+        for (size_t i = 0; i + 1 < Text.size(); i += 2)
+        {
+            Result.push_back((uint8_t)strtoul(Text.substr(i, 2).c_str(), nullptr, 16));
+        }
+        return Result;
+    }
+
+    // Parses the MODETEST format the aes_modes test vectors are distributed in.
+    bool LoadCwcTestVectors(const char* Path, std::vector<CwcTestVector>& Vectors)
+    {
+        std::ifstream File(Path);
+        if (!File.is_open())
+        {
+            return false;
+        }
+
+        std::string Line;
+        while (std::getline(File, Line))
+        {
+            std::istringstream Stream(Line);
+            std::string Field, Value;
+            Stream >> Field >> Value;
+
+            if (Field == "VEC")
+            {
+                Vectors.emplace_back().Index = atoi(Value.c_str());
+            }
+            else if (Vectors.empty())
+            {
+                continue;
+            }
+            else if (Field == "KEY") Vectors.back().Key = ParseHex(Value);
+            else if (Field == "IV")  Vectors.back().Iv = ParseHex(Value);
+            else if (Field == "HDR") Vectors.back().Header = ParseHex(Value);
+            else if (Field == "PTX") Vectors.back().Plaintext = ParseHex(Value);
+            else if (Field == "CTX") Vectors.back().Ciphertext = ParseHex(Value);
+        }
+
+        return !Vectors.empty();
+    }
+
+    // Encrypts with the step by step calls, which always use the portable code.
+    void CwcEncryptPortable(const std::vector<uint8_t>& Key, const std::vector<uint8_t>& Iv, const std::vector<uint8_t>& Header, 
+                            std::vector<uint8_t>& Message, std::vector<uint8_t>& Tag)
+    {
+        cwc_ctx Context;
+        cwc_init_and_key(Key.data(), (unsigned long)Key.size(), &Context);
+        cwc_init_message(Iv.data(), (unsigned long)Iv.size(), &Context);
+        cwc_auth_header(Header.data(), (unsigned long)Header.size(), &Context);
+        cwc_encrypt(Message.data(), (unsigned long)Message.size(), &Context);
+        Tag.resize(k_cwc_tag_size);
+        cwc_compute_tag(Tag.data(), (unsigned long)Tag.size(), &Context);
+        cwc_end(&Context);
+    }
+
+    // Compares the output of each backend for a single message, and with the expected ciphertext if given. 
+    // Only ciphertext is compared against the test vectors, the hash in our cwc.c differs from upstream so its
+    // tags don't match the published ones. What the game expects is whatever the portable code produces.
+    bool CheckCwcMessage(const char* Name, const std::vector<uint8_t>& Key, const std::vector<uint8_t>& Iv, const std::vector<uint8_t>& Header, 
+                         const std::vector<uint8_t>& Plaintext, const std::vector<uint8_t>* ExpectedCiphertext)
+    {
+        std::vector<uint8_t> PortableMessage = Plaintext;
+        std::vector<uint8_t> PortableTag;
+        CwcEncryptPortable(Key, Iv, Header, PortableMessage, PortableTag);
+
+        if (ExpectedCiphertext && PortableMessage != *ExpectedCiphertext)
+        {
+            printf("%s: portable cwc does not match the expected output.\n", Name);
+            return false;
+        }
+
+#if defined( CWC_NI_POSSIBLE )
+        if (cwc_ni_available())
+        {
+            cwc_ctx Context;
+            cwc_init_and_key(Key.data(), (unsigned long)Key.size(), &Context);
+
+            std::vector<uint8_t> Message = Plaintext;
+            std::vector<uint8_t> Tag(k_cwc_tag_size);
+            if (cwc_ni_encrypt_message(Iv.data(), (unsigned long)Iv.size(), Header.data(), (unsigned long)Header.size(), Message.data(), (unsigned long)Message.size(), Tag.data(), (unsigned long)Tag.size(), &Context) != RETURN_GOOD ||
+                Message != PortableMessage || 
+                Tag != PortableTag)
+            {
+                printf("%s: cwc_ni_encrypt_message does not match portable cwc.\n", Name);
+                return false;
+            }
+
+            if (cwc_ni_decrypt_message(Iv.data(), (unsigned long)Iv.size(), Header.data(), (unsigned long)Header.size(), Message.data(), (unsigned long)Message.size(), Tag.data(), (unsigned long)Tag.size(), &Context) != RETURN_GOOD ||
+                Message != Plaintext)
+            {
+                printf("%s: cwc_ni_decrypt_message did not round trip.\n", Name);
+                return false;
+            }
+
+            // A corrupted tag has to be rejected.
+            Tag[0] ^= 1;
+            if (cwc_ni_decrypt_message(Iv.data(), (unsigned long)Iv.size(), Header.data(), (unsigned long)Header.size(), PortableMessage.data(), (unsigned long)PortableMessage.size(), Tag.data(), (unsigned long)Tag.size(), &Context) != RETURN_ERROR)
+            {
+                printf("%s: cwc_ni_decrypt_message accepted a corrupted tag.\n", Name);
+                return false;
+            }
+
+            cwc_end(&Context);
+        }
+#endif
+
+        return true;
+    }
+
+    bool CheckCwcBackends(const char* TestVectorPath)
+    {
+        std::vector<CwcTestVector> Vectors;
+        if (!LoadCwcTestVectors(TestVectorPath, Vectors))
+        {
+            printf("Failed to load cwc test vectors from: %s\n", TestVectorPath);
+            return false;
+        }
+
+        for (CwcTestVector& Vector : Vectors)
+        {
+            std::string Name = "Test vector " + std::to_string(Vector.Index);
+            if (!CheckCwcMessage(Name.c_str(), Vector.Key, Vector.Iv, Vector.Header, Vector.Plaintext, &Vector.Ciphertext))
+            {
+                return false;
+            }
+        }
+
+        // The test vectors are all short, so also cover the multi-block paths and odd lengths.
+        for (int i = 0; i < k_cwc_random_checks; i++)
+        {
+            std::vector<uint8_t> Key(16);
+            std::vector<uint8_t> Iv(k_cwc_iv_size);
+            std::vector<uint8_t> Header(i % 41);
+            std::vector<uint8_t> Plaintext((i * 7) % 1500);
+            FillRandomBytes(Key);
+            FillRandomBytes(Iv);
+            FillRandomBytes(Header);
+            FillRandomBytes(Plaintext);
+
+            std::string Name = "Random message " + std::to_string(i);
+            if (!CheckCwcMessage(Name.c_str(), Key, Iv, Header, Plaintext, nullptr))
+            {
+                return false;
+            }
+        }
+
+#if defined( CWC_NI_POSSIBLE )
+        printf("cwc_ni %s, checked %zu test vectors and %i random messages.\n\n", cwc_ni_available() ? "matches portable cwc" : "unavailable on this cpu", Vectors.size(), k_cwc_random_checks);
+#else
+        printf("cwc_ni not built for this platform, checked %zu test vectors and %i random messages.\n\n", Vectors.size(), k_cwc_random_checks);
+#endif
+        return true;
+    }
+
+    bool Run(const char* Name, size_t PayloadSize, int Iterations, const std::function<bool()>& Body)
+    {
+        // Warm up caches and the cipher contexts.
+        for (int i = 0; i < Iterations / 10; i++)
+        {
+            if (!Body())
+            {
+                printf("%-32s %6zu B  FAILED\n", Name, PayloadSize);
+                return false;
+            }
+        }
+
+        auto Start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < Iterations; i++)
+        {
+            if (!Body())
+            {
+                printf("%-32s %6zu B  FAILED\n", Name, PayloadSize);
+                return false;
+            }
+        }
+        auto End = std::chrono::high_resolution_clock::now();
+
+        double Seconds = std::chrono::duration<double>(End - Start).count();
+        double NsPerPacket = (Seconds * 1e9) / Iterations;
+        double MegabytesPerSecond = ((double)PayloadSize * Iterations) / (1024.0 * 1024.0) / Seconds;
+
+        printf("%-32s %6zu B  %10.1f ns/packet  %10.1f MB/s\n", Name, PayloadSize, NsPerPacket, MegabytesPerSecond);
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int Iterations = (argc > 1) ? atoi(argv[1]) : 200000;
+    if (Iterations <= 0)
+    {
+        printf("Invalid iteration count.\n");
+        return 1;
+    }
+
+    const char* TestVectorPath = (argc > 2) ? argv[2] : CWC_TEST_VECTOR_PATH;
+    if (!CheckCwcBackends(TestVectorPath))
+    {
+        return 1;
+    }
+
+    std::vector<uint8_t> Key(16);
+    FillRandomBytes(Key);
+
+    // Server encrypts with the server cipher, and decrypts what clients send with the client cipher.
+    CWCServerUDPCipher ServerCipher(Key, k_auth_token);
+    CWCClientUDPCipher ClientCipher(Key, k_auth_token);
+
+    bool Success = true;
+
+    for (size_t PayloadSize : k_payload_sizes)
+    {
+        std::vector<uint8_t> Payload(PayloadSize);
+        FillRandomBytes(Payload);
+
+        // Encryption
+        std::vector<uint8_t> Output;
+        Success &= Run("Encrypt (vector)", PayloadSize, Iterations, [&]() {
+            return ServerCipher.Encrypt(Payload, Output);
+        });
+
+        std::vector<uint8_t> Buffer(ServerCipher.GetHeaderSize() + PayloadSize);
+        Success &= Run("EncryptInPlace", PayloadSize, Iterations, [&]() {
+            // Copy in the payload each time, the same as the packet stream does.
+            memcpy(Buffer.data() + ServerCipher.GetHeaderSize(), Payload.data(), PayloadSize);
+            return ServerCipher.EncryptInPlace(Buffer.data(), PayloadSize);
+        });
+
+        // Decryption
+        std::vector<uint8_t> Encrypted;
+        if (!ClientCipher.Encrypt(Payload, Encrypted))
+        {
+            printf("Failed to encrypt payload for decryption benchmark.\n");
+            return 1;
+        }
+
+        std::vector<uint8_t> Decrypted;
+        Success &= Run("Decrypt (vector)", PayloadSize, Iterations, [&]() {
+            return ClientCipher.Decrypt(Encrypted.data(), Encrypted.size(), Decrypted);
+        });
+
+        // Make sure the in-place path actually round trips before timing it.
+        std::vector<uint8_t> Datagram = Encrypted;
+        size_t PayloadOffset = 0, PayloadLength = 0;
+        if (!ClientCipher.DecryptInPlace(Datagram.data(), Datagram.size(), PayloadOffset, PayloadLength) ||
+            PayloadLength != PayloadSize ||
+            memcmp(Datagram.data() + PayloadOffset, Payload.data(), PayloadSize) != 0)
+        {
+            printf("In-place decryption did not produce the original payload.\n");
+            return 1;
+        }
+
+        Success &= Run("DecryptInPlace", PayloadSize, Iterations, [&]() {
+            // Decrypting in place destroys the ciphertext, so restore it each time. This
+            // stands in for the datagram being recieved into the buffer.
+            memcpy(Datagram.data(), Encrypted.data(), Encrypted.size());
+
+            return ClientCipher.DecryptInPlace(Datagram.data(), Datagram.size(), PayloadOffset, PayloadLength);
+        });
+
+        printf("\n");
+    }
+
+    return Success ? 0 : 1;
+}
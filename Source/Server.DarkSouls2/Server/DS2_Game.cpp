@@ -10,6 +10,7 @@
 #include "Server/DS2_Game.h"
 #include "Protobuf/DS2_Protobufs.h"
 #include "Server/Streams/DS2_Frpg2ReliableUdpMessage.h"
+#include "Server/Streams/Frpg2ReliableUdpMessageTypeTable.h"
 #include "Server/GameService/DS2_PlayerState.h"
 
 #include "Server/GameService/GameManagers/Boot/DS2_BootManager.h"
@@ -26,95 +27,40 @@
 #include "Server/GameService/GameManagers/MirrorKnight/DS2_MirrorKnightManager.h"
 #include "Server/GameService/GameManagers/QuickMatch/DS2_QuickMatchManager.h"
 
-bool DS2_Game::Protobuf_To_ReliableUdpMessageType(google::protobuf::MessageLite* Message, Frpg2ReliableUdpMessageType& Output)
+namespace
 {
-#define DEFINE_REQUEST_RESPONSE(OpCode, Type, ProtobufClass, ResponseProtobufClass) \
-    if (dynamic_cast<DS2_Frpg2RequestMessage::ProtobufClass*>(Message) != nullptr)  \
-    {                                                                               \
-        Output = (Frpg2ReliableUdpMessageType)(int)DS2_Frpg2ReliableUdpMessageType::Type; \
-        return true;                                                                \
-    }                                                                               
-#define DEFINE_MESSAGE(OpCode, Type, ProtobufClass)                                 \
-    if (dynamic_cast<DS2_Frpg2RequestMessage::ProtobufClass*>(Message) != nullptr)  \
-    {                                                                               \
-        Output = (Frpg2ReliableUdpMessageType)(int)DS2_Frpg2ReliableUdpMessageType::Type; \
-        return true;                                                                \
-    }                                                                               
-#define DEFINE_PUSH_MESSAGE(OpCode, Type, ProtobufClass)                            \
-    if (dynamic_cast<DS2_Frpg2RequestMessage::ProtobufClass*>(Message) != nullptr)  \
-    {                                                                               \
-        Output = Frpg2ReliableUdpMessageType::Push; /* Not using push */            \
-        return true;                                                                \
-    }    
+    // Built from the message type list the first time its needed.
+    const Frpg2ReliableUdpMessageTypeTable& GetMessageTypeTable()
+    {
+        static const Frpg2ReliableUdpMessageTypeTable Table = []() {
+            Frpg2ReliableUdpMessageTypeTable Result;
+#define DEFINE_REQUEST_RESPONSE(OpCode, Type, ProtobufClass, ResponseProtobufClass)         Result.AddRequestResponse<DS2_Frpg2RequestMessage::ProtobufClass, DS2_Frpg2RequestMessage::ResponseProtobufClass>((Frpg2ReliableUdpMessageType)(int)DS2_Frpg2ReliableUdpMessageType::Type);
+#define DEFINE_MESSAGE(OpCode, Type, ProtobufClass)                                         Result.AddMessage<DS2_Frpg2RequestMessage::ProtobufClass>((Frpg2ReliableUdpMessageType)(int)DS2_Frpg2ReliableUdpMessageType::Type);
+#define DEFINE_PUSH_MESSAGE(OpCode, Type, ProtobufClass)                                    Result.AddPushMessage<DS2_Frpg2RequestMessage::ProtobufClass>();
 #include "Server.DarkSouls2/Server/Streams/DS2_Frpg2ReliableUdpMessageTypes.inc"
 #undef DEFINE_PUSH_MESSAGE
 #undef DEFINE_MESSAGE
 #undef DEFINE_REQUEST_RESPONSE
+            return Result;
+        }();
 
-    return false;
+        return Table;
+    }
 }
 
-bool DS2_Game::ReliableUdpMessageType_To_Protobuf(Frpg2ReliableUdpMessageType InType, bool IsResponse, std::shared_ptr<google::protobuf::MessageLite>& Output)
+bool DS2_Game::Protobuf_To_ReliableUdpMessageType(google::protobuf::MessageLite* Message, Frpg2ReliableUdpMessageType& Output)
 {
-#define DEFINE_REQUEST_RESPONSE(OpCode, Type, ProtobufClass, ResponseProtobufClass)                     \
-    if ((int)InType == (int)DS2_Frpg2ReliableUdpMessageType::Type)                                                      \
-    {                                                                                                   \
-        if (IsResponse)                                                                                 \
-        {                                                                                               \
-            Output = std::make_shared<DS2_Frpg2RequestMessage::ResponseProtobufClass>();                    \
-        }                                                                                               \
-        else                                                                                            \
-        {                                                                                               \
-            Output = std::make_shared<DS2_Frpg2RequestMessage::ProtobufClass>();                            \
-        }                                                                                               \
-        return true;                                                                                    \
-    }
-#define DEFINE_MESSAGE(OpCode, Type, ProtobufClass)                                                     \
-    if ((int)InType == (int)DS2_Frpg2ReliableUdpMessageType::Type)                                                      \
-    {                                                                                                   \
-        if (IsResponse)                                                                                 \
-        {                                                                                               \
-            return false;                                                                               \
-        }                                                                                               \
-        else                                                                                            \
-        {                                                                                               \
-            Output = std::make_shared<DS2_Frpg2RequestMessage::ProtobufClass>();                            \
-            return true;                                                                                \
-        }                                                                                               \
-    }
-#define DEFINE_PUSH_MESSAGE(OpCode, Type, ProtobufClass)                                                /* Not supported on server, server only sends these */
-#include "Server.DarkSouls2/Server/Streams/DS2_Frpg2ReliableUdpMessageTypes.inc"
-#undef DEFINE_PUSH_MESSAGE
-#undef DEFINE_MESSAGE
-#undef DEFINE_REQUEST_RESPONSE
+    return GetMessageTypeTable().GetMessageType(*Message, Output);
+}
 
-    return false;
+bool DS2_Game::ReliableUdpMessageType_To_Protobuf(Frpg2ReliableUdpMessageType InType, bool IsResponse, std::shared_ptr<google::protobuf::MessageLite>& Output)
+{
+    return GetMessageTypeTable().CreateProtobuf(InType, IsResponse, Output);
 }
 
 bool DS2_Game::ReliableUdpMessageType_Expects_Response(Frpg2ReliableUdpMessageType InType)
 {
-    if ((int)InType == (int)DS2_Frpg2ReliableUdpMessageType::Push)
-    {                                                                                       
-        return false;                                                                       
-    }
-
-#define DEFINE_REQUEST_RESPONSE(OpCode, Type, ProtobufClass, ResponseProtobufClass)         \
-    if ((int)InType == (int)DS2_Frpg2ReliableUdpMessageType::Type)                                        \
-    {                                                                                       \
-        return true;                                                                        \
-    }
-#define DEFINE_MESSAGE(OpCode, Type, ProtobufClass)                                         \
-    if ((int)InType == (int)DS2_Frpg2ReliableUdpMessageType::Type)                                        \
-    {                                                                                       \
-        return false;                                                                       \
-    }
-#define DEFINE_PUSH_MESSAGE(OpCode, Type, ProtobufClass)                                    /* Not required, gets caught by Push test above */
-#include "Server.DarkSouls2/Server/Streams/DS2_Frpg2ReliableUdpMessageTypes.inc"
-#undef DEFINE_PUSH_MESSAGE
-#undef DEFINE_MESSAGE
-#undef DEFINE_REQUEST_RESPONSE
-
-    return false;
+    return GetMessageTypeTable().ExpectsResponse(InType);
 }
 
 std::string DS2_Game::GetBossDiscordThumbnailUrl(uint32_t BossId)
@@ -169,7 +115,7 @@ void DS2_Game::GetStatistics(GameService& Service, std::unordered_map<std::strin
     Stats["Live Ghosts"] = std::to_string(Ghosts->GetLiveCount());
 }
 
-void DS2_Game::SendManagementMessage(Frpg2ReliableUdpMessageStream& stream, const std::string& TextMessage) 
+void DS2_Game::SendManagementMessage(GameService& Service, const std::vector<std::shared_ptr<GameClient>>& Clients, const std::string& TextMessage)
 {
     DS2_Frpg2RequestMessage::ManagementTextMessage Message;
     Message.set_push_message_id(DS2_Frpg2RequestMessage::PushID_ManagementTextMessage);
@@ -187,5 +133,5 @@ void DS2_Game::SendManagementMessage(Frpg2ReliableUdpMessageStream& stream, cons
     DateTime->set_seconds(0);
     DateTime->set_tzdiff(0);
 
-    stream.Send(&Message);
+    Service.SendToClients(Clients, &Message);
 }
\ No newline at end of file
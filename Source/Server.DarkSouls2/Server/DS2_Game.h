@@ -28,6 +28,6 @@ public:
 
     virtual void GetStatistics(GameService& Service, std::unordered_map<std::string, std::string>& Stats) override;
 
-    virtual void SendManagementMessage(Frpg2ReliableUdpMessageStream& stream, const std::string& TextMessage) override;
+    virtual void SendManagementMessage(GameService& Service, const std::vector<std::shared_ptr<GameClient>>& Clients, const std::string& TextMessage) override;
 
 };
\ No newline at end of file
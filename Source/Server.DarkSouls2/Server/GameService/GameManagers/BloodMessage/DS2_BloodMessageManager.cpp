@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/BloodMessage/DS2_BloodMessageManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/GameService/GameService.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
@@ -29,8 +30,28 @@
 DS2_BloodMessageManager::DS2_BloodMessageManager(Server* InServerInstance, GameService* InGameServiceInstance)
     : ServerInstance(InServerInstance)
     , GameServiceInstance(InGameServiceInstance)
+    , ListCache(SerializeListEntry)
 {
     LiveCache.SetMaxEntriesPerArea(InServerInstance->GetConfig().BloodMessageMaxLivePoolEntriesPerArea);
+    ListCache.SetTimeout(InServerInstance->GetConfig().ListResponseCacheTime);
+}
+
+bool DS2_BloodMessageManager::SerializeListEntry(const BloodMessage& Value, std::vector<uint8_t>& Output)
+{
+    // online_area_id is sent as a seperate part, so this is serialized partially.
+    DS2_Frpg2RequestMessage::RequestGetBloodMessageListResponse Response;
+
+    DS2_Frpg2RequestMessage::BloodMessageData& Data = *Response.mutable_messages()->Add();
+    Data.set_player_id(Value.PlayerId);
+    Data.set_character_id(Value.CharacterId); 
+    Data.set_message_id(Value.MessageId);
+    Data.set_good(Value.RatingGood);
+    Data.set_message_data(Value.Data.data(), Value.Data.size());
+    Data.set_player_steam_id(Value.PlayerSteamId);
+    Data.set_cell_id(Value.CellId);
+
+    Output.resize(Response.ByteSize());
+    return Response.SerializePartialToArray(Output.data(), (int)Output.size());
 }
 
 bool DS2_BloodMessageManager::Init()
@@ -63,6 +84,7 @@ bool DS2_BloodMessageManager::Init()
 
 void DS2_BloodMessageManager::Poll()
 {
+    ListCache.Poll();
 }
 
 void DS2_BloodMessageManager::TrimDatabase()
@@ -74,38 +96,15 @@ void DS2_BloodMessageManager::TrimDatabase()
     Database.TrimBloodMessages(MaxEntries);
 }
 
-MessageHandleResult DS2_BloodMessageManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS2_BloodMessageManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestReentryBloodMessage))
-    {
-        return Handle_RequestReentryBloodMessage(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetBloodMessageEvaluation))
-    {
-        return Handle_RequestGetBloodMessageEvaluation(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestCreateBloodMessage))
-    {
-        return Handle_RequestCreateBloodMessage(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestRemoveBloodMessage))
-    {
-        return Handle_RequestRemoveBloodMessage(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetBloodMessageList))
-    {
-        return Handle_RequestGetBloodMessageList(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetAreaBloodMessageList))
-    {
-        return Handle_RequestGetAreaBloodMessageList(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestEvaluateBloodMessage))
-    {
-        return Handle_RequestEvaluateBloodMessage(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestReentryBloodMessage, this, &DS2_BloodMessageManager::Handle_RequestReentryBloodMessage);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetBloodMessageEvaluation, this, &DS2_BloodMessageManager::Handle_RequestGetBloodMessageEvaluation);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestCreateBloodMessage, this, &DS2_BloodMessageManager::Handle_RequestCreateBloodMessage);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestRemoveBloodMessage, this, &DS2_BloodMessageManager::Handle_RequestRemoveBloodMessage);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetBloodMessageList, this, &DS2_BloodMessageManager::Handle_RequestGetBloodMessageList);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetAreaBloodMessageList, this, &DS2_BloodMessageManager::Handle_RequestGetAreaBloodMessageList);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestEvaluateBloodMessage, this, &DS2_BloodMessageManager::Handle_RequestEvaluateBloodMessage);
 }
 
 MessageHandleResult DS2_BloodMessageManager::Handle_RequestReentryBloodMessage(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
@@ -240,14 +239,22 @@ MessageHandleResult DS2_BloodMessageManager::Handle_RequestRemoveBloodMessage(Ga
 
     LogS(Client->GetName().c_str(), "Removing blood message %i.", Request->message_id());
 
-    if (Database.RemoveOwnBloodMessage(Player.GetPlayerId(), Request->message_id()))
-    {
-        LiveCache.Remove({ (uint64_t)Request->cell_id(), (DS2_OnlineAreaId)Request->online_area_id() }, Request->message_id());
-    }
-    else
-    {
-        WarningS(Client->GetName().c_str(), "Failed to remove blood message.");
-    }
+    // With write-behind the result may not be known until a later poll, so don't capture the client.
+    DS2_CellAndAreaId AreaId = { (uint64_t)Request->cell_id(), (DS2_OnlineAreaId)Request->online_area_id() };
+    uint32_t MessageId = Request->message_id();
+    std::string ClientName = Client->GetName();
+    Database.RemoveOwnBloodMessage(Player.GetPlayerId(), MessageId, [this, AreaId, MessageId, ClientName](bool Removed) {
+        if (Removed)
+        {
+            LiveCache.Remove(AreaId, MessageId);
+            ListCache.InvalidateArea(DS2_CellAndAreaId::AnyArea(AreaId.CellId));
+            ListCache.InvalidateArea(DS2_CellAndAreaId::AnyCell(AreaId.AreaId));
+        }
+        else
+        {
+            WarningS(ClientName.c_str(), "Failed to remove blood message.");
+        }
+    });
 
     // Empty response, not sure what purpose this serves really other than saying message-recieved. Client
     // doesn't work without it though.
@@ -268,9 +275,20 @@ MessageHandleResult DS2_BloodMessageManager::Handle_RequestGetBloodMessageList(G
     PlayerState& Player = Client->GetPlayerState();
 
     DS2_Frpg2RequestMessage::RequestGetBloodMessageList* Request = (DS2_Frpg2RequestMessage::RequestGetBloodMessageList*)Message.Protobuf.get();
-    DS2_Frpg2RequestMessage::RequestGetBloodMessageListResponse Response;
-    Response.set_online_area_id(Request->online_area_id());
-    Response.mutable_messages();
+
+    // The response (RequestGetBloodMessageListResponse) is built out of the online_area_id followed by the 
+    // already serialized and compressed selections for each cell, see ListResponseCache. Selections cover
+    // every area the cell is in, so are cached under DS2_CellAndAreaId::AnyArea.
+    DS2_Frpg2RequestMessage::RequestGetBloodMessageListResponse Header;
+    Header.set_online_area_id(Request->online_area_id());
+
+    Frpg2PreparedPayloadList Response;
+    Response.push_back(Frpg2ReliableUdpMessageStream::PrepareProtobuf(&Header));
+    if (!Response.back())
+    {
+        WarningS(Client->GetName().c_str(), "Disconnecting client as failed to prepare RequestGetBloodMessageListResponse response.");
+        return MessageHandleResult::Error;
+    }
 
     int RemainingMessageCount = (int)Request->max_messages();
 
@@ -285,26 +303,22 @@ MessageHandleResult DS2_BloodMessageManager::Handle_RequestGetBloodMessageList(G
             uint32_t MaxForCell = Area.max_type_1() + Area.max_type_2(); // TODO: we need to figure out the difference between these two types.
             int GatherCount = std::min((int)MaxForCell, (int)RemainingMessageCount);
 
-            std::vector<std::shared_ptr<BloodMessage>> AreaMessages = LiveCache.GetRandomSet(GatherCount, [CellId](DS2_CellAndAreaId Id) {
+            int EntryCount = 0;
+            std::shared_ptr<const Frpg2PreparedPayload> CellMessages = ListCache.GetRandomSet(LiveCache, DS2_CellAndAreaId::AnyArea(CellId), GatherCount, [CellId](DS2_CellAndAreaId Id) {
                 return Id.CellId == CellId;
-            });
-            for (std::shared_ptr<BloodMessage>& AreaMsg : AreaMessages)
+            }, EntryCount);
+            if (!CellMessages)
             {
-                DS2_Frpg2RequestMessage::BloodMessageData& Data = *Response.mutable_messages()->Add();
-                Data.set_player_id(AreaMsg->PlayerId);
-                Data.set_character_id(AreaMsg->CharacterId); 
-                Data.set_message_id(AreaMsg->MessageId);
-                Data.set_good(AreaMsg->RatingGood);
-                Data.set_message_data(AreaMsg->Data.data(), AreaMsg->Data.size());
-                Data.set_player_steam_id(AreaMsg->PlayerSteamId);
-                Data.set_cell_id(AreaMsg->CellId);
-
-                RemainingMessageCount--;
+                WarningS(Client->GetName().c_str(), "Failed to build blood message list for cell %llu.", (unsigned long long)CellId);
+                continue;
             }
+
+            Response.push_back(CellMessages);
+            RemainingMessageCount -= EntryCount;
         }
     }
 
-    if (!Client->MessageStream->Send(&Response, &Message))
+    if (!Client->MessageStream->SendPrepared(Response, &Message))
     {
         WarningS(Client->GetName().c_str(), "Disconnecting client as failed to send RequestGetBloodMessageListResponse response.");
         return MessageHandleResult::Error;
@@ -320,33 +334,39 @@ MessageHandleResult DS2_BloodMessageManager::Handle_RequestGetAreaBloodMessageLi
     PlayerState& Player = Client->GetPlayerState();
 
     DS2_Frpg2RequestMessage::RequestGetAreaBloodMessageList* Request = (DS2_Frpg2RequestMessage::RequestGetAreaBloodMessageList*)Message.Protobuf.get();
-    DS2_Frpg2RequestMessage::RequestGetBloodMessageListResponse Response;
-    Response.set_online_area_id(Request->online_area_id());
-    Response.mutable_messages();
+
+    // Built the same way as the response to RequestGetBloodMessageList.
+    DS2_Frpg2RequestMessage::RequestGetBloodMessageListResponse Header;
+    Header.set_online_area_id(Request->online_area_id());
+
+    Frpg2PreparedPayloadList Response;
+    Response.push_back(Frpg2ReliableUdpMessageStream::PrepareProtobuf(&Header));
+    if (!Response.back())
+    {
+        WarningS(Client->GetName().c_str(), "Disconnecting client as failed to prepare RequestGetBloodMessageListResponse response.");
+        return MessageHandleResult::Error;
+    }
 
     if (!Config.DisableBloodMessages)
     {
         DS2_OnlineAreaId AreaId = (DS2_OnlineAreaId)Request->online_area_id();
         int MaxForArea = Request->max_type_1() + Request->max_type_2(); // TODO: we need to figure out the difference between these two types.
 
-        std::vector<std::shared_ptr<BloodMessage>> AreaMessages = LiveCache.GetRandomSet(MaxForArea, [AreaId](DS2_CellAndAreaId Id) {
+        int EntryCount = 0;
+        std::shared_ptr<const Frpg2PreparedPayload> AreaMessages = ListCache.GetRandomSet(LiveCache, DS2_CellAndAreaId::AnyCell(AreaId), MaxForArea, [AreaId](DS2_CellAndAreaId Id) {
             return Id.AreaId == AreaId;
-        });
-
-        for (std::shared_ptr<BloodMessage>& AreaMsg : AreaMessages)
+        }, EntryCount);
+        if (AreaMessages)
+        {
+            Response.push_back(AreaMessages);
+        }
+        else
         {
-            DS2_Frpg2RequestMessage::BloodMessageData& Data = *Response.mutable_messages()->Add();
-            Data.set_player_id(AreaMsg->PlayerId);
-            Data.set_character_id(AreaMsg->CharacterId);
-            Data.set_message_id(AreaMsg->MessageId);
-            Data.set_good(AreaMsg->RatingGood);
-            Data.set_message_data(AreaMsg->Data.data(), AreaMsg->Data.size());
-            Data.set_player_steam_id(AreaMsg->PlayerSteamId);
-            Data.set_cell_id(AreaMsg->CellId);
+            WarningS(Client->GetName().c_str(), "Failed to build blood message list for area %u.", (uint32_t)AreaId);
         }
     }
 
-    if (!Client->MessageStream->Send(&Response, &Message))
+    if (!Client->MessageStream->SendPrepared(Response, &Message))
     {
         WarningS(Client->GetName().c_str(), "Disconnecting client as failed to send RequestGetAreaBloodMessageListResponse response.");
         return MessageHandleResult::Error;
@@ -392,6 +412,8 @@ MessageHandleResult DS2_BloodMessageManager::Handle_RequestEvaluateBloodMessage(
 
         // Update rating and commit to database.
         ActiveMessage->RatingGood++;
+        ListCache.Invalidate(DS2_CellAndAreaId::AnyArea(ActiveMessage->CellId), ActiveMessage);
+        ListCache.InvalidateArea(DS2_CellAndAreaId::AnyCell((DS2_OnlineAreaId)ActiveMessage->OnlineAreaId));
 
         if (!Database.SetBloodMessageEvaluation(Request->message_id(), ActiveMessage->RatingPoor, ActiveMessage->RatingGood))
         {
@@ -11,6 +11,7 @@
 
 #include "Server/GameService/GameManager.h"
 #include "Server/GameService/Utils/OnlineAreaPool.h"
+#include "Server/GameService/Utils/ListResponseCache.h"
 #include "Server/Database/DatabaseTypes.h"
 #include "Server.DarkSouls2/Server/GameService/Utils/DS2_GameIds.h"
 #include "Server.DarkSouls2/Server/GameService/Utils/DS2_CellAndAreaId.h"
@@ -32,7 +33,7 @@ public:
     virtual void Poll() override;
     virtual void TrimDatabase() override;
 
-    virtual MessageHandleResult OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message) override;
+    virtual void RegisterMessageHandlers(MessageDispatchTable& Table) override;
 
     virtual std::string GetName() override;
 
@@ -47,10 +48,13 @@ protected:
     MessageHandleResult Handle_RequestGetAreaBloodMessageList(GameClient* Client, const Frpg2ReliableUdpMessage& Message);
     MessageHandleResult Handle_RequestEvaluateBloodMessage(GameClient* Client, const Frpg2ReliableUdpMessage& Message);
 
+    static bool SerializeListEntry(const BloodMessage& Value, std::vector<uint8_t>& Output);
+
 private:
     Server* ServerInstance;
     GameService* GameServiceInstance;
 
     OnlineAreaPool<DS2_CellAndAreaId, BloodMessage> LiveCache;
+    ListResponseCache<DS2_CellAndAreaId, BloodMessage> ListCache;
 
 };
\ No newline at end of file
@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/Bloodstain/DS2_BloodstainManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
 #include "Server/Streams/Frpg2ReliableUdpMessageStream.h"
@@ -25,8 +26,24 @@
 
 DS2_BloodstainManager::DS2_BloodstainManager(Server* InServerInstance)
     : ServerInstance(InServerInstance)
+    , ListCache(SerializeListEntry)
 {
     LiveCache.SetMaxEntriesPerArea(InServerInstance->GetConfig().BloodstainMaxLivePoolEntriesPerArea);
+    ListCache.SetTimeout(InServerInstance->GetConfig().ListResponseCacheTime);
+}
+
+bool DS2_BloodstainManager::SerializeListEntry(const Bloodstain& Value, std::vector<uint8_t>& Output)
+{
+    DS2_Frpg2RequestMessage::RequestGetBloodstainListResponse Response;
+
+    DS2_Frpg2RequestMessage::BloodstainInfo& Data = *Response.mutable_bloodstains()->Add();
+    Data.set_online_area_id((uint32_t)Value.OnlineAreaId);
+    Data.set_cell_id(Value.CellId);
+    Data.set_bloodstain_id((uint32_t)Value.BloodstainId);
+    Data.set_data(Value.Data.data(), Value.Data.size());
+
+    Output.resize(Response.ByteSize());
+    return Response.SerializeToArray(Output.data(), (int)Output.size());
 }
 
 bool DS2_BloodstainManager::Init()
@@ -57,6 +74,11 @@ bool DS2_BloodstainManager::Init()
     return true;
 }
 
+void DS2_BloodstainManager::Poll()
+{
+    ListCache.Poll();
+}
+
 void DS2_BloodstainManager::TrimDatabase()
 {
     ServerDatabase& Database = ServerInstance->GetDatabase();
@@ -66,26 +88,12 @@ void DS2_BloodstainManager::TrimDatabase()
     Database.TrimBloodStains(MaxEntries);
 }
 
-MessageHandleResult DS2_BloodstainManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS2_BloodstainManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestCreateBloodstain))
-    {
-        return Handle_RequestCreateBloodstain(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetBloodstainList))
-    {
-        return Handle_RequestGetBloodstainList(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetAreaBloodstainList))
-    {
-        return Handle_RequestGetAreaBloodstainList(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetDeadingGhost))
-    {
-        return Handle_RequestGetDeadingGhost(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestCreateBloodstain, this, &DS2_BloodstainManager::Handle_RequestCreateBloodstain);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetBloodstainList, this, &DS2_BloodstainManager::Handle_RequestGetBloodstainList);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetAreaBloodstainList, this, &DS2_BloodstainManager::Handle_RequestGetAreaBloodstainList);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetDeadingGhost, this, &DS2_BloodstainManager::Handle_RequestGetDeadingGhost);
 }
 
 MessageHandleResult DS2_BloodstainManager::Handle_RequestCreateBloodstain(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
@@ -168,8 +176,11 @@ MessageHandleResult DS2_BloodstainManager::Handle_RequestGetBloodstainList(GameC
     PlayerState& Player = Client->GetPlayerState();
 
     DS2_Frpg2RequestMessage::RequestGetBloodstainList* Request = (DS2_Frpg2RequestMessage::RequestGetBloodstainList*)Message.Protobuf.get();
-    DS2_Frpg2RequestMessage::RequestGetBloodstainListResponse Response;
-    Response.mutable_bloodstains();
+
+    // The response (RequestGetBloodstainListResponse) is built out of the already serialized and compressed
+    // selections for each cell, see ListResponseCache. Selections cover every area the cell is in, so are 
+    // cached under DS2_CellAndAreaId::AnyArea.
+    Frpg2PreparedPayloadList Response;
 
     int RemainingStainCount = (int)Request->max_stains();
 
@@ -184,23 +195,22 @@ MessageHandleResult DS2_BloodstainManager::Handle_RequestGetBloodstainList(GameC
             int MaxForCell = (int)Area.max_items();
             int GatherCount = std::min(MaxForCell, RemainingStainCount);
             
-            std::vector<std::shared_ptr<Bloodstain>> AreaStains = LiveCache.GetRandomSet(GatherCount, [CellId](DS2_CellAndAreaId Id) {
+            int EntryCount = 0;
+            std::shared_ptr<const Frpg2PreparedPayload> CellStains = ListCache.GetRandomSet(LiveCache, DS2_CellAndAreaId::AnyArea(CellId), GatherCount, [CellId](DS2_CellAndAreaId Id) {
                 return Id.CellId == CellId;
-            });
-            for (std::shared_ptr<Bloodstain>& AreaMsg : AreaStains)
+            }, EntryCount);
+            if (!CellStains)
             {
-                DS2_Frpg2RequestMessage::BloodstainInfo& Data = *Response.mutable_bloodstains()->Add();
-                Data.set_online_area_id((uint32_t)AreaMsg->OnlineAreaId);
-                Data.set_cell_id(AreaMsg->CellId);
-                Data.set_bloodstain_id((uint32_t)AreaMsg->BloodstainId);
-                Data.set_data(AreaMsg->Data.data(), AreaMsg->Data.size());
-            
-                RemainingStainCount--;
+                WarningS(Client->GetName().c_str(), "Failed to build bloodstain list for cell %llu.", (unsigned long long)CellId);
+                continue;
             }
+
+            Response.push_back(CellStains);
+            RemainingStainCount -= EntryCount;
         }
     }
 
-    if (!Client->MessageStream->Send(&Response, &Message))
+    if (!Client->MessageStream->SendPrepared(Response, &Message))
     {
         WarningS(Client->GetName().c_str(), "Disconnecting client as failed to send RequestCreateBloodMessageResponse response.");
         return MessageHandleResult::Error;
@@ -216,29 +226,30 @@ MessageHandleResult DS2_BloodstainManager::Handle_RequestGetAreaBloodstainList(G
     PlayerState& Player = Client->GetPlayerState();
 
     DS2_Frpg2RequestMessage::RequestGetAreaBloodstainList* Request = (DS2_Frpg2RequestMessage::RequestGetAreaBloodstainList*)Message.Protobuf.get();
-    DS2_Frpg2RequestMessage::RequestGetBloodstainListResponse Response;
-    Response.mutable_bloodstains();
+
+    // Built the same way as the response to RequestGetBloodstainList.
+    Frpg2PreparedPayloadList Response;
 
     if (!Config.DisableBloodStains)
     {
         DS2_OnlineAreaId AreaId = (DS2_OnlineAreaId)Request->online_area_id();
         int MaxForArea = Request->count();
 
-        std::vector<std::shared_ptr<Bloodstain>> AreaStains = LiveCache.GetRandomSet(MaxForArea, [AreaId](DS2_CellAndAreaId Id) {
+        int EntryCount = 0;
+        std::shared_ptr<const Frpg2PreparedPayload> AreaStains = ListCache.GetRandomSet(LiveCache, DS2_CellAndAreaId::AnyCell(AreaId), MaxForArea, [AreaId](DS2_CellAndAreaId Id) {
             return Id.AreaId == AreaId;
-        });
-
-        for (std::shared_ptr<Bloodstain>& AreaMsg : AreaStains)
+        }, EntryCount);
+        if (AreaStains)
         {
-            DS2_Frpg2RequestMessage::BloodstainInfo& Data = *Response.mutable_bloodstains()->Add();
-            Data.set_online_area_id(AreaMsg->OnlineAreaId);
-            Data.set_cell_id(AreaMsg->CellId);
-            Data.set_bloodstain_id(AreaMsg->BloodstainId);
-            Data.set_data(AreaMsg->Data.data(), AreaMsg->Data.size());
+            Response.push_back(AreaStains);
+        }
+        else
+        {
+            WarningS(Client->GetName().c_str(), "Failed to build bloodstain list for area %u.", (uint32_t)AreaId);
         }
     }
 
-    if (!Client->MessageStream->Send(&Response, &Message))
+    if (!Client->MessageStream->SendPrepared(Response, &Message))
     {
         WarningS(Client->GetName().c_str(), "Disconnecting client as failed to send RequestGetAreaBloodMessageListResponse response.");
         return MessageHandleResult::Error;
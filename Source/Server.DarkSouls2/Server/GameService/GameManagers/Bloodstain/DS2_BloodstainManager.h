@@ -11,6 +11,7 @@
 
 #include "Server/GameService/GameManager.h"
 #include "Server/GameService/Utils/OnlineAreaPool.h"
+#include "Server/GameService/Utils/ListResponseCache.h"
 #include "Server/Database/DatabaseTypes.h"
 #include "Server.DarkSouls2/Server/GameService/Utils/DS2_GameIds.h"
 #include "Server.DarkSouls2/Server/GameService/Utils/DS2_CellAndAreaId.h"
@@ -28,9 +29,10 @@ public:
     DS2_BloodstainManager(Server* InServerInstance);
 
     virtual bool Init() override;
+    virtual void Poll() override;
     virtual void TrimDatabase() override;
 
-    virtual MessageHandleResult OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message) override;
+    virtual void RegisterMessageHandlers(MessageDispatchTable& Table) override;
 
     virtual std::string GetName() override;
 
@@ -42,10 +44,13 @@ protected:
     MessageHandleResult Handle_RequestGetAreaBloodstainList(GameClient* Client, const Frpg2ReliableUdpMessage& Message);
     MessageHandleResult Handle_RequestGetDeadingGhost(GameClient* Client, const Frpg2ReliableUdpMessage& Message);
 
+    static bool SerializeListEntry(const Bloodstain& Value, std::vector<uint8_t>& Output);
+
 private:
     Server* ServerInstance;
 
     OnlineAreaPool<DS2_CellAndAreaId, Bloodstain> LiveCache;
+    ListResponseCache<DS2_CellAndAreaId, Bloodstain> ListCache;
 
     uint32_t NextMemoryCacheStainId = std::numeric_limits<uint32_t>::max();
 
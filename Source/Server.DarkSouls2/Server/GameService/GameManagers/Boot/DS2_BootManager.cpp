@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/Boot/DS2_BootManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/GameService/GameService.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
@@ -29,18 +30,10 @@ DS2_BootManager::DS2_BootManager(Server* InServerInstance)
 {
 }
 
-MessageHandleResult DS2_BootManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS2_BootManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestWaitForUserLogin))
-    {
-        return Handle_RequestWaitForUserLogin(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetAnnounceMessageList))
-    {
-        return Handle_RequestGetAnnounceMessageList(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestWaitForUserLogin, this, &DS2_BootManager::Handle_RequestWaitForUserLogin);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetAnnounceMessageList, this, &DS2_BootManager::Handle_RequestGetAnnounceMessageList);
 }
 
 MessageHandleResult DS2_BootManager::Handle_RequestWaitForUserLogin(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
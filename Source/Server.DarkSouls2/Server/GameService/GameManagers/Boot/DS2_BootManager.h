@@ -23,7 +23,7 @@ class DS2_BootManager
 public:    
     DS2_BootManager(Server* InServerInstance);
 
-    virtual MessageHandleResult OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message) override;
+    virtual void RegisterMessageHandlers(MessageDispatchTable& Table) override;
 
     virtual std::string GetName() override;
 
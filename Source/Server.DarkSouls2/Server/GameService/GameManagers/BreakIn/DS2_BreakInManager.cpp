@@ -8,11 +8,13 @@
  */
 
 #include "Server/GameService/GameManagers/BreakIn/DS2_BreakInManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/DS2_PlayerState.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/GameService/GameService.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
 #include "Server/Streams/Frpg2ReliableUdpMessageStream.h"
+#include "Server/Streams/Frpg2ProtobufPool.h"
 #include "Server/Streams/DS2_Frpg2ReliableUdpMessage.h"
 #include "Server/GameService/Utils/DS2_GameIds.h"
 
@@ -33,22 +35,11 @@ void DS2_BreakInManager::OnLostPlayer(GameClient* Client)
 {
 }
 
-MessageHandleResult DS2_BreakInManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS2_BreakInManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetBreakInTargetList))
-    {
-        return Handle_RequestGetBreakInTargetList(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestBreakInTarget))
-    {
-        return Handle_RequestBreakInTarget(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestRejectBreakInTarget))
-    {
-        return Handle_RequestRejectBreakInTarget(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetBreakInTargetList, this, &DS2_BreakInManager::Handle_RequestGetBreakInTargetList);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestBreakInTarget, this, &DS2_BreakInManager::Handle_RequestBreakInTarget);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestRejectBreakInTarget, this, &DS2_BreakInManager::Handle_RequestRejectBreakInTarget);
 }
 
 bool DS2_BreakInManager::CanMatchWith(const DS2_Frpg2RequestMessage::MatchingParameter& Request, const std::shared_ptr<GameClient>& Match, DS2_Frpg2RequestMessage::BreakInType Type)
@@ -133,21 +124,21 @@ MessageHandleResult DS2_BreakInManager::Handle_RequestGetBreakInTargetList(GameC
         return CanMatchWith(Request->matching_parameter(), OtherClient, Request->type()); 
     });
 
-    DS2_Frpg2RequestMessage::RequestGetBreakInTargetListResponse Response;
-    Response.set_cell_id(Request->cell_id());
-    Response.set_online_area_id(Request->online_area_id());
+    std::shared_ptr<DS2_Frpg2RequestMessage::RequestGetBreakInTargetListResponse> Response = Frpg2ProtobufPool<DS2_Frpg2RequestMessage::RequestGetBreakInTargetListResponse>::Acquire();
+    Response->set_cell_id(Request->cell_id());
+    Response->set_online_area_id(Request->online_area_id());
 
     int CountToSend = std::min((int)Request->max_targets(), (int)PotentialTargets.size());
     for (int i = 0; i < CountToSend; i++)
     {
         std::shared_ptr<GameClient> OtherClient = PotentialTargets[i];
 
-        DS2_Frpg2RequestMessage::BreakInTargetData* Data = Response.add_target_data();
+        DS2_Frpg2RequestMessage::BreakInTargetData* Data = Response->add_target_data();
         Data->set_player_id(OtherClient->GetPlayerState().GetPlayerId());
         Data->set_steam_id(OtherClient->GetPlayerState().GetSteamId());
     }
 
-    if (!Client->MessageStream->Send(&Response, &Message))
+    if (!Client->MessageStream->Send(Response.get(), &Message))
     {
         WarningS(Client->GetName().c_str(), "Disconnecting client as failed to send RequestGetBreakInTargetListResponse response.");
         return MessageHandleResult::Error;
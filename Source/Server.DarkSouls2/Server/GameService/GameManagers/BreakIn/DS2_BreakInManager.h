@@ -26,7 +26,7 @@ class DS2_BreakInManager
 public:    
     DS2_BreakInManager(Server* InServerInstance, GameService* InGameServiceInstance);
 
-    virtual MessageHandleResult OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message) override;
+    virtual void RegisterMessageHandlers(MessageDispatchTable& Table) override;
 
     virtual std::string GetName() override;
 
@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/Ghosts/DS2_GhostManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
 #include "Server/Streams/Frpg2ReliableUdpMessageStream.h"
@@ -25,8 +26,24 @@
 
 DS2_GhostManager::DS2_GhostManager(Server* InServerInstance)
     : ServerInstance(InServerInstance)
+    , ListCache(SerializeListEntry)
 {
     LiveCache.SetMaxEntriesPerArea(InServerInstance->GetConfig().GhostMaxLivePoolEntriesPerArea);
+    ListCache.SetTimeout(InServerInstance->GetConfig().ListResponseCacheTime);
+}
+
+bool DS2_GhostManager::SerializeListEntry(const Ghost& Value, std::vector<uint8_t>& Output)
+{
+    // online_area_id is sent as a seperate part, so this is serialized partially.
+    DS2_Frpg2RequestMessage::RequestGetGhostDataListResponse Response;
+
+    DS2_Frpg2RequestMessage::GhostData& Data = *Response.mutable_ghosts()->Add();
+    Data.set_cell_id(Value.CellId);
+    Data.set_ghost_id((uint32_t)Value.GhostId);
+    Data.set_data(Value.Data.data(), Value.Data.size());
+
+    Output.resize(Response.ByteSize());
+    return Response.SerializePartialToArray(Output.data(), (int)Output.size());
 }
 
 bool DS2_GhostManager::Init()
@@ -57,6 +74,11 @@ bool DS2_GhostManager::Init()
     return true;
 }
 
+void DS2_GhostManager::Poll()
+{
+    ListCache.Poll();
+}
+
 void DS2_GhostManager::TrimDatabase()
 {
     ServerDatabase& Database = ServerInstance->GetDatabase();
@@ -66,18 +88,10 @@ void DS2_GhostManager::TrimDatabase()
     Database.TrimGhosts(MaxEntries);
 }
 
-MessageHandleResult DS2_GhostManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS2_GhostManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestCreateGhostData))
-    {
-        return Handle_RequestCreateGhostData(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetGhostDataList))
-    {
-        return Handle_RequestGetGhostDataList(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestCreateGhostData, this, &DS2_GhostManager::Handle_RequestCreateGhostData);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetGhostDataList, this, &DS2_GhostManager::Handle_RequestGetGhostDataList);
 }
 
 MessageHandleResult DS2_GhostManager::Handle_RequestCreateGhostData(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
@@ -157,9 +171,19 @@ MessageHandleResult DS2_GhostManager::Handle_RequestGetGhostDataList(GameClient*
     PlayerState& Player = Client->GetPlayerState();
 
     DS2_Frpg2RequestMessage::RequestGetGhostDataList* Request = (DS2_Frpg2RequestMessage::RequestGetGhostDataList*)Message.Protobuf.get();
-    DS2_Frpg2RequestMessage::RequestGetGhostDataListResponse Response;
-    Response.set_online_area_id(Request->online_area_id());
-    Response.mutable_ghosts();
+
+    // The response (RequestGetGhostDataListResponse) is built out of the online_area_id followed by the 
+    // already serialized and compressed selections for each cell, see ListResponseCache.
+    DS2_Frpg2RequestMessage::RequestGetGhostDataListResponse Header;
+    Header.set_online_area_id(Request->online_area_id());
+
+    Frpg2PreparedPayloadList Response;
+    Response.push_back(Frpg2ReliableUdpMessageStream::PrepareProtobuf(&Header));
+    if (!Response.back())
+    {
+        WarningS(Client->GetName().c_str(), "Disconnecting client as failed to prepare RequestGetGhostDataListResponse response.");
+        return MessageHandleResult::Error;
+    }
 
     uint32_t RemainingGhostCount = Request->max_ghosts();
 
@@ -174,20 +198,20 @@ MessageHandleResult DS2_GhostManager::Handle_RequestGetGhostDataList(GameClient*
             uint32_t MaxForCell = Area.max_items();
             uint32_t GatherCount = std::min(MaxForCell, RemainingGhostCount);
 
-            std::vector<std::shared_ptr<Ghost>> ActiveGhosts = LiveCache.GetRandomSet(CellId, GatherCount);
-            for (std::shared_ptr<Ghost>& AreaMsg : ActiveGhosts)
+            int EntryCount = 0;
+            std::shared_ptr<const Frpg2PreparedPayload> ActiveGhosts = ListCache.GetRandomSet(LiveCache, CellId, (int)GatherCount, EntryCount);
+            if (!ActiveGhosts)
             {
-                DS2_Frpg2RequestMessage::GhostData& Data = *Response.mutable_ghosts()->Add();
-                Data.set_cell_id(AreaMsg->CellId);                                                      
-                Data.set_ghost_id((uint32_t)AreaMsg->GhostId);
-                Data.set_data(AreaMsg->Data.data(), AreaMsg->Data.size());
-
-                RemainingGhostCount--;
+                WarningS(Client->GetName().c_str(), "Failed to build ghost list for cell %llu.", (unsigned long long)CellId);
+                continue;
             }
+
+            Response.push_back(ActiveGhosts);
+            RemainingGhostCount -= (uint32_t)EntryCount;
         }
     }
 
-    if (!Client->MessageStream->Send(&Response, &Message))
+    if (!Client->MessageStream->SendPrepared(Response, &Message))
     {
         WarningS(Client->GetName().c_str(), "Disconnecting client as failed to send RequestGetGhostDataListResponse response.");
         return MessageHandleResult::Error;
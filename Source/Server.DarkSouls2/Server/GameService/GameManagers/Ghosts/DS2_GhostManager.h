@@ -11,6 +11,7 @@
 
 #include "Server/GameService/GameManager.h"
 #include "Server/GameService/Utils/OnlineAreaPool.h"
+#include "Server/GameService/Utils/ListResponseCache.h"
 #include "Server/Database/DatabaseTypes.h"
 #include "Server.DarkSouls2/Server/GameService/Utils/DS2_GameIds.h"
 #include "Server.DarkSouls2/Server/GameService/Utils/DS2_CellAndAreaId.h"
@@ -29,9 +30,10 @@ public:
     DS2_GhostManager(Server* InServerInstance);
 
     virtual bool Init() override;
+    virtual void Poll() override;
     virtual void TrimDatabase() override;
 
-    virtual MessageHandleResult OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message) override;
+    virtual void RegisterMessageHandlers(MessageDispatchTable& Table) override;
 
     virtual std::string GetName() override;
 
@@ -41,10 +43,13 @@ protected:
     MessageHandleResult Handle_RequestCreateGhostData(GameClient* Client, const Frpg2ReliableUdpMessage& Message);
     MessageHandleResult Handle_RequestGetGhostDataList(GameClient* Client, const Frpg2ReliableUdpMessage& Message);
 
+    static bool SerializeListEntry(const Ghost& Value, std::vector<uint8_t>& Output);
+
 private:
     Server* ServerInstance;
 
     OnlineAreaPool<uint64_t, Ghost> LiveCache;
+    ListResponseCache<uint64_t, Ghost> ListCache;
 
     uint32_t NextMemoryCacheGhostId = std::numeric_limits<uint32_t>::max();
 
@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/Logging/DS2_LoggingManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/GameService.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
@@ -28,54 +29,19 @@ DS2_LoggingManager::DS2_LoggingManager(Server* InServerInstance)
 {
 }
 
-MessageHandleResult DS2_LoggingManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS2_LoggingManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestNotifyBuyItem))
-    {
-        return Handle_RequestNotifyBuyItem(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestNotifyDeath))
-    {
-        return Handle_RequestNotifyDeath(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestNotifyDisconnectSession))
-    {
-        return Handle_RequestNotifyDisconnectSession(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestNotifyJoinGuestPlayer))
-    {
-        return Handle_RequestNotifyJoinGuestPlayer(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestNotifyJoinSession))
-    {
-        return Handle_RequestNotifyJoinSession(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestNotifyKillEnemy))
-    {
-        return Handle_RequestNotifyKillEnemy(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestNotifyKillPlayer))
-    {
-        return Handle_RequestNotifyKillPlayer(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestNotifyLeaveGuestPlayer))
-    {
-        return Handle_RequestNotifyLeaveGuestPlayer(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestNotifyLeaveSession))
-    {
-        return Handle_RequestNotifyLeaveSession(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestNotifyMirrorKnight))
-    {
-        return Handle_RequestNotifyMirrorKnight(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestNotifyOfflineDeathCount))
-    {
-        return Handle_RequestNotifyOfflineDeathCount(Client, Message);
-    }
-        
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestNotifyBuyItem, this, &DS2_LoggingManager::Handle_RequestNotifyBuyItem);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestNotifyDeath, this, &DS2_LoggingManager::Handle_RequestNotifyDeath);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestNotifyDisconnectSession, this, &DS2_LoggingManager::Handle_RequestNotifyDisconnectSession);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestNotifyJoinGuestPlayer, this, &DS2_LoggingManager::Handle_RequestNotifyJoinGuestPlayer);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestNotifyJoinSession, this, &DS2_LoggingManager::Handle_RequestNotifyJoinSession);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestNotifyKillEnemy, this, &DS2_LoggingManager::Handle_RequestNotifyKillEnemy);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestNotifyKillPlayer, this, &DS2_LoggingManager::Handle_RequestNotifyKillPlayer);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestNotifyLeaveGuestPlayer, this, &DS2_LoggingManager::Handle_RequestNotifyLeaveGuestPlayer);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestNotifyLeaveSession, this, &DS2_LoggingManager::Handle_RequestNotifyLeaveSession);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestNotifyMirrorKnight, this, &DS2_LoggingManager::Handle_RequestNotifyMirrorKnight);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestNotifyOfflineDeathCount, this, &DS2_LoggingManager::Handle_RequestNotifyOfflineDeathCount);
 }
 
 MessageHandleResult DS2_LoggingManager::Handle_RequestNotifyBuyItem(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/MirrorKnight/DS2_MirrorKnightManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/DS2_PlayerState.h"
 #include "Server/GameService/Utils/DS2_GameIds.h"
 #include "Server/GameService/GameClient.h"
@@ -51,23 +52,23 @@ void DS2_MirrorKnightManager::RemoveSignAndNotifyAware(const std::shared_ptr<Sum
     LiveCache.erase(Sign->SignId);
 
     // Tell anyone who is aware of this sign that its been removed.
+    std::vector<std::shared_ptr<GameClient>> AwareClients;
     for (uint32_t AwarePlayerId : Sign->AwarePlayerIds)
     {
         if (std::shared_ptr<GameClient> OtherClient = GameServiceInstance->FindClientByPlayerId(AwarePlayerId))
         {
-            DS2_Frpg2RequestMessage::PushRequestRemoveMirrorKnightSign PushMessage;
-            PushMessage.set_push_message_id(DS2_Frpg2RequestMessage::PushID_PushRequestRemoveMirrorKnightSign);
-            PushMessage.set_player_id(Sign->PlayerId);
-            PushMessage.set_sign_id(Sign->SignId);
-            PushMessage.set_player_steam_id(Sign->PlayerSteamId);
-
-            if (!OtherClient->MessageStream->Send(&PushMessage))
-            {
-                WarningS(OtherClient->GetName().c_str(), "Failed to send PushRequestRemoveMirrorKnightSign to aware player.");
-            }
+            AwareClients.push_back(OtherClient);
         }
     }
 
+    DS2_Frpg2RequestMessage::PushRequestRemoveMirrorKnightSign PushMessage;
+    PushMessage.set_push_message_id(DS2_Frpg2RequestMessage::PushID_PushRequestRemoveMirrorKnightSign);
+    PushMessage.set_player_id(Sign->PlayerId);
+    PushMessage.set_sign_id(Sign->SignId);
+    PushMessage.set_player_steam_id(Sign->PlayerSteamId);
+
+    GameServiceInstance->SendToClients(AwareClients, &PushMessage);
+
     Sign->BeingSummonedByPlayerId = 0;
     Sign->AwarePlayerIds.clear();
 }
@@ -76,34 +77,14 @@ void DS2_MirrorKnightManager::Poll()
 {
 }
 
-MessageHandleResult DS2_MirrorKnightManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS2_MirrorKnightManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetMirrorKnightSignList))
-    {
-        return Handle_RequestGetMirrorKnightSignList(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestCreateMirrorKnightSign))
-    {
-        return Handle_RequestCreateMirrorKnightSign(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestRemoveMirrorKnightSign))
-    {
-        return Handle_RequestRemoveMirrorKnightSign(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestUpdateMirrorKnightSign))
-    {
-        return Handle_RequestUpdateMirrorKnightSign(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestSummonMirrorKnightSign))
-    {
-        return Handle_RequestSummonMirrorKnightSign(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestRejectMirrorKnightSign))
-    {
-        return Handle_RequestRejectMirrorKnightSign(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetMirrorKnightSignList, this, &DS2_MirrorKnightManager::Handle_RequestGetMirrorKnightSignList);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestCreateMirrorKnightSign, this, &DS2_MirrorKnightManager::Handle_RequestCreateMirrorKnightSign);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestRemoveMirrorKnightSign, this, &DS2_MirrorKnightManager::Handle_RequestRemoveMirrorKnightSign);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestUpdateMirrorKnightSign, this, &DS2_MirrorKnightManager::Handle_RequestUpdateMirrorKnightSign);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestSummonMirrorKnightSign, this, &DS2_MirrorKnightManager::Handle_RequestSummonMirrorKnightSign);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestRejectMirrorKnightSign, this, &DS2_MirrorKnightManager::Handle_RequestRejectMirrorKnightSign);
 }
 
 bool DS2_MirrorKnightManager::CanMatchWith(const DS2_Frpg2RequestMessage::MatchingParameter& Host, const DS2_Frpg2RequestMessage::MatchingParameter& Match, uint32_t SignType)
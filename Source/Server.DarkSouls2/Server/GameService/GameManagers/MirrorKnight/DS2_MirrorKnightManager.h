@@ -29,7 +29,7 @@ class DS2_MirrorKnightManager
 public:    
     DS2_MirrorKnightManager(Server* InServerInstance, GameService* InGameServiceInstance);
 
-    virtual MessageHandleResult OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message) override;
+    virtual void RegisterMessageHandlers(MessageDispatchTable& Table) override;
 
     virtual std::string GetName() override;
     virtual void Poll() override;
@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/Misc/DS2_MiscManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/DS2_PlayerState.h"
 #include "Server/GameService/GameService.h"
 #include "Server/GameService/GameClient.h"
@@ -34,18 +35,10 @@ DS2_MiscManager::DS2_MiscManager(Server* InServerInstance, GameService* InGameSe
 {
 }
 
-MessageHandleResult DS2_MiscManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS2_MiscManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestSendMessageToPlayers))
-    {
-        return Handle_RequestSendMessageToPlayers(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetTotalDeathCount))
-    {
-        return Handle_RequestGetTotalDeathCount(Client, Message);
-    }
-    
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestSendMessageToPlayers, this, &DS2_MiscManager::Handle_RequestSendMessageToPlayers);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetTotalDeathCount, this, &DS2_MiscManager::Handle_RequestGetTotalDeathCount);
 }
 
 void DS2_MiscManager::Poll()
@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/PlayerData/DS2_PlayerDataManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/DS2_PlayerState.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
@@ -29,30 +30,13 @@ DS2_PlayerDataManager::DS2_PlayerDataManager(Server* InServerInstance)
 {
 }
 
-MessageHandleResult DS2_PlayerDataManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS2_PlayerDataManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestUpdateLoginPlayerCharacter))
-    {
-        return Handle_RequestUpdateLoginPlayerCharacter(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestUpdatePlayerStatus))
-    {
-        return Handle_RequestUpdatePlayerStatus(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestUpdatePlayerCharacter))
-    {
-        return Handle_RequestUpdatePlayerCharacter(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetLoginPlayerCharacter))
-    {
-        return Handle_RequestGetLoginPlayerCharacter(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetPlayerCharacter))
-    {
-        return Handle_RequestGetPlayerCharacter(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestUpdateLoginPlayerCharacter, this, &DS2_PlayerDataManager::Handle_RequestUpdateLoginPlayerCharacter);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestUpdatePlayerStatus, this, &DS2_PlayerDataManager::Handle_RequestUpdatePlayerStatus);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestUpdatePlayerCharacter, this, &DS2_PlayerDataManager::Handle_RequestUpdatePlayerCharacter);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetLoginPlayerCharacter, this, &DS2_PlayerDataManager::Handle_RequestGetLoginPlayerCharacter);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetPlayerCharacter, this, &DS2_PlayerDataManager::Handle_RequestGetPlayerCharacter);
 }
 
 MessageHandleResult DS2_PlayerDataManager::Handle_RequestUpdateLoginPlayerCharacter(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/QuickMatch/DS2_QuickMatchManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/DS2_PlayerState.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/GameService/GameService.h"
@@ -53,34 +54,14 @@ void DS2_QuickMatchManager::Poll()
 {
 }
 
-MessageHandleResult DS2_QuickMatchManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS2_QuickMatchManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestSearchQuickMatch))
-    {
-        return Handle_RequestSearchQuickMatch(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestUnregisterQuickMatch))
-    {
-        return Handle_RequestUnregisterQuickMatch(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestUpdateQuickMatch))
-    {
-        return Handle_RequestUpdateQuickMatch(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestJoinQuickMatch))
-    {
-        return Handle_RequestJoinQuickMatch(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestRejectQuickMatch))
-    {
-        return Handle_RequestRejectQuickMatch(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestRegisterQuickMatch))
-    {
-        return Handle_RequestRegisterQuickMatch(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestSearchQuickMatch, this, &DS2_QuickMatchManager::Handle_RequestSearchQuickMatch);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestUnregisterQuickMatch, this, &DS2_QuickMatchManager::Handle_RequestUnregisterQuickMatch);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestUpdateQuickMatch, this, &DS2_QuickMatchManager::Handle_RequestUpdateQuickMatch);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestJoinQuickMatch, this, &DS2_QuickMatchManager::Handle_RequestJoinQuickMatch);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestRejectQuickMatch, this, &DS2_QuickMatchManager::Handle_RequestRejectQuickMatch);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestRegisterQuickMatch, this, &DS2_QuickMatchManager::Handle_RequestRegisterQuickMatch);
 }
 
 bool DS2_QuickMatchManager::CanMatchWith(GameClient* Client, const DS2_Frpg2RequestMessage::RequestSearchQuickMatch& Request, const std::shared_ptr<Match>& Match)
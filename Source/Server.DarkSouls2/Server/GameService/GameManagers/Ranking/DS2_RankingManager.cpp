@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/Ranking/DS2_RankingManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
 #include "Server/Streams/Frpg2ReliableUdpMessageStream.h"
@@ -25,26 +26,12 @@ DS2_RankingManager::DS2_RankingManager(Server* InServerInstance)
 {
 }
 
-MessageHandleResult DS2_RankingManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS2_RankingManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestRegisterPowerStoneData))
-    {
-        return Handle_RequestRegisterPowerStoneData(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetPowerStoneRanking))
-    {
-        return Handle_RequestGetPowerStoneRanking(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetPowerStoneMyRanking))
-    {
-        return Handle_RequestGetPowerStoneMyRanking(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetPowerStoneRankingRecordCount))
-    {
-        return Handle_RequestGetPowerStoneRankingRecordCount(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestRegisterPowerStoneData, this, &DS2_RankingManager::Handle_RequestRegisterPowerStoneData);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetPowerStoneRanking, this, &DS2_RankingManager::Handle_RequestGetPowerStoneRanking);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetPowerStoneMyRanking, this, &DS2_RankingManager::Handle_RequestGetPowerStoneMyRanking);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetPowerStoneRankingRecordCount, this, &DS2_RankingManager::Handle_RequestGetPowerStoneRankingRecordCount);
 }
 
 MessageHandleResult DS2_RankingManager::Handle_RequestRegisterPowerStoneData(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
@@ -8,12 +8,14 @@
  */
 
 #include "Server/GameService/GameManagers/Signs/DS2_SignManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/DS2_PlayerState.h"
 #include "Server/GameService/Utils/DS2_GameIds.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/GameService/GameService.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
 #include "Server/Streams/Frpg2ReliableUdpMessageStream.h"
+#include "Server/Streams/Frpg2ProtobufPool.h"
 #include "Server/Streams/DS2_Frpg2ReliableUdpMessage.h"
 #include "Protobuf/DS2_Protobufs.h"
 
@@ -54,23 +56,23 @@ void DS2_SignManager::RemoveSignAndNotifyAware(const std::shared_ptr<SummonSign>
     LiveCache.Remove(LocationId, Sign->SignId);
 
     // Tell anyone who is aware of this sign that its been removed.
+    std::vector<std::shared_ptr<GameClient>> AwareClients;
     for (uint32_t AwarePlayerId : Sign->AwarePlayerIds)
     {
         if (std::shared_ptr<GameClient> OtherClient = GameServiceInstance->FindClientByPlayerId(AwarePlayerId))
         {
-            DS2_Frpg2RequestMessage::PushRequestRemoveSign PushMessage;
-            PushMessage.set_push_message_id(DS2_Frpg2RequestMessage::PushID_PushRequestRemoveSign);
-            PushMessage.set_player_id(Sign->PlayerId);
-            PushMessage.set_sign_id(Sign->SignId);
-            PushMessage.set_player_steam_id(Sign->PlayerSteamId);
-
-            if (!OtherClient->MessageStream->Send(&PushMessage))
-            {
-                WarningS(OtherClient->GetName().c_str(), "Failed to send PushRequestRemoveSign to aware player.");
-            }
+            AwareClients.push_back(OtherClient);
         }
     }
 
+    DS2_Frpg2RequestMessage::PushRequestRemoveSign PushMessage;
+    PushMessage.set_push_message_id(DS2_Frpg2RequestMessage::PushID_PushRequestRemoveSign);
+    PushMessage.set_player_id(Sign->PlayerId);
+    PushMessage.set_sign_id(Sign->SignId);
+    PushMessage.set_player_steam_id(Sign->PlayerSteamId);
+
+    GameServiceInstance->SendToClients(AwareClients, &PushMessage);
+
     Sign->BeingSummonedByPlayerId = 0;
     Sign->AwarePlayerIds.clear();
 }
@@ -79,38 +81,15 @@ void DS2_SignManager::Poll()
 {
 }
 
-MessageHandleResult DS2_SignManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS2_SignManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetSignList))
-    {
-        return Handle_RequestGetSignList(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestCreateSign))
-    {
-        return Handle_RequestCreateSign(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestRemoveSign))
-    {
-        return Handle_RequestRemoveSign(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestUpdateSign))
-    {
-        return Handle_RequestUpdateSign(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestSummonSign))
-    {
-        return Handle_RequestSummonSign(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestRejectSign))
-    {
-        return Handle_RequestRejectSign(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetRightMatchingArea))
-    {
-        return Handle_RequestGetRightMatchingArea(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetSignList, this, &DS2_SignManager::Handle_RequestGetSignList);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestCreateSign, this, &DS2_SignManager::Handle_RequestCreateSign);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestRemoveSign, this, &DS2_SignManager::Handle_RequestRemoveSign);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestUpdateSign, this, &DS2_SignManager::Handle_RequestUpdateSign);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestSummonSign, this, &DS2_SignManager::Handle_RequestSummonSign);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestRejectSign, this, &DS2_SignManager::Handle_RequestRejectSign);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetRightMatchingArea, this, &DS2_SignManager::Handle_RequestGetRightMatchingArea);
 }
 
 bool DS2_SignManager::CanMatchWith(const DS2_Frpg2RequestMessage::MatchingParameter& Host, const DS2_Frpg2RequestMessage::MatchingParameter& Match, uint32_t SignType)
@@ -152,7 +131,7 @@ MessageHandleResult DS2_SignManager::Handle_RequestGetSignList(GameClient* Clien
     PlayerState& Player = Client->GetPlayerState();
 
     DS2_Frpg2RequestMessage::RequestGetSignList* Request = (DS2_Frpg2RequestMessage::RequestGetSignList*)Message.Protobuf.get();
-    DS2_Frpg2RequestMessage::RequestGetSignListResponse Response;
+    std::shared_ptr<DS2_Frpg2RequestMessage::RequestGetSignListResponse> Response = Frpg2ProtobufPool<DS2_Frpg2RequestMessage::RequestGetSignListResponse>::Acquire();
 
     int RemainingSignCount = (int)Request->max_signs();
 
@@ -186,13 +165,13 @@ MessageHandleResult DS2_SignManager::Handle_RequestGetSignList(GameClient* Clien
             // If client already has sign data we only need to return a limited set of data.
             if (ClientExistingSignId.count(Sign->SignId) > 0)
             {
-                DS2_Frpg2RequestMessage::SignInfo* SignInfo = Response.add_sign_info();
+                DS2_Frpg2RequestMessage::SignInfo* SignInfo = Response->add_sign_info();
                 SignInfo->set_player_id(Sign->PlayerId);
                 SignInfo->set_sign_id(Sign->SignId);
             }
             else
             {
-                DS2_Frpg2RequestMessage::SignData* SignData = Response.add_sign_data();
+                DS2_Frpg2RequestMessage::SignData* SignData = Response->add_sign_data();
                 SignData->mutable_sign_info()->set_player_id(Sign->PlayerId);
                 SignData->mutable_sign_info()->set_sign_id(Sign->SignId);
                 SignData->set_online_area_id((uint32_t)Sign->OnlineAreaId);
@@ -214,7 +193,7 @@ MessageHandleResult DS2_SignManager::Handle_RequestGetSignList(GameClient* Clien
         }
     }
 
-    if (!Client->MessageStream->Send(&Response, &Message))
+    if (!Client->MessageStream->Send(Response.get(), &Message))
     {
         WarningS(Client->GetName().c_str(), "Disconnecting client as failed to send RequestGetSignListResponse response.");
         return MessageHandleResult::Error;
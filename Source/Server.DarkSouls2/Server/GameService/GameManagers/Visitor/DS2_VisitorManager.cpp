@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/Visitor/DS2_VisitorManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/DS2_PlayerState.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/GameService/GameService.h"
@@ -30,22 +31,11 @@ DS2_VisitorManager::DS2_VisitorManager(Server* InServerInstance, GameService* In
 {
 }
 
-MessageHandleResult DS2_VisitorManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS2_VisitorManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestGetVisitorList))
-    {
-        return Handle_RequestGetVisitorList(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestVisit))
-    {
-        return Handle_RequestVisit(Client, Message);
-    }
-    else if (Message.Header.IsType(DS2_Frpg2ReliableUdpMessageType::RequestRejectVisit))
-    {
-        return Handle_RequestRejectVisit(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestGetVisitorList, this, &DS2_VisitorManager::Handle_RequestGetVisitorList);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestVisit, this, &DS2_VisitorManager::Handle_RequestVisit);
+    Table.Register(DS2_Frpg2ReliableUdpMessageType::RequestRejectVisit, this, &DS2_VisitorManager::Handle_RequestRejectVisit);
 }
 
 bool DS2_VisitorManager::CanMatchWith(const DS2_Frpg2RequestMessage::MatchingParameter& Request, const std::shared_ptr<GameClient>& Match)
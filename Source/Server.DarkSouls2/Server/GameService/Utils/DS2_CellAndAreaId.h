@@ -16,11 +16,25 @@ struct DS2_CellAndAreaId
     uint64_t CellId;
     DS2_OnlineAreaId AreaId;
 
+    // Ids standing in for every cell in an area, or every area a cell is in. Used to key things
+    // that are filtered on only one of the two, eg. cached list selections.
+    static DS2_CellAndAreaId AnyCell(DS2_OnlineAreaId InAreaId) { return { 0, InAreaId }; }
+    static DS2_CellAndAreaId AnyArea(uint64_t InCellId) { return { InCellId, DS2_OnlineAreaId::None }; }
+
     bool operator==(const DS2_CellAndAreaId& other) const
     {
         return AreaId == other.AreaId &&
                CellId == other.CellId;
     }
+
+    bool operator<(const DS2_CellAndAreaId& other) const
+    {
+        if (AreaId != other.AreaId)
+        {
+            return AreaId < other.AreaId;
+        }
+        return CellId < other.CellId;
+    }
 };
 
 template <>
@@ -14,6 +14,7 @@
 
 #include "Protobuf/DS3_Protobufs.h"
 #include "Server/Streams/DS3_Frpg2ReliableUdpMessage.h"
+#include "Server/Streams/Frpg2ReliableUdpMessageTypeTable.h"
 #include "Server/GameService/Utils/DS3_GameIds.h"
 
 #include "Server/GameService/GameManagers/Boot/DS3_BootManager.h"
@@ -33,95 +34,40 @@
 
 #include <unordered_map>
 
-bool DS3_Game::Protobuf_To_ReliableUdpMessageType(google::protobuf::MessageLite* Message, Frpg2ReliableUdpMessageType& Output)
+namespace
 {
-#define DEFINE_REQUEST_RESPONSE(OpCode, Type, ProtobufClass, ResponseProtobufClass) \
-    if (dynamic_cast<DS3_Frpg2RequestMessage::ProtobufClass*>(Message) != nullptr)  \
-    {                                                                               \
-        Output = (Frpg2ReliableUdpMessageType)(int)DS3_Frpg2ReliableUdpMessageType::Type; \
-        return true;                                                                \
-    }                                                                               
-#define DEFINE_MESSAGE(OpCode, Type, ProtobufClass)                                 \
-    if (dynamic_cast<DS3_Frpg2RequestMessage::ProtobufClass*>(Message) != nullptr)  \
-    {                                                                               \
-        Output = (Frpg2ReliableUdpMessageType)(int)DS3_Frpg2ReliableUdpMessageType::Type; \
-        return true;                                                                \
-    }                                                                               
-#define DEFINE_PUSH_MESSAGE(OpCode, Type, ProtobufClass)                            \
-    if (dynamic_cast<DS3_Frpg2RequestMessage::ProtobufClass*>(Message) != nullptr)  \
-    {                                                                               \
-        Output = Frpg2ReliableUdpMessageType::Push; /* Not using push */            \
-        return true;                                                                \
-    }    
+    // Built from the message type list the first time its needed.
+    const Frpg2ReliableUdpMessageTypeTable& GetMessageTypeTable()
+    {
+        static const Frpg2ReliableUdpMessageTypeTable Table = []() {
+            Frpg2ReliableUdpMessageTypeTable Result;
+#define DEFINE_REQUEST_RESPONSE(OpCode, Type, ProtobufClass, ResponseProtobufClass)         Result.AddRequestResponse<DS3_Frpg2RequestMessage::ProtobufClass, DS3_Frpg2RequestMessage::ResponseProtobufClass>((Frpg2ReliableUdpMessageType)(int)DS3_Frpg2ReliableUdpMessageType::Type);
+#define DEFINE_MESSAGE(OpCode, Type, ProtobufClass)                                         Result.AddMessage<DS3_Frpg2RequestMessage::ProtobufClass>((Frpg2ReliableUdpMessageType)(int)DS3_Frpg2ReliableUdpMessageType::Type);
+#define DEFINE_PUSH_MESSAGE(OpCode, Type, ProtobufClass)                                    Result.AddPushMessage<DS3_Frpg2RequestMessage::ProtobufClass>();
 #include "Server.DarkSouls3/Server/Streams/DS3_Frpg2ReliableUdpMessageTypes.inc"
 #undef DEFINE_PUSH_MESSAGE
 #undef DEFINE_MESSAGE
 #undef DEFINE_REQUEST_RESPONSE
+            return Result;
+        }();
 
-    return false;
+        return Table;
+    }
 }
 
-bool DS3_Game::ReliableUdpMessageType_To_Protobuf(Frpg2ReliableUdpMessageType InType, bool IsResponse, std::shared_ptr<google::protobuf::MessageLite>& Output)
+bool DS3_Game::Protobuf_To_ReliableUdpMessageType(google::protobuf::MessageLite* Message, Frpg2ReliableUdpMessageType& Output)
 {
-#define DEFINE_REQUEST_RESPONSE(OpCode, Type, ProtobufClass, ResponseProtobufClass)                     \
-    if ((int)InType == (int)DS3_Frpg2ReliableUdpMessageType::Type)                                                      \
-    {                                                                                                   \
-        if (IsResponse)                                                                                 \
-        {                                                                                               \
-            Output = std::make_shared<DS3_Frpg2RequestMessage::ResponseProtobufClass>();                    \
-        }                                                                                               \
-        else                                                                                            \
-        {                                                                                               \
-            Output = std::make_shared<DS3_Frpg2RequestMessage::ProtobufClass>();                            \
-        }                                                                                               \
-        return true;                                                                                    \
-    }
-#define DEFINE_MESSAGE(OpCode, Type, ProtobufClass)                                                     \
-    if ((int)InType == (int)DS3_Frpg2ReliableUdpMessageType::Type)                                                      \
-    {                                                                                                   \
-        if (IsResponse)                                                                                 \
-        {                                                                                               \
-            return false;                                                                               \
-        }                                                                                               \
-        else                                                                                            \
-        {                                                                                               \
-            Output = std::make_shared<DS3_Frpg2RequestMessage::ProtobufClass>();                            \
-            return true;                                                                                \
-        }                                                                                               \
-    }
-#define DEFINE_PUSH_MESSAGE(OpCode, Type, ProtobufClass)                                                /* Not supported on server, server only sends these */
-#include "Server.DarkSouls3/Server/Streams/DS3_Frpg2ReliableUdpMessageTypes.inc"
-#undef DEFINE_PUSH_MESSAGE
-#undef DEFINE_MESSAGE
-#undef DEFINE_REQUEST_RESPONSE
+    return GetMessageTypeTable().GetMessageType(*Message, Output);
+}
 
-    return false;
+bool DS3_Game::ReliableUdpMessageType_To_Protobuf(Frpg2ReliableUdpMessageType InType, bool IsResponse, std::shared_ptr<google::protobuf::MessageLite>& Output)
+{
+    return GetMessageTypeTable().CreateProtobuf(InType, IsResponse, Output);
 }
 
 bool DS3_Game::ReliableUdpMessageType_Expects_Response(Frpg2ReliableUdpMessageType InType)
 {
-    if ((int)InType == (int)DS3_Frpg2ReliableUdpMessageType::Push)
-    {                                                                                       
-        return false;                                                                       
-    }
-
-#define DEFINE_REQUEST_RESPONSE(OpCode, Type, ProtobufClass, ResponseProtobufClass)         \
-    if ((int)InType == (int)DS3_Frpg2ReliableUdpMessageType::Type)                                        \
-    {                                                                                       \
-        return true;                                                                        \
-    }
-#define DEFINE_MESSAGE(OpCode, Type, ProtobufClass)                                         \
-    if ((int)InType == (int)DS3_Frpg2ReliableUdpMessageType::Type)                                        \
-    {                                                                                       \
-        return false;                                                                       \
-    }
-#define DEFINE_PUSH_MESSAGE(OpCode, Type, ProtobufClass)                                    /* Not required, gets caught by Push test above */
-#include "Server.DarkSouls3/Server/Streams/DS3_Frpg2ReliableUdpMessageTypes.inc"
-#undef DEFINE_PUSH_MESSAGE
-#undef DEFINE_MESSAGE
-#undef DEFINE_REQUEST_RESPONSE
-
-    return false;
+    return GetMessageTypeTable().ExpectsResponse(InType);
 }
 
 std::string DS3_Game::GetBossDiscordThumbnailUrl(uint32_t BaseBossId)
@@ -214,7 +160,7 @@ void DS3_Game::GetStatistics(GameService& Service, std::unordered_map<std::strin
     Stats["Live Ghosts"] = std::to_string(Ghosts->GetLiveCount());
 }
 
-void DS3_Game::SendManagementMessage(Frpg2ReliableUdpMessageStream& Stream, const std::string& TextMessage)
+void DS3_Game::SendManagementMessage(GameService& Service, const std::vector<std::shared_ptr<GameClient>>& Clients, const std::string& TextMessage)
 {
     DS3_Frpg2RequestMessage::ManagementTextMessage Message;
     Message.set_push_message_id(DS3_Frpg2RequestMessage::PushID_ManagementTextMessage);
@@ -232,5 +178,5 @@ void DS3_Game::SendManagementMessage(Frpg2ReliableUdpMessageStream& Stream, cons
     DateTime->set_seconds(0);
     DateTime->set_tzdiff(0);
 
-    Stream.Send(&Message);
+    Service.SendToClients(Clients, &Message);
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/BloodMessage/DS3_BloodMessageManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/GameService/GameService.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
@@ -31,8 +32,28 @@
 DS3_BloodMessageManager::DS3_BloodMessageManager(Server* InServerInstance, GameService* InGameServiceInstance)
     : ServerInstance(InServerInstance)
     , GameServiceInstance(InGameServiceInstance)
+    , ListCache(SerializeListEntry)
 {
     LiveCache.SetMaxEntriesPerArea(InServerInstance->GetConfig().BloodMessageMaxLivePoolEntriesPerArea);
+    ListCache.SetTimeout(InServerInstance->GetConfig().ListResponseCacheTime);
+}
+
+bool DS3_BloodMessageManager::SerializeListEntry(const BloodMessage& Value, std::vector<uint8_t>& Output)
+{
+    DS3_Frpg2RequestMessage::RequestGetBloodMessageListResponse Response;
+
+    DS3_Frpg2RequestMessage::BloodMessageData& Data = *Response.mutable_messages()->Add();
+    Data.set_player_id(Value.PlayerId);
+    Data.set_character_id(Value.CharacterId); 
+    Data.set_message_id(Value.MessageId);
+    Data.set_good(Value.RatingGood);
+    Data.set_message_data(Value.Data.data(), Value.Data.size());
+    Data.set_player_steam_id(Value.PlayerSteamId);
+    Data.set_online_area_id((uint32_t)Value.OnlineAreaId);
+    Data.set_poor(Value.RatingPoor);
+
+    Output.resize(Response.ByteSize());
+    return Response.SerializeToArray(Output.data(), (int)Output.size());
 }
 
 bool DS3_BloodMessageManager::Init()
@@ -65,6 +86,7 @@ bool DS3_BloodMessageManager::Init()
 
 void DS3_BloodMessageManager::Poll()
 {
+    ListCache.Poll();
 }
 
 void DS3_BloodMessageManager::TrimDatabase()
@@ -76,38 +98,15 @@ void DS3_BloodMessageManager::TrimDatabase()
     Database.TrimBloodMessages(MaxEntries);
 }
 
-MessageHandleResult DS3_BloodMessageManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS3_BloodMessageManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestReentryBloodMessage))
-    {
-        return Handle_RequestReentryBloodMessage(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestGetBloodMessageEvaluation))
-    {
-        return Handle_RequestGetBloodMessageEvaluation(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestCreateBloodMessage))
-    {
-        return Handle_RequestCreateBloodMessage(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestRemoveBloodMessage))
-    {
-        return Handle_RequestRemoveBloodMessage(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestGetBloodMessageList))
-    {
-        return Handle_RequestGetBloodMessageList(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestEvaluateBloodMessage))
-    {
-        return Handle_RequestEvaluateBloodMessage(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestReCreateBloodMessageList))
-    {
-        return Handle_RequestReCreateBloodMessageList(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestReentryBloodMessage, this, &DS3_BloodMessageManager::Handle_RequestReentryBloodMessage);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestGetBloodMessageEvaluation, this, &DS3_BloodMessageManager::Handle_RequestGetBloodMessageEvaluation);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestCreateBloodMessage, this, &DS3_BloodMessageManager::Handle_RequestCreateBloodMessage);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestRemoveBloodMessage, this, &DS3_BloodMessageManager::Handle_RequestRemoveBloodMessage);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestGetBloodMessageList, this, &DS3_BloodMessageManager::Handle_RequestGetBloodMessageList);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestEvaluateBloodMessage, this, &DS3_BloodMessageManager::Handle_RequestEvaluateBloodMessage);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestReCreateBloodMessageList, this, &DS3_BloodMessageManager::Handle_RequestReCreateBloodMessageList);
 }
 
 MessageHandleResult DS3_BloodMessageManager::Handle_RequestReentryBloodMessage(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
@@ -323,14 +322,21 @@ MessageHandleResult DS3_BloodMessageManager::Handle_RequestRemoveBloodMessage(Ga
 
     LogS(Client->GetName().c_str(), "Removing blood message %i.", Request->message_id());
 
-    if (Database.RemoveOwnBloodMessage(Player.GetPlayerId(), Request->message_id()))
-    {
-        LiveCache.Remove((DS3_OnlineAreaId)Request->online_area_id(), Request->message_id());
-    }
-    else
-    {
-        WarningS(Client->GetName().c_str(), "Failed to remove blood message.");
-    }
+    // With write-behind the result may not be known until a later poll, so don't capture the client.
+    DS3_OnlineAreaId AreaId = (DS3_OnlineAreaId)Request->online_area_id();
+    uint32_t MessageId = Request->message_id();
+    std::string ClientName = Client->GetName();
+    Database.RemoveOwnBloodMessage(Player.GetPlayerId(), MessageId, [this, AreaId, MessageId, ClientName](bool Removed) {
+        if (Removed)
+        {
+            LiveCache.Remove(AreaId, MessageId);
+            ListCache.InvalidateArea(AreaId);
+        }
+        else
+        {
+            WarningS(ClientName.c_str(), "Failed to remove blood message.");
+        }
+    });
 
     // Empty response, not sure what purpose this serves really other than saying message-recieved. Client
     // doesn't work without it though.
@@ -351,8 +357,10 @@ MessageHandleResult DS3_BloodMessageManager::Handle_RequestGetBloodMessageList(G
     PlayerState& Player = Client->GetPlayerState();
 
     DS3_Frpg2RequestMessage::RequestGetBloodMessageList* Request = (DS3_Frpg2RequestMessage::RequestGetBloodMessageList*)Message.Protobuf.get();
-    DS3_Frpg2RequestMessage::RequestGetBloodMessageListResponse Response;
-    Response.mutable_messages();
+
+    // The response (RequestGetBloodMessageListResponse) is built out of the already serialized and 
+    // compressed selections for each area, see ListResponseCache.
+    Frpg2PreparedPayloadList Response;
 
     int RemainingMessageCount = (int)Request->max_messages();
 
@@ -367,25 +375,20 @@ MessageHandleResult DS3_BloodMessageManager::Handle_RequestGetBloodMessageList(G
             uint32_t MaxForArea = Area.max_type_1() + Area.max_type_2(); // TODO: we need to figure out the difference between these two types.
             int GatherCount = std::min((int)MaxForArea, RemainingMessageCount);
 
-            std::vector<std::shared_ptr<BloodMessage>> AreaMessages = LiveCache.GetRandomSet(AreaId, GatherCount);
-            for (std::shared_ptr<BloodMessage>& AreaMsg : AreaMessages)
+            int EntryCount = 0;
+            std::shared_ptr<const Frpg2PreparedPayload> AreaMessages = ListCache.GetRandomSet(LiveCache, AreaId, GatherCount, EntryCount);
+            if (!AreaMessages)
             {
-                DS3_Frpg2RequestMessage::BloodMessageData& Data = *Response.mutable_messages()->Add();
-                Data.set_player_id(AreaMsg->PlayerId);
-                Data.set_character_id(AreaMsg->CharacterId); 
-                Data.set_message_id(AreaMsg->MessageId);
-                Data.set_good(AreaMsg->RatingGood);
-                Data.set_message_data(AreaMsg->Data.data(), AreaMsg->Data.size());
-                Data.set_player_steam_id(AreaMsg->PlayerSteamId);
-                Data.set_online_area_id((uint32_t)AreaMsg->OnlineAreaId);
-                Data.set_poor(AreaMsg->RatingPoor);
-
-                RemainingMessageCount--;
+                WarningS(Client->GetName().c_str(), "Failed to build blood message list for area %u.", (uint32_t)AreaId);
+                continue;
             }
+
+            Response.push_back(AreaMessages);
+            RemainingMessageCount -= EntryCount;
         }
     }
 
-    if (!Client->MessageStream->Send(&Response, &Message))
+    if (!Client->MessageStream->SendPrepared(Response, &Message))
     {
         WarningS(Client->GetName().c_str(), "Disconnecting client as failed to send RequestGetBloodMessageListResponse response.");
         return MessageHandleResult::Error;
@@ -438,6 +441,8 @@ MessageHandleResult DS3_BloodMessageManager::Handle_RequestEvaluateBloodMessage(
             ActiveMessage->RatingGood++;
         }
 
+        ListCache.Invalidate((DS3_OnlineAreaId)ActiveMessage->OnlineAreaId, ActiveMessage);
+
         if (!Database.SetBloodMessageEvaluation(Request->message_id(), ActiveMessage->RatingPoor, ActiveMessage->RatingGood))
         {
             WarningS(Client->GetName().c_str(), "Failed to update message evaluation for message id '%u'.", Request->message_id());
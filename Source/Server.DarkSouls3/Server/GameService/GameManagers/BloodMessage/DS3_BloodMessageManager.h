@@ -11,6 +11,7 @@
 
 #include "Server/GameService/GameManager.h"
 #include "Server/GameService/Utils/OnlineAreaPool.h"
+#include "Server/GameService/Utils/ListResponseCache.h"
 #include "Server/Database/DatabaseTypes.h"
 #include "Server.DarkSouls3/Server/GameService/Utils/DS3_GameIds.h"
 
@@ -31,7 +32,7 @@ public:
     virtual void Poll() override;
     virtual void TrimDatabase() override;
 
-    virtual MessageHandleResult OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message) override;
+    virtual void RegisterMessageHandlers(MessageDispatchTable& Table) override;
 
     virtual std::string GetName() override;
 
@@ -46,10 +47,13 @@ protected:
     MessageHandleResult Handle_RequestEvaluateBloodMessage(GameClient* Client, const Frpg2ReliableUdpMessage& Message);
     MessageHandleResult Handle_RequestReCreateBloodMessageList(GameClient* Client, const Frpg2ReliableUdpMessage& Message);
 
+    static bool SerializeListEntry(const BloodMessage& Value, std::vector<uint8_t>& Output);
+
 private:
     Server* ServerInstance;
     GameService* GameServiceInstance;
 
     OnlineAreaPool<DS3_OnlineAreaId, BloodMessage> LiveCache;
+    ListResponseCache<DS3_OnlineAreaId, BloodMessage> ListCache;
 
 };
\ No newline at end of file
@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/Bloodstain/DS3_BloodstainManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
 #include "Server/Streams/Frpg2ReliableUdpMessageStream.h"
@@ -25,8 +26,23 @@
 
 DS3_BloodstainManager::DS3_BloodstainManager(Server* InServerInstance)
     : ServerInstance(InServerInstance)
+    , ListCache(SerializeListEntry)
 {
     LiveCache.SetMaxEntriesPerArea(InServerInstance->GetConfig().BloodstainMaxLivePoolEntriesPerArea);
+    ListCache.SetTimeout(InServerInstance->GetConfig().ListResponseCacheTime);
+}
+
+bool DS3_BloodstainManager::SerializeListEntry(const Bloodstain& Value, std::vector<uint8_t>& Output)
+{
+    DS3_Frpg2RequestMessage::RequestGetBloodstainListResponse Response;
+
+    DS3_Frpg2RequestMessage::BloodstainInfo& Data = *Response.mutable_bloodstains()->Add();
+    Data.set_online_area_id((uint32_t)Value.OnlineAreaId);
+    Data.set_bloodstain_id((uint32_t)Value.BloodstainId);
+    Data.set_data(Value.Data.data(), Value.Data.size());
+
+    Output.resize(Response.ByteSize());
+    return Response.SerializeToArray(Output.data(), (int)Output.size());
 }
 
 bool DS3_BloodstainManager::Init()
@@ -57,6 +73,11 @@ bool DS3_BloodstainManager::Init()
     return true;
 }
 
+void DS3_BloodstainManager::Poll()
+{
+    ListCache.Poll();
+}
+
 void DS3_BloodstainManager::TrimDatabase()
 {
     ServerDatabase& Database = ServerInstance->GetDatabase();
@@ -66,22 +87,11 @@ void DS3_BloodstainManager::TrimDatabase()
     Database.TrimBloodStains(MaxEntries);
 }
 
-MessageHandleResult DS3_BloodstainManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS3_BloodstainManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestCreateBloodstain))
-    {
-        return Handle_RequestCreateBloodstain(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestGetBloodstainList))
-    {
-        return Handle_RequestGetBloodstainList(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestGetDeadingGhost))
-    {
-        return Handle_RequestGetDeadingGhost(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestCreateBloodstain, this, &DS3_BloodstainManager::Handle_RequestCreateBloodstain);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestGetBloodstainList, this, &DS3_BloodstainManager::Handle_RequestGetBloodstainList);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestGetDeadingGhost, this, &DS3_BloodstainManager::Handle_RequestGetDeadingGhost);
 }
 
 MessageHandleResult DS3_BloodstainManager::Handle_RequestCreateBloodstain(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
@@ -164,8 +174,10 @@ MessageHandleResult DS3_BloodstainManager::Handle_RequestGetBloodstainList(GameC
     PlayerState& Player = Client->GetPlayerState();
 
     DS3_Frpg2RequestMessage::RequestGetBloodstainList* Request = (DS3_Frpg2RequestMessage::RequestGetBloodstainList*)Message.Protobuf.get();
-    DS3_Frpg2RequestMessage::RequestGetBloodstainListResponse Response;
-    Response.mutable_bloodstains();
+
+    // The response (RequestGetBloodstainListResponse) is built out of the already serialized and 
+    // compressed selections for each area, see ListResponseCache.
+    Frpg2PreparedPayloadList Response;
 
     int RemainingStainCount = (int)Request->max_stains();
 
@@ -180,20 +192,20 @@ MessageHandleResult DS3_BloodstainManager::Handle_RequestGetBloodstainList(GameC
             int MaxForArea = (int)Area.max_items();
             int GatherCount = std::min(MaxForArea, RemainingStainCount);
 
-            std::vector<std::shared_ptr<Bloodstain>> AreaStains = LiveCache.GetRandomSet(AreaId, GatherCount);
-            for (std::shared_ptr<Bloodstain>& AreaMsg : AreaStains)
+            int EntryCount = 0;
+            std::shared_ptr<const Frpg2PreparedPayload> AreaStains = ListCache.GetRandomSet(LiveCache, AreaId, GatherCount, EntryCount);
+            if (!AreaStains)
             {
-                DS3_Frpg2RequestMessage::BloodstainInfo& Data = *Response.mutable_bloodstains()->Add();
-                Data.set_online_area_id((uint32_t)AreaMsg->OnlineAreaId);
-                Data.set_bloodstain_id((uint32_t)AreaMsg->BloodstainId);
-                Data.set_data(AreaMsg->Data.data(), AreaMsg->Data.size());
-            
-                RemainingStainCount--;
+                WarningS(Client->GetName().c_str(), "Failed to build bloodstain list for area %u.", (uint32_t)AreaId);
+                continue;
             }
+
+            Response.push_back(AreaStains);
+            RemainingStainCount -= EntryCount;
         }
     }
 
-    if (!Client->MessageStream->Send(&Response, &Message))
+    if (!Client->MessageStream->SendPrepared(Response, &Message))
     {
         WarningS(Client->GetName().c_str(), "Disconnecting client as failed to send RequestCreateBloodMessageResponse response.");
         return MessageHandleResult::Error;
@@ -11,6 +11,7 @@
 
 #include "Server/GameService/GameManager.h"
 #include "Server/GameService/Utils/OnlineAreaPool.h"
+#include "Server/GameService/Utils/ListResponseCache.h"
 #include "Server/Database/DatabaseTypes.h"
 #include "Server.DarkSouls3/Server/GameService/Utils/DS3_GameIds.h"
 
@@ -27,9 +28,10 @@ public:
     DS3_BloodstainManager(Server* InServerInstance);
 
     virtual bool Init() override;
+    virtual void Poll() override;
     virtual void TrimDatabase() override;
 
-    virtual MessageHandleResult OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message) override;
+    virtual void RegisterMessageHandlers(MessageDispatchTable& Table) override;
 
     virtual std::string GetName() override;
 
@@ -38,12 +40,15 @@ public:
 protected:
     MessageHandleResult Handle_RequestCreateBloodstain(GameClient* Client, const Frpg2ReliableUdpMessage& Message);
     MessageHandleResult Handle_RequestGetBloodstainList(GameClient* Client, const Frpg2ReliableUdpMessage& Message);
+
+    static bool SerializeListEntry(const Bloodstain& Value, std::vector<uint8_t>& Output);
     MessageHandleResult Handle_RequestGetDeadingGhost(GameClient* Client, const Frpg2ReliableUdpMessage& Message);
 
 private:
     Server* ServerInstance;
 
     OnlineAreaPool<DS3_OnlineAreaId, Bloodstain> LiveCache;
+    ListResponseCache<DS3_OnlineAreaId, Bloodstain> ListCache;
 
     uint32_t NextMemoryCacheStainId = std::numeric_limits<uint32_t>::max();
 
@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/Boot/DS3_BootManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/GameService/GameService.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
@@ -28,18 +29,10 @@ DS3_BootManager::DS3_BootManager(Server* InServerInstance)
 {
 }
 
-MessageHandleResult DS3_BootManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS3_BootManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestWaitForUserLogin))
-    {
-        return Handle_RequestWaitForUserLogin(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestGetAnnounceMessageList))
-    {
-        return Handle_RequestGetAnnounceMessageList(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestWaitForUserLogin, this, &DS3_BootManager::Handle_RequestWaitForUserLogin);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestGetAnnounceMessageList, this, &DS3_BootManager::Handle_RequestGetAnnounceMessageList);
 }
 
 MessageHandleResult DS3_BootManager::Handle_RequestWaitForUserLogin(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
@@ -8,11 +8,13 @@
  */
 
 #include "Server/GameService/GameManagers/BreakIn/DS3_BreakInManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/DS3_PlayerState.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/GameService/GameService.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
 #include "Server/Streams/Frpg2ReliableUdpMessageStream.h"
+#include "Server/Streams/Frpg2ProtobufPool.h"
 #include "Server/Streams/DS3_Frpg2ReliableUdpMessage.h"
 #include "Server/GameService/Utils/DS3_GameIds.h"
 
@@ -33,22 +35,11 @@ void DS3_BreakInManager::OnLostPlayer(GameClient* Client)
 {
 }
 
-MessageHandleResult DS3_BreakInManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS3_BreakInManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestGetBreakInTargetList))
-    {
-        return Handle_RequestGetBreakInTargetList(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestBreakInTarget))
-    {
-        return Handle_RequestBreakInTarget(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestRejectBreakInTarget))
-    {
-        return Handle_RequestRejectBreakInTarget(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestGetBreakInTargetList, this, &DS3_BreakInManager::Handle_RequestGetBreakInTargetList);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestBreakInTarget, this, &DS3_BreakInManager::Handle_RequestBreakInTarget);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestRejectBreakInTarget, this, &DS3_BreakInManager::Handle_RequestRejectBreakInTarget);
 }
 
 bool DS3_BreakInManager::CanMatchWith(const DS3_Frpg2RequestMessage::MatchingParameter& Request, const std::shared_ptr<GameClient>& Match)
@@ -142,21 +133,21 @@ MessageHandleResult DS3_BreakInManager::Handle_RequestGetBreakInTargetList(GameC
     }
 #endif
 
-    DS3_Frpg2RequestMessage::RequestGetBreakInTargetListResponse Response;
-    Response.set_map_id(Request->map_id());
-    Response.set_online_area_id(Request->online_area_id());
+    std::shared_ptr<DS3_Frpg2RequestMessage::RequestGetBreakInTargetListResponse> Response = Frpg2ProtobufPool<DS3_Frpg2RequestMessage::RequestGetBreakInTargetListResponse>::Acquire();
+    Response->set_map_id(Request->map_id());
+    Response->set_online_area_id(Request->online_area_id());
 
     int CountToSend = std::min((int)Request->max_targets(), (int)PotentialTargets.size());
     for (int i = 0; i < CountToSend; i++)
     {
         std::shared_ptr<GameClient> OtherClient = PotentialTargets[i];
 
-        DS3_Frpg2RequestMessage::BreakInTargetData* Data = Response.add_target_data();
+        DS3_Frpg2RequestMessage::BreakInTargetData* Data = Response->add_target_data();
         Data->set_player_id(OtherClient->GetPlayerState().GetPlayerId());
         Data->set_steam_id(OtherClient->GetPlayerState().GetSteamId());
     }
 
-    if (!Client->MessageStream->Send(&Response, &Message))
+    if (!Client->MessageStream->Send(Response.get(), &Message))
     {
         WarningS(Client->GetName().c_str(), "Disconnecting client as failed to send RequestGetBreakInTargetListResponse response.");
         return MessageHandleResult::Error;
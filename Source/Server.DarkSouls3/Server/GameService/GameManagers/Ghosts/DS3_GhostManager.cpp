@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/Ghosts/DS3_GhostManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
 #include "Server/Streams/Frpg2ReliableUdpMessageStream.h"
@@ -25,8 +26,23 @@
 
 DS3_GhostManager::DS3_GhostManager(Server* InServerInstance)
     : ServerInstance(InServerInstance)
+    , ListCache(SerializeListEntry)
 {
     LiveCache.SetMaxEntriesPerArea(InServerInstance->GetConfig().GhostMaxLivePoolEntriesPerArea);
+    ListCache.SetTimeout(InServerInstance->GetConfig().ListResponseCacheTime);
+}
+
+bool DS3_GhostManager::SerializeListEntry(const Ghost& Value, std::vector<uint8_t>& Output)
+{
+    DS3_Frpg2RequestMessage::RequestGetGhostDataListResponse Response;
+
+    DS3_Frpg2RequestMessage::GhostData& Data = *Response.mutable_ghosts()->Add();
+    Data.set_unknown_1(1);                                                      // TODO: Figure out what this is.
+    Data.set_ghost_id((uint32_t)Value.GhostId);
+    Data.set_data(Value.Data.data(), Value.Data.size());
+
+    Output.resize(Response.ByteSize());
+    return Response.SerializeToArray(Output.data(), (int)Output.size());
 }
 
 bool DS3_GhostManager::Init()
@@ -57,6 +73,11 @@ bool DS3_GhostManager::Init()
     return true;
 }
 
+void DS3_GhostManager::Poll()
+{
+    ListCache.Poll();
+}
+
 void DS3_GhostManager::TrimDatabase()
 {
     ServerDatabase& Database = ServerInstance->GetDatabase();
@@ -66,18 +87,10 @@ void DS3_GhostManager::TrimDatabase()
     Database.TrimGhosts(MaxEntries);
 }
 
-MessageHandleResult DS3_GhostManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS3_GhostManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestCreateGhostData))
-    {
-        return Handle_RequestCreateGhostData(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestGetGhostDataList))
-    {
-        return Handle_RequestGetGhostDataList(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestCreateGhostData, this, &DS3_GhostManager::Handle_RequestCreateGhostData);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestGetGhostDataList, this, &DS3_GhostManager::Handle_RequestGetGhostDataList);
 }
 
 MessageHandleResult DS3_GhostManager::Handle_RequestCreateGhostData(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
@@ -157,8 +170,10 @@ MessageHandleResult DS3_GhostManager::Handle_RequestGetGhostDataList(GameClient*
     PlayerState& Player = Client->GetPlayerState();
 
     DS3_Frpg2RequestMessage::RequestGetGhostDataList* Request = (DS3_Frpg2RequestMessage::RequestGetGhostDataList*)Message.Protobuf.get();
-    DS3_Frpg2RequestMessage::RequestGetGhostDataListResponse Response;
-    Response.mutable_ghosts();
+
+    // The response (RequestGetGhostDataListResponse) is built out of the already serialized and 
+    // compressed selections for each area, see ListResponseCache.
+    Frpg2PreparedPayloadList Response;
 
     uint32_t RemainingGhostCount = Request->max_ghosts();
 
@@ -173,20 +188,20 @@ MessageHandleResult DS3_GhostManager::Handle_RequestGetGhostDataList(GameClient*
             uint32_t MaxForArea = Area.max_items();
             uint32_t GatherCount = std::min(MaxForArea, RemainingGhostCount);
 
-            std::vector<std::shared_ptr<Ghost>> ActiveGhosts = LiveCache.GetRandomSet(AreaId, GatherCount);
-            for (std::shared_ptr<Ghost>& AreaMsg : ActiveGhosts)
+            int EntryCount = 0;
+            std::shared_ptr<const Frpg2PreparedPayload> ActiveGhosts = ListCache.GetRandomSet(LiveCache, AreaId, (int)GatherCount, EntryCount);
+            if (!ActiveGhosts)
             {
-                DS3_Frpg2RequestMessage::GhostData& Data = *Response.mutable_ghosts()->Add();
-                Data.set_unknown_1(1);                                                      // TODO: Figure out what this is.
-                Data.set_ghost_id((uint32_t)AreaMsg->GhostId);
-                Data.set_data(AreaMsg->Data.data(), AreaMsg->Data.size());
-
-                RemainingGhostCount--;
+                WarningS(Client->GetName().c_str(), "Failed to build ghost list for area %u.", (uint32_t)AreaId);
+                continue;
             }
+
+            Response.push_back(ActiveGhosts);
+            RemainingGhostCount -= (uint32_t)EntryCount;
         }
     }
 
-    if (!Client->MessageStream->Send(&Response, &Message))
+    if (!Client->MessageStream->SendPrepared(Response, &Message))
     {
         WarningS(Client->GetName().c_str(), "Disconnecting client as failed to send RequestGetGhostDataListResponse response.");
         return MessageHandleResult::Error;
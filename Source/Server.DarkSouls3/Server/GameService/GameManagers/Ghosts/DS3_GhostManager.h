@@ -11,6 +11,7 @@
 
 #include "Server/GameService/GameManager.h"
 #include "Server/GameService/Utils/OnlineAreaPool.h"
+#include "Server/GameService/Utils/ListResponseCache.h"
 #include "Server/Database/DatabaseTypes.h"
 #include "Server.DarkSouls3/Server/GameService/Utils/DS3_GameIds.h"
 
@@ -28,9 +29,10 @@ public:
     DS3_GhostManager(Server* InServerInstance);
 
     virtual bool Init() override;
+    virtual void Poll() override;
     virtual void TrimDatabase() override;
 
-    virtual MessageHandleResult OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message) override;
+    virtual void RegisterMessageHandlers(MessageDispatchTable& Table) override;
 
     virtual std::string GetName() override;
 
@@ -40,10 +42,13 @@ protected:
     MessageHandleResult Handle_RequestCreateGhostData(GameClient* Client, const Frpg2ReliableUdpMessage& Message);
     MessageHandleResult Handle_RequestGetGhostDataList(GameClient* Client, const Frpg2ReliableUdpMessage& Message);
 
+    static bool SerializeListEntry(const Ghost& Value, std::vector<uint8_t>& Output);
+
 private:
     Server* ServerInstance;
 
     OnlineAreaPool<DS3_OnlineAreaId, Ghost> LiveCache;
+    ListResponseCache<DS3_OnlineAreaId, Ghost> ListCache;
 
     uint32_t NextMemoryCacheGhostId = std::numeric_limits<uint32_t>::max();
 
@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/Logging/DS3_LoggingManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/GameService.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
@@ -28,54 +29,19 @@ DS3_LoggingManager::DS3_LoggingManager(Server* InServerInstance)
 {
 }
 
-MessageHandleResult DS3_LoggingManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS3_LoggingManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestNotifyProtoBufLog))
-    {
-        return Handle_RequestNotifyProtoBufLog(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestNotifyKillEnemy))
-    {
-        return Handle_RequestNotifyKillEnemy(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestNotifyDisconnectSession))
-    {
-        return Handle_RequestNotifyDisconnectSession(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestNotifyRegisterCharacter))
-    {
-        return Handle_RequestNotifyRegisterCharacter(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestNotifyDie))
-    {
-        return Handle_RequestNotifyDie(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestNotifyKillBoss))
-    {
-        return Handle_RequestNotifyKillBoss(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestNotifyJoinMultiplay))
-    {
-        return Handle_RequestNotifyJoinMultiplay(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestNotifyLeaveMultiplay))
-    {
-        return Handle_RequestNotifyLeaveMultiplay(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestNotifySummonSignResult))
-    {
-        return Handle_RequestNotifySummonSignResult(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestNotifyCreateSignResult))
-    {
-        return Handle_RequestNotifyCreateSignResult(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestNotifyBreakInResult))
-    {
-        return Handle_RequestNotifyBreakInResult(Client, Message);
-    }
-        
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestNotifyProtoBufLog, this, &DS3_LoggingManager::Handle_RequestNotifyProtoBufLog);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestNotifyKillEnemy, this, &DS3_LoggingManager::Handle_RequestNotifyKillEnemy);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestNotifyDisconnectSession, this, &DS3_LoggingManager::Handle_RequestNotifyDisconnectSession);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestNotifyRegisterCharacter, this, &DS3_LoggingManager::Handle_RequestNotifyRegisterCharacter);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestNotifyDie, this, &DS3_LoggingManager::Handle_RequestNotifyDie);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestNotifyKillBoss, this, &DS3_LoggingManager::Handle_RequestNotifyKillBoss);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestNotifyJoinMultiplay, this, &DS3_LoggingManager::Handle_RequestNotifyJoinMultiplay);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestNotifyLeaveMultiplay, this, &DS3_LoggingManager::Handle_RequestNotifyLeaveMultiplay);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestNotifySummonSignResult, this, &DS3_LoggingManager::Handle_RequestNotifySummonSignResult);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestNotifyCreateSignResult, this, &DS3_LoggingManager::Handle_RequestNotifyCreateSignResult);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestNotifyBreakInResult, this, &DS3_LoggingManager::Handle_RequestNotifyBreakInResult);
 }
 
 MessageHandleResult DS3_LoggingManager::Handle_RequestNotifyProtoBufLog(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/Mark/DS3_MarkManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
 #include "Server/Streams/Frpg2ReliableUdpMessageStream.h"
@@ -24,26 +25,12 @@ DS3_MarkManager::DS3_MarkManager(Server* InServerInstance)
 {
 }
 
-MessageHandleResult DS3_MarkManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS3_MarkManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestCreateMark))
-    {
-        return Handle_RequestCreateMark(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestRemoveMark))
-    {
-        return Handle_RequestRemoveMark(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestReentryMark))
-    {
-        return Handle_RequestReentryMark(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestGetMarkList))
-    {
-        return Handle_RequestGetMarkList(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestCreateMark, this, &DS3_MarkManager::Handle_RequestCreateMark);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestRemoveMark, this, &DS3_MarkManager::Handle_RequestRemoveMark);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestReentryMark, this, &DS3_MarkManager::Handle_RequestReentryMark);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestGetMarkList, this, &DS3_MarkManager::Handle_RequestGetMarkList);
 }
 
 MessageHandleResult DS3_MarkManager::Handle_RequestCreateMark(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/Misc/DS3_MiscManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/DS3_PlayerState.h"
 #include "Server/GameService/GameService.h"
 #include "Server/GameService/GameClient.h"
@@ -34,34 +35,14 @@ DS3_MiscManager::DS3_MiscManager(Server* InServerInstance, GameService* InGameSe
 {
 }
 
-MessageHandleResult DS3_MiscManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS3_MiscManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestNotifyRingBell))
-    {
-        return Handle_RequestNotifyRingBell(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestSendMessageToPlayers))
-    {
-        return Handle_RequestSendMessageToPlayers(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestMeasureUploadBandwidth))
-    {
-        return Handle_RequestMeasureUploadBandwidth(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestMeasureDownloadBandwidth))
-    {
-        return Handle_RequestMeasureDownloadBandwidth(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestGetOnlineShopItemList))
-    {
-        return Handle_RequestGetOnlineShopItemList(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestBenchmarkThroughput))
-    {
-        return Handle_RequestBenchmarkThroughput(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestNotifyRingBell, this, &DS3_MiscManager::Handle_RequestNotifyRingBell);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestSendMessageToPlayers, this, &DS3_MiscManager::Handle_RequestSendMessageToPlayers);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestMeasureUploadBandwidth, this, &DS3_MiscManager::Handle_RequestMeasureUploadBandwidth);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestMeasureDownloadBandwidth, this, &DS3_MiscManager::Handle_RequestMeasureDownloadBandwidth);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestGetOnlineShopItemList, this, &DS3_MiscManager::Handle_RequestGetOnlineShopItemList);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestBenchmarkThroughput, this, &DS3_MiscManager::Handle_RequestBenchmarkThroughput);
 }
 
 void DS3_MiscManager::Poll()
@@ -91,19 +72,13 @@ MessageHandleResult DS3_MiscManager::Handle_RequestNotifyRingBell(GameClient* Cl
         return NotifyLocations.count(OtherClient->GetPlayerStateType<DS3_PlayerState>().GetCurrentArea()) > 0;
     });
 
-    for (std::shared_ptr<GameClient>& OtherClient : PotentialTargets)
-    {
-        DS3_Frpg2RequestMessage::PushRequestNotifyRingBell PushMessage;
-        PushMessage.set_push_message_id(DS3_Frpg2RequestMessage::PushID_PushRequestNotifyRingBell);
-        PushMessage.set_player_id(Player.GetPlayerId());
-        PushMessage.set_online_area_id(Request->online_area_id());
-        PushMessage.set_data(Request->data().data(), Request->data().size());
+    DS3_Frpg2RequestMessage::PushRequestNotifyRingBell PushMessage;
+    PushMessage.set_push_message_id(DS3_Frpg2RequestMessage::PushID_PushRequestNotifyRingBell);
+    PushMessage.set_player_id(Player.GetPlayerId());
+    PushMessage.set_online_area_id(Request->online_area_id());
+    PushMessage.set_data(Request->data().data(), Request->data().size());
 
-        if (!OtherClient->MessageStream->Send(&PushMessage))
-        {
-            WarningS(Client->GetName().c_str(), "Failed to send push message for bell ring to player '%s'", OtherClient->GetName().c_str());
-        }
-    }
+    GameServiceInstance->SendToClients(PotentialTargets, &PushMessage);
 
     std::string TypeStatisticKey = StringFormat("Bell/TotalBellRings");
     Database.AddGlobalStatistic(TypeStatisticKey, 1);
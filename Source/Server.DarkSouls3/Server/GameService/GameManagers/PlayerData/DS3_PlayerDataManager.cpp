@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/PlayerData/DS3_PlayerDataManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/DS3_PlayerState.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
@@ -29,34 +30,14 @@ DS3_PlayerDataManager::DS3_PlayerDataManager(Server* InServerInstance)
 {
 }
 
-MessageHandleResult DS3_PlayerDataManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS3_PlayerDataManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestUpdateLoginPlayerCharacter))
-    {
-        return Handle_RequestUpdateLoginPlayerCharacter(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestUpdatePlayerStatus))
-    {
-        return Handle_RequestUpdatePlayerStatus(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestUpdatePlayerCharacter))
-    {
-        return Handle_RequestUpdatePlayerCharacter(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestGetPlayerCharacter))
-    {
-        return Handle_RequestGetPlayerCharacter(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestGetLoginPlayerCharacter))
-    {
-        return Handle_RequestGetLoginPlayerCharacter(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestGetPlayerCharacterList))
-    {
-        return Handle_RequestGetPlayerCharacterList(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestUpdateLoginPlayerCharacter, this, &DS3_PlayerDataManager::Handle_RequestUpdateLoginPlayerCharacter);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestUpdatePlayerStatus, this, &DS3_PlayerDataManager::Handle_RequestUpdatePlayerStatus);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestUpdatePlayerCharacter, this, &DS3_PlayerDataManager::Handle_RequestUpdatePlayerCharacter);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestGetPlayerCharacter, this, &DS3_PlayerDataManager::Handle_RequestGetPlayerCharacter);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestGetLoginPlayerCharacter, this, &DS3_PlayerDataManager::Handle_RequestGetLoginPlayerCharacter);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestGetPlayerCharacterList, this, &DS3_PlayerDataManager::Handle_RequestGetPlayerCharacterList);
 }
 
 MessageHandleResult DS3_PlayerDataManager::Handle_RequestUpdateLoginPlayerCharacter(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
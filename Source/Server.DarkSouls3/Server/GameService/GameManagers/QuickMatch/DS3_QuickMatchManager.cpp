@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/QuickMatch/DS3_QuickMatchManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/DS3_PlayerState.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/GameService/GameService.h"
@@ -54,46 +55,17 @@ void DS3_QuickMatchManager::Poll()
 {
 }
 
-MessageHandleResult DS3_QuickMatchManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS3_QuickMatchManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestSearchQuickMatch))
-    {
-        return Handle_RequestSearchQuickMatch(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestUnregisterQuickMatch))
-    {
-        return Handle_RequestUnregisterQuickMatch(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestUpdateQuickMatch))
-    {
-        return Handle_RequestUpdateQuickMatch(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestJoinQuickMatch))
-    {
-        return Handle_RequestJoinQuickMatch(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestAcceptQuickMatch))
-    {
-        return Handle_RequestAcceptQuickMatch(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestRejectQuickMatch))
-    {
-        return Handle_RequestRejectQuickMatch(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestRegisterQuickMatch))
-    {
-        return Handle_RequestRegisterQuickMatch(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestSendQuickMatchStart))
-    {
-        return Handle_RequestSendQuickMatchStart(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestSendQuickMatchResult))
-    {
-        return Handle_RequestSendQuickMatchResult(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestSearchQuickMatch, this, &DS3_QuickMatchManager::Handle_RequestSearchQuickMatch);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestUnregisterQuickMatch, this, &DS3_QuickMatchManager::Handle_RequestUnregisterQuickMatch);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestUpdateQuickMatch, this, &DS3_QuickMatchManager::Handle_RequestUpdateQuickMatch);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestJoinQuickMatch, this, &DS3_QuickMatchManager::Handle_RequestJoinQuickMatch);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestAcceptQuickMatch, this, &DS3_QuickMatchManager::Handle_RequestAcceptQuickMatch);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestRejectQuickMatch, this, &DS3_QuickMatchManager::Handle_RequestRejectQuickMatch);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestRegisterQuickMatch, this, &DS3_QuickMatchManager::Handle_RequestRegisterQuickMatch);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestSendQuickMatchStart, this, &DS3_QuickMatchManager::Handle_RequestSendQuickMatchStart);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestSendQuickMatchResult, this, &DS3_QuickMatchManager::Handle_RequestSendQuickMatchResult);
 }
 
 bool DS3_QuickMatchManager::CanMatchWith(GameClient* Client, const DS3_Frpg2RequestMessage::RequestSearchQuickMatch& Request, const std::shared_ptr<Match>& Match)
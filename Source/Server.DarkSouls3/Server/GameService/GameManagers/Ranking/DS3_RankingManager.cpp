@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/Ranking/DS3_RankingManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
 #include "Server/Streams/Frpg2ReliableUdpMessageStream.h"
@@ -25,26 +26,12 @@ DS3_RankingManager::DS3_RankingManager(Server* InServerInstance)
 {
 }
 
-MessageHandleResult DS3_RankingManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS3_RankingManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestRegisterRankingData))
-    {
-        return Handle_RequestRegisterRankingData(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestGetRankingData))
-    {
-        return Handle_RequestGetRankingData(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestGetCharacterRankingData))
-    {
-        return Handle_RequestGetCharacterRankingData(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestCountRankingData))
-    {
-        return Handle_RequestCountRankingData(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestRegisterRankingData, this, &DS3_RankingManager::Handle_RequestRegisterRankingData);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestGetRankingData, this, &DS3_RankingManager::Handle_RequestGetRankingData);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestGetCharacterRankingData, this, &DS3_RankingManager::Handle_RequestGetCharacterRankingData);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestCountRankingData, this, &DS3_RankingManager::Handle_RequestCountRankingData);
 }
 
 MessageHandleResult DS3_RankingManager::Handle_RequestRegisterRankingData(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
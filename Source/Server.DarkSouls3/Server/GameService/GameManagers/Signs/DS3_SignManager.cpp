@@ -8,12 +8,14 @@
  */
 
 #include "Server/GameService/GameManagers/Signs/DS3_SignManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/DS3_PlayerState.h"
 #include "Server/GameService/Utils/DS3_GameIds.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/GameService/GameService.h"
 #include "Server/Streams/Frpg2ReliableUdpMessage.h"
 #include "Server/Streams/Frpg2ReliableUdpMessageStream.h"
+#include "Server/Streams/Frpg2ProtobufPool.h"
 #include "Server/Streams/DS3_Frpg2ReliableUdpMessage.h"
 #include "Server.DarkSouls3/Protobuf/DS3_Protobufs.h"
 
@@ -52,22 +54,22 @@ void DS3_SignManager::RemoveSignAndNotifyAware(const std::shared_ptr<SummonSign>
     LiveCache.Remove((DS3_OnlineAreaId)Sign->OnlineAreaId, Sign->SignId);
 
     // Tell anyone who is aware of this sign that its been removed.
+    std::vector<std::shared_ptr<GameClient>> AwareClients;
     for (uint32_t AwarePlayerId : Sign->AwarePlayerIds)
     {
         if (std::shared_ptr<GameClient> OtherClient = GameServiceInstance->FindClientByPlayerId(AwarePlayerId))
         {
-            DS3_Frpg2RequestMessage::PushRequestRemoveSign PushMessage;
-            PushMessage.set_push_message_id(DS3_Frpg2RequestMessage::PushID_PushRequestRemoveSign);
-            PushMessage.mutable_message()->set_player_id(Sign->PlayerId);
-            PushMessage.mutable_message()->set_sign_id(Sign->SignId);
-
-            if (!OtherClient->MessageStream->Send(&PushMessage))
-            {
-                WarningS(OtherClient->GetName().c_str(), "Failed to send PushRequestRemoveSign to aware player.");
-            }
+            AwareClients.push_back(OtherClient);
         }
     }
 
+    DS3_Frpg2RequestMessage::PushRequestRemoveSign PushMessage;
+    PushMessage.set_push_message_id(DS3_Frpg2RequestMessage::PushID_PushRequestRemoveSign);
+    PushMessage.mutable_message()->set_player_id(Sign->PlayerId);
+    PushMessage.mutable_message()->set_sign_id(Sign->SignId);
+
+    GameServiceInstance->SendToClients(AwareClients, &PushMessage);
+
     Sign->BeingSummonedByPlayerId = 0;
     Sign->AwarePlayerIds.clear();
 }
@@ -76,38 +78,15 @@ void DS3_SignManager::Poll()
 {
 }
 
-MessageHandleResult DS3_SignManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS3_SignManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestGetSignList))
-    {
-        return Handle_RequestGetSignList(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestCreateSign))
-    {
-        return Handle_RequestCreateSign(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestRemoveSign))
-    {
-        return Handle_RequestRemoveSign(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestUpdateSign))
-    {
-        return Handle_RequestUpdateSign(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestSummonSign))
-    {
-        return Handle_RequestSummonSign(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestRejectSign))
-    {
-        return Handle_RequestRejectSign(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestGetRightMatchingArea))
-    {
-        return Handle_RequestGetRightMatchingArea(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestGetSignList, this, &DS3_SignManager::Handle_RequestGetSignList);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestCreateSign, this, &DS3_SignManager::Handle_RequestCreateSign);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestRemoveSign, this, &DS3_SignManager::Handle_RequestRemoveSign);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestUpdateSign, this, &DS3_SignManager::Handle_RequestUpdateSign);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestSummonSign, this, &DS3_SignManager::Handle_RequestSummonSign);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestRejectSign, this, &DS3_SignManager::Handle_RequestRejectSign);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestGetRightMatchingArea, this, &DS3_SignManager::Handle_RequestGetRightMatchingArea);
 }
 
 bool DS3_SignManager::CanMatchWith(const DS3_Frpg2RequestMessage::MatchingParameter& Host, const DS3_Frpg2RequestMessage::MatchingParameter& Match, uint32_t SignType)
@@ -145,7 +124,7 @@ MessageHandleResult DS3_SignManager::Handle_RequestGetSignList(GameClient* Clien
     PlayerState& Player = Client->GetPlayerState();
 
     DS3_Frpg2RequestMessage::RequestGetSignList* Request = (DS3_Frpg2RequestMessage::RequestGetSignList*)Message.Protobuf.get();
-    DS3_Frpg2RequestMessage::RequestGetSignListResponse Response;
+    std::shared_ptr<DS3_Frpg2RequestMessage::RequestGetSignListResponse> Response = Frpg2ProtobufPool<DS3_Frpg2RequestMessage::RequestGetSignListResponse>::Acquire();
 
 #ifdef _DEBUG
     static DiffTracker Tracker;
@@ -167,7 +146,7 @@ MessageHandleResult DS3_SignManager::Handle_RequestGetSignList(GameClient* Clien
 
     uint32_t RemainingSignCount = Request->max_signs();
 
-    DS3_Frpg2RequestMessage::GetSignResult* SignResult = Response.mutable_get_sign_result();
+    DS3_Frpg2RequestMessage::GetSignResult* SignResult = Response->mutable_get_sign_result();
 
     // Grab as many recent signs as we can from the cache that match our matching criteria.
     for (int i = 0; i < Request->search_areas_size() && RemainingSignCount > 0; i++)
@@ -221,7 +200,7 @@ MessageHandleResult DS3_SignManager::Handle_RequestGetSignList(GameClient* Clien
         }
     }
 
-    if (!Client->MessageStream->Send(&Response, &Message))
+    if (!Client->MessageStream->Send(Response.get(), &Message))
     {
         WarningS(Client->GetName().c_str(), "Disconnecting client as failed to send RequestGetSignListResponse response.");
         return MessageHandleResult::Error;
@@ -8,6 +8,7 @@
  */
 
 #include "Server/GameService/GameManagers/Visitor/DS3_VisitorManager.h"
+#include "Server/GameService/MessageDispatchTable.h"
 #include "Server/GameService/DS3_PlayerState.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/GameService/GameService.h"
@@ -30,22 +31,11 @@ DS3_VisitorManager::DS3_VisitorManager(Server* InServerInstance, GameService* In
 {
 }
 
-MessageHandleResult DS3_VisitorManager::OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+void DS3_VisitorManager::RegisterMessageHandlers(MessageDispatchTable& Table)
 {
-    if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestGetVisitorList))
-    {
-        return Handle_RequestGetVisitorList(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestVisit))
-    {
-        return Handle_RequestVisit(Client, Message);
-    }
-    else if (Message.Header.IsType(DS3_Frpg2ReliableUdpMessageType::RequestRejectVisit))
-    {
-        return Handle_RequestRejectVisit(Client, Message);
-    }
-
-    return MessageHandleResult::Unhandled;
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestGetVisitorList, this, &DS3_VisitorManager::Handle_RequestGetVisitorList);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestVisit, this, &DS3_VisitorManager::Handle_RequestVisit);
+    Table.Register(DS3_Frpg2ReliableUdpMessageType::RequestRejectVisit, this, &DS3_VisitorManager::Handle_RequestRejectVisit);
 }
 
 bool DS3_VisitorManager::CanMatchWith(const DS3_Frpg2RequestMessage::MatchingParameter& Request, const std::shared_ptr<GameClient>& Match)
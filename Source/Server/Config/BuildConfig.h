@@ -64,6 +64,23 @@ public:
     // Version to give to the master-server when trying to advertise, used to hard-cut-off older server versions from advertising.
     inline static const int MASTER_SERVER_CLIENT_VERSION = 2;
 
+    // Longest time the server manager will sleep waiting for events before polling
+    // all servers regardless. Anything time based that doesn't schedule its own wake up
+    // on the event loop (timeouts, database trims, etc) relies on this.
+    inline static const double SERVER_MANAGER_MAX_WAIT_TIME = 0.05;
+
+    // Number of network IO threads shared between all servers (see NetReactor). 0 
+    // creates one per hardware thread.
+    inline static const int NETWORK_THREAD_COUNT = 0;
+
+    // Number of worker threads shared between all servers for decrypting, decompressing and
+    // parsing incoming game packets (see WorkerPool). 0 creates one per hardware thread.
+    inline static const int WORKER_THREAD_COUNT = 0;
+
+    // Number of worker threads the webui of sharded servers use. The default server
+    // uses more as its the one that normally gets used.
+    inline static const int WEBUI_SHARD_THREAD_COUNT = 1;
+
     // How many seconds without activity before a sharded server is cleaned up.
     inline static const double SERVER_TIMEOUT = 60.0 * 60.0f;
 
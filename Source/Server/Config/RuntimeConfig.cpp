@@ -291,11 +291,26 @@ bool RuntimeConfig::Serialize(nlohmann::json& Json, bool Loading)
     SERIALIZE_VAR(AuthServerPort);
     SERIALIZE_VAR(GameServerPort);
     SERIALIZE_VAR(StartGameServerPortRange);
+    SERIALIZE_VAR(GameServerBatchedIO);
+    SERIALIZE_VAR(GameServerBatchSize);
+    SERIALIZE_VAR(GameServerShardCount);
+    SERIALIZE_VAR(GameServerAckDelay);
+    SERIALIZE_VAR(GameServerParallelIngress);
+    SERIALIZE_VAR(ListResponseCacheTime);
     SERIALIZE_VAR(WebUIServerPort);
     SERIALIZE_VAR(WebUIServerUsername);
     SERIALIZE_VAR(WebUIServerPassword);
     SERIALIZE_VAR(Announcements);
     SERIALIZE_VAR(DatabaseTrimInterval);
+    SERIALIZE_VAR(DatabaseWriteBehind);
+    SERIALIZE_VAR(DatabaseCommitInterval);
+    SERIALIZE_VAR(DatabaseCommitMaxOperations);
+    SERIALIZE_VAR(DatabaseJournalMode);
+    SERIALIZE_VAR(DatabaseSynchronous);
+    SERIALIZE_VAR(DatabaseTempStore);
+    SERIALIZE_VAR(DatabaseCacheSizeKb);
+    SERIALIZE_VAR(DatabaseMmapSizeMb);
+    SERIALIZE_VAR(DatabaseCheckpointInterval);
     SERIALIZE_VAR(BloodMessageMaxLivePoolEntriesPerArea);
     SERIALIZE_VAR(BloodMessageMaxDatabaseEntries);
     SERIALIZE_VAR(BloodMessagePrimeCountPerArea);
@@ -209,6 +209,35 @@ public:
     // Start of the game server port range when hosting multiple servers.
     int StartGameServerPortRange = 50060;
 
+    // If true the game server recieves and sends datagrams in batches (recvmmsg/sendmmsg) rather
+    // than one syscall per datagram. Only supported on linux, ignored on other platforms.
+    bool GameServerBatchedIO = true;
+
+    // Maximum number of datagrams recieved or sent per syscall when GameServerBatchedIO is enabled.
+    int GameServerBatchSize = 64;
+
+    // Number of sockets the game server port is opened with. When greater than 1 each socket is
+    // bound with SO_REUSEPORT and has its own recieve/send threads, recieve queue and set of client
+    // connections. The kernel hashes clients between them by source address so a client always stays
+    // on the same shard. 0 uses one shard per hardware thread. Only supported on linux.
+    int GameServerShardCount = 1;
+
+    // How long (in seconds) we can hold off acknowledging packets recieved from game clients. Acks are 
+    // piggybacked onto any data packet we send within this time, otherwise a single cumulative 
+    // ack is sent once it elapses. 0 acknowledges every packet immediately, which is what the game 
+    // client's retransmit timing expects, so only raise this after testing with real clients.
+    double GameServerAckDelay = 0.0;
+
+    // If true each game client's incoming packets are decrypted, decompressed and parsed on the
+    // shared worker threads, so the main thread only has to deal with fully decoded messages. 
+    // Messages are still handled in the order they were recieved.
+    bool GameServerParallelIngress = true;
+
+    // How long (in seconds) the serialized and compressed responses to blood message, bloodstain and
+    // ghost list requests are reused for each area. Clients in the same area during this time all get
+    // the same selection. 0 builds a new response for every request.
+    double ListResponseCacheTime = 1.0;
+
     // Username to login into web-ui with.
     std::string WebUIServerUsername = "";
 
@@ -223,6 +252,38 @@ public:
     // How often (in seconds) between each database trim.
     double DatabaseTrimInterval = 60 * 60 * 8;
 
+    // If true writes that nothing needs to wait on (statistics, new blood messages, character updates, etc)
+    // are queued and written on a dedicated thread in batches, rather than one at a time on the main thread.
+    // Reads may not see queued writes until they are committed, and anything still queued is lost if the 
+    // server crashes.
+    bool DatabaseWriteBehind = false;
+
+    // Maximum time (in seconds) a queued database write waits before its batch is committed.
+    double DatabaseCommitInterval = 0.5;
+
+    // Number of queued database writes that causes a batch to be committed without waiting.
+    int DatabaseCommitMaxOperations = 256;
+
+    // Sqlite journal mode of the database. WAL lets reads carry on while writes are being committed.
+    std::string DatabaseJournalMode = "WAL";
+
+    // Sqlite synchronous level. NORMAL is safe from corruption in WAL mode, but the most recent 
+    // commits can be lost if the machine loses power.
+    std::string DatabaseSynchronous = "NORMAL";
+
+    // Where sqlite stores temporary tables and indices.
+    std::string DatabaseTempStore = "MEMORY";
+
+    // Size (in kilobytes) of the page cache of each database connection.
+    int DatabaseCacheSizeKb = 64 * 1024;
+
+    // Maximum size (in megabytes) of the database file that is memory mapped, 0 disables memory mapping.
+    int DatabaseMmapSizeMb = 256;
+
+    // How often (in seconds) the WAL is checkpointed into the database on a background thread. 0 leaves
+    // checkpointing to sqlite, which does it as part of whatever commit the log grows too large on.
+    double DatabaseCheckpointInterval = 30.0;
+
     // Maximum number of blood messages to store per area in the cache.
     // If greater than this value are added, the oldest will be removed.
     int BloodMessageMaxLivePoolEntriesPerArea = 50;
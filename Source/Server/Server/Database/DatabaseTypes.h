@@ -12,6 +12,7 @@
 #include <Protobuf/SharedProtobufs.h>
 
 #include <unordered_set>
+#include <memory>
 
 // Blood message stored in the database or live cache.
 struct BloodMessage
@@ -0,0 +1,91 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#include "Server/Database/RankingBoard.h"
+
+void RankingBoard::Add(std::shared_ptr<Ranking> Entry)
+{
+    uint64_t CharacterKey = GetCharacterKey(Entry->PlayerId, Entry->CharacterId);
+
+    if (auto Iter = EntriesByCharacter.find(CharacterKey); Iter != EntriesByCharacter.end())
+    {
+        Remove(Iter->second);
+    }
+
+    if (size_t* ScoreCount = Scores.Find(Entry->Score))
+    {
+        (*ScoreCount)++;
+    }
+    else
+    {
+        Scores.Insert(Entry->Score, 1);
+    }
+
+    Entries.Insert({ Entry->Score, Entry->Id }, Entry);
+    EntriesByCharacter[CharacterKey] = std::move(Entry);
+}
+
+void RankingBoard::Remove(const std::shared_ptr<Ranking>& Entry)
+{
+    if (size_t* ScoreCount = Scores.Find(Entry->Score))
+    {
+        if (--(*ScoreCount) == 0)
+        {
+            Scores.Erase(Entry->Score);
+        }
+    }
+
+    Entries.Erase({ Entry->Score, Entry->Id });
+
+    // Done last as Entry may be the reference held in here.
+    EntriesByCharacter.erase(GetCharacterKey(Entry->PlayerId, Entry->CharacterId));
+}
+
+std::shared_ptr<Ranking> RankingBoard::Find(uint32_t PlayerId, uint32_t CharacterId)
+{
+    auto Iter = EntriesByCharacter.find(GetCharacterKey(PlayerId, CharacterId));
+    if (Iter == EntriesByCharacter.end())
+    {
+        return nullptr;
+    }
+
+    const Ranking& Entry = *Iter->second;
+    return MakeResult(Entry, Entries.CountBefore({ Entry.Score, Entry.Id }));
+}
+
+std::vector<std::shared_ptr<Ranking>> RankingBoard::GetRange(size_t Offset, size_t Count)
+{
+    std::vector<std::shared_ptr<Ranking>> Result;
+
+    for (size_t Position = Offset; Position < Offset + Count; Position++)
+    {
+        std::shared_ptr<Ranking>* Entry = Entries.At(Position);
+        if (Entry == nullptr)
+        {
+            break;
+        }
+
+        Result.push_back(MakeResult(**Entry, Position));
+    }
+
+    return Result;
+}
+
+size_t RankingBoard::GetCount()
+{
+    return Entries.Size();
+}
+
+std::shared_ptr<Ranking> RankingBoard::MakeResult(const Ranking& Entry, size_t Position)
+{
+    std::shared_ptr<Ranking> Result = std::make_shared<Ranking>(Entry);
+    Result->Rank = (uint32_t)Scores.CountBefore(Entry.Score) + 1;
+    Result->SerialRank = (uint32_t)Position + 1;
+    return Result;
+}
@@ -0,0 +1,79 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "Server/Database/DatabaseTypes.h"
+
+#include "Shared/Core/Utils/OrderStatisticTree.h"
+
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+// In-memory copy of a single leaderboard, so ranks can be worked out in O(log N) rather than
+// by re-sorting and rewriting the whole board whenever a score is registered.
+//
+// Entries are ordered by score (highest first), then by id so scores registered earlier
+// come first. Rank is shared by entries with the same score, with the next lower score 
+// getting the next rank (1, 1, 2, ...). SerialRank is just the position on the board (1, 2, 3, ...).
+
+class RankingBoard
+{
+public:
+
+    // Adds a score to the board, replacing any previous score from the same character.
+    void Add(std::shared_ptr<Ranking> Entry);
+
+    // Gets the score of the given character, or nullptr if they don't have one.
+    std::shared_ptr<Ranking> Find(uint32_t PlayerId, uint32_t CharacterId);
+
+    // Gets up to Count entries starting at the given 0-based position.
+    std::vector<std::shared_ptr<Ranking>> GetRange(size_t Offset, size_t Count);
+
+    size_t GetCount();
+
+private:
+
+    void Remove(const std::shared_ptr<Ranking>& Entry);
+
+    // Returns a copy of the entry with its current Rank and SerialRank filled in.
+    std::shared_ptr<Ranking> MakeResult(const Ranking& Entry, size_t Position);
+
+    struct EntryKey
+    {
+        uint32_t Score;
+        uint32_t Id;
+    };
+
+    struct EntryOrder
+    {
+        bool operator()(const EntryKey& A, const EntryKey& B) const
+        {
+            if (A.Score != B.Score)
+            {
+                return A.Score > B.Score;
+            }
+            return A.Id < B.Id;
+        }
+    };
+
+    static uint64_t GetCharacterKey(uint32_t PlayerId, uint32_t CharacterId)
+    {
+        return ((uint64_t)PlayerId << 32) | CharacterId;
+    }
+
+    OrderStatisticTree<EntryKey, std::shared_ptr<Ranking>, EntryOrder> Entries;
+
+    // Each distinct score on the board, highest first, along with how many entries have it.
+    OrderStatisticTree<uint32_t, size_t, std::greater<uint32_t>> Scores;
+
+    std::unordered_map<uint64_t, std::shared_ptr<Ranking>> EntriesByCharacter;
+
+};
@@ -11,8 +11,20 @@
 #include "Config/BuildConfig.h"
 #include "Shared/Core/Utils/Logging.h"
 #include "Shared/Core/Utils/DebugObjects.h"
+#include "Shared/Core/Network/NetEventLoop.h"
 #include "ThirdParty/sqlite/sqlite3.h"
 
+#include <optional>
+#include <algorithm>
+
+namespace
+{
+    bool IsWalMode(const DatabaseSettings& Settings)
+    {
+        return sqlite3_stricmp(Settings.JournalMode.c_str(), "WAL") == 0;
+    }
+}
+
 ServerDatabase::ServerDatabase()
 {
 }
@@ -21,11 +33,10 @@ ServerDatabase::~ServerDatabase()
 {
 }
 
-bool ServerDatabase::Open(const std::filesystem::path& path)
+bool ServerDatabase::Open(const std::filesystem::path& path, const DatabaseSettings& Settings)
 {
-    if (int result = sqlite3_open(path.string().c_str(), &db_handle); result != SQLITE_OK)
+    if (!OpenConnection(path, Settings, false))
     {
-        Error("sqlite_open failed with error: %s", sqlite3_errmsg(db_handle));
         return false;
     }
 
@@ -37,15 +48,192 @@ bool ServerDatabase::Open(const std::filesystem::path& path)
         return false;
     }
 
+    if (!MigrateSchema())
+    {
+        Log("Failed to migrate database schema.");
+        return false;
+    }
+
     Trim();
 
+    if (!LoadRankings())
+    {
+        Log("Failed to load rankings.");
+        return false;
+    }
+
+    if (Settings.WriteBehind)
+    {
+        WriteConnection = std::make_unique<ServerDatabase>();
+        WriteConnection->TrackStatistics = false;
+
+        if (!WriteConnection->OpenConnection(path, Settings, false))
+        {
+            Error("Failed to open write connection to database.");
+            return false;
+        }
+
+        NextBloodMessageId = GetNextRowId("BloodMessages", "MessageId");
+        NextBloodstainId = GetNextRowId("Bloodstains", "BloodstainId");
+        NextGhostId = GetNextRowId("Ghosts", "GhostId");
+        NextRankingId = GetNextRowId("Rankings", "ScoreId");
+
+        WriteBehind = true;
+        CommitInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(Settings.CommitInterval));
+        CommitMaxOperations = std::max<size_t>(Settings.CommitMaxOperations, 1);
+        WriteThreadQuit = false;
+
+        WriteThread = std::thread([this]() {
+            WriteThreadEntry();
+        });
+    }
+
+    if (IsWalMode(Settings) && Settings.CheckpointInterval > 0.0)
+    {
+        if (int result = sqlite3_open_v2(path.string().c_str(), &CheckpointHandle, SQLITE_OPEN_READWRITE, nullptr); result != SQLITE_OK)
+        {
+            Error("sqlite_open failed with error: %s", sqlite3_errmsg(CheckpointHandle));
+            return false;
+        }
+
+        CheckpointInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(Settings.CheckpointInterval));
+        CheckpointThreadQuit = false;
+
+        CheckpointThread = std::thread([this]() {
+            CheckpointThreadEntry();
+        });
+    }
+
+    return true;
+}
+
+bool ServerDatabase::OpenReadOnly(const std::filesystem::path& path, const DatabaseSettings& Settings)
+{
+    // Can be used from any thread, so has to stay away from the debug statistics.
+    TrackStatistics = false;
+
+    return OpenConnection(path, Settings, true);
+}
+
+bool ServerDatabase::OpenConnection(const std::filesystem::path& path, const DatabaseSettings& Settings, bool ReadOnly)
+{
+    int Flags = ReadOnly ? SQLITE_OPEN_READONLY : (SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    if (int result = sqlite3_open_v2(path.string().c_str(), &db_handle, Flags, nullptr); result != SQLITE_OK)
+    {
+        Error("sqlite_open failed with error: %s", sqlite3_errmsg(db_handle));
+        return false;
+    }
+
+    // Connections contend for the same locks, wait for the others to finish rather than failing straight away.
+    sqlite3_busy_timeout(db_handle, k_busy_timeout_ms);
+
+    // The journal mode is stored in the database file, so only needs setting by a connection that can write.
+    if (!ReadOnly && !Settings.JournalMode.empty())
+    {
+        std::string JournalMode;
+        RunStatement("PRAGMA journal_mode = " + Settings.JournalMode, {}, [&JournalMode](sqlite3_stmt* statement) {
+            JournalMode = (const char*)sqlite3_column_text(statement, 0);
+        });
+
+        if (sqlite3_stricmp(JournalMode.c_str(), Settings.JournalMode.c_str()) != 0)
+        {
+            Warning("Failed to set database journal mode to '%s', using '%s'.", Settings.JournalMode.c_str(), JournalMode.c_str());
+        }
+    }
+
+    // Everything else is per-connection.
+    if ((!Settings.Synchronous.empty() && !Execute("PRAGMA synchronous = " + Settings.Synchronous)) ||
+        (!Settings.TempStore.empty() && !Execute("PRAGMA temp_store = " + Settings.TempStore)) ||
+        // Negative cache sizes are in kibibytes rather than pages.
+        (Settings.CacheSizeKb > 0 && !Execute("PRAGMA cache_size = -" + std::to_string(Settings.CacheSizeKb))) ||
+        (Settings.MmapSizeMb > 0 && !Execute("PRAGMA mmap_size = " + std::to_string((int64_t)Settings.MmapSizeMb * 1024 * 1024))))
+    {
+        return false;
+    }
+
+    // Leave checkpointing to the checkpoint thread, otherwise whichever connection commits when the log
+    // hits the threshold does it, which is generally the main thread.
+    if (!ReadOnly && IsWalMode(Settings) && Settings.CheckpointInterval > 0.0)
+    {
+        sqlite3_wal_autocheckpoint(db_handle, 0);
+    }
+
     return true;
 }
 
+bool ServerDatabase::Execute(const std::string& Sql)
+{
+    char* errorMessage = nullptr;
+    if (int result = sqlite3_exec(db_handle, Sql.c_str(), nullptr, 0, &errorMessage); result != SQLITE_OK)
+    {
+        Error("Failed to run '%s' with error: %s", Sql.c_str(), errorMessage);
+        sqlite3_free(errorMessage);
+        return false;
+    }
+
+    return true;
+}
+
+void ServerDatabase::CheckpointThreadEntry()
+{
+    std::unique_lock lock(CheckpointMutex);
+
+    while (!CheckpointThreadQuit)
+    {
+        CheckpointCvar.wait_for(lock, CheckpointInterval, [this]() { return CheckpointThreadQuit; });
+        lock.unlock();
+
+        // Passive checkpoints never wait on other connections, anything they can't get to is picked up next time.
+        int LogFrames = 0;
+        int CheckpointedFrames = 0;
+        if (int result = sqlite3_wal_checkpoint_v2(CheckpointHandle, nullptr, SQLITE_CHECKPOINT_PASSIVE, &LogFrames, &CheckpointedFrames); result != SQLITE_OK && result != SQLITE_BUSY)
+        {
+            Warning("Database checkpoint failed with error: %s", sqlite3_errstr(result));
+        }
+
+        lock.lock();
+    }
+}
+
 bool ServerDatabase::Close()
 {
+    if (WriteThread.joinable())
+    {
+        {
+            std::scoped_lock lock(WriteMutex);
+            WriteThreadQuit = true;
+        }
+        WriteCvar.notify_all();
+
+        // Anything still queued is committed before the thread exits.
+        WriteThread.join();
+
+        WriteConnection->Close();
+        WriteConnection = nullptr;
+
+        Poll();
+
+        WriteBehind = false;
+    }
+
+    if (CheckpointThread.joinable())
+    {
+        {
+            std::scoped_lock lock(CheckpointMutex);
+            CheckpointThreadQuit = true;
+        }
+        CheckpointCvar.notify_all();
+        CheckpointThread.join();
+
+        sqlite3_close(CheckpointHandle);
+        CheckpointHandle = nullptr;
+    }
+
     if (db_handle)
     {
+        // Close fails if there are any statements left unfinalized.
+        FinalizeStatements();
+
         sqlite3_close(db_handle);
         db_handle = nullptr;
     }
@@ -182,85 +370,257 @@ bool ServerDatabase::CreateTables()
     return true;
 }
 
-bool ServerDatabase::RunStatement(const std::string& sql, const std::vector<DatabaseValue>& Values, RowCallback Callback)
+namespace 
 {
-    DebugTimerScope Scope(Debug::DatabaseQueryTime);
-    Debug::DatabaseQueries.Add(1.0f);
+    struct SchemaMigrationStep
+    {
+        const char* Description;
+        const char* Sql;
+
+        // If set, a query that returns a row for each value that would stop Sql from running (eg. duplicates
+        // when adding a unique index). If it returns anything the rows are logged and FallbackSql is run 
+        // instead, existing data is never modified to make a step succeed.
+        const char* ConflictCheck = nullptr;
+        const char* FallbackSql = nullptr;
+    };
+
+    // Each entry moves the schema up one version, the version a database is at is stored in its
+    // user_version pragma. Migrations are only ever appended to, never modified once released, as
+    // existing databases will already have run them.
+    const std::vector<std::vector<SchemaMigrationStep>> k_schema_migrations = {
+        // Version 1: Indexes for the lookups done at runtime, which were all full table scans.
+        {
+            { "Indexing players by steam id",               "CREATE UNIQUE INDEX IF NOT EXISTS Players_PlayerSteamId ON Players(PlayerSteamId)",
+                                                            "SELECT PlayerSteamId, COUNT(*) FROM Players GROUP BY PlayerSteamId HAVING COUNT(*) > 1",
+                                                            "CREATE INDEX IF NOT EXISTS Players_PlayerSteamId ON Players(PlayerSteamId)" },
+            { "Indexing bans by steam id",                  "CREATE UNIQUE INDEX IF NOT EXISTS Bans_PlayerSteamId ON Bans(PlayerSteamId)",
+                                                            "SELECT PlayerSteamId, COUNT(*) FROM Bans GROUP BY PlayerSteamId HAVING COUNT(*) > 1",
+                                                            "CREATE INDEX IF NOT EXISTS Bans_PlayerSteamId ON Bans(PlayerSteamId)" },
+            { "Indexing anti-cheat states by steam id",     "CREATE UNIQUE INDEX IF NOT EXISTS AntiCheatStates_PlayerSteamId ON AntiCheatStates(PlayerSteamId)",
+                                                            "SELECT PlayerSteamId, COUNT(*) FROM AntiCheatStates GROUP BY PlayerSteamId HAVING COUNT(*) > 1",
+                                                            "CREATE INDEX IF NOT EXISTS AntiCheatStates_PlayerSteamId ON AntiCheatStates(PlayerSteamId)" },
+            { "Indexing anti-cheat logs by steam id",       "CREATE INDEX IF NOT EXISTS AntiCheatLogs_PlayerSteamId ON AntiCheatLogs(PlayerSteamId)" },
+            // Indexes implicitly end with the rowid, so these also cover the ORDER BY rowid of the recent entry queries.
+            { "Indexing blood messages by area and cell",   "CREATE INDEX IF NOT EXISTS BloodMessages_OnlineAreaId_CellId ON BloodMessages(OnlineAreaId, CellId)" },
+            { "Indexing bloodstains by area and cell",      "CREATE INDEX IF NOT EXISTS Bloodstains_OnlineAreaId_CellId ON Bloodstains(OnlineAreaId, CellId)" },
+            { "Indexing ghosts by area and cell",           "CREATE INDEX IF NOT EXISTS Ghosts_OnlineAreaId_CellId ON Ghosts(OnlineAreaId, CellId)" },
+            { "Indexing rankings by character",             "CREATE INDEX IF NOT EXISTS Rankings_BoardId_PlayerId_CharacterId ON Rankings(BoardId, PlayerId, CharacterId)" },
+            { "Indexing characters by player",              "CREATE INDEX IF NOT EXISTS Characters_PlayerId_CharacterId ON Characters(PlayerId, CharacterId)" },
+        },
+    };
+}
 
-    sqlite3_stmt* statement = nullptr;
-    if (int result = sqlite3_prepare_v2(db_handle, sql.c_str(), (int)sql.length(), &statement, nullptr); result != SQLITE_OK)
+bool ServerDatabase::MigrateSchema()
+{
+    int CurrentVersion = 0;
+    if (!RunStatement("PRAGMA user_version", {}, [&CurrentVersion](sqlite3_stmt* statement) {
+            CurrentVersion = sqlite3_column_int(statement, 0);
+        }))
     {
-        Error("sqlite3_prepare_v2 (%s) failed with error: %s", sql.c_str(), sqlite3_errstr(result));
         return false;
     }
-    for (int i = 0; i < Values.size(); i++)
+
+    int LatestVersion = (int)k_schema_migrations.size();
+    if (CurrentVersion >= LatestVersion)
     {
-        const DatabaseValue& Value = Values[i];
-        if (auto CastValue = std::get_if<std::string>(&Value))
+        return true;
+    }
+
+    Log("Migrating database schema from version %i to %i, this may take a while on large databases ...", CurrentVersion, LatestVersion);
+
+    for (int Version = CurrentVersion + 1; Version <= LatestVersion; Version++)
+    {
+        double StartTime = GetHighResolutionSeconds();
+
+        // Each version is applied in its own transaction, so an interrupted migration is just run again next time.
+        if (!Execute("BEGIN"))
         {
-            if (int result = sqlite3_bind_text(statement, i + 1, CastValue->c_str(), (int)CastValue->length(), SQLITE_STATIC); result != SQLITE_OK)
-            {
-                Error("sqlite3_bind_text failed with error: %s", sqlite3_errstr(result));
-                sqlite3_finalize(statement);
-                return false;
-            }
+            return false;
         }
-        else if (auto CastValue = std::get_if<int>(&Value))
+
+        for (const SchemaMigrationStep& Step : k_schema_migrations[Version - 1])
         {
-            if (int result = sqlite3_bind_int(statement, i + 1, *CastValue); result != SQLITE_OK)
+            Log("[Version %i] %s ...", Version, Step.Description);
+
+            const char* Sql = Step.Sql;
+            if (Step.ConflictCheck != nullptr)
             {
-                Error("sqlite3_bind_int failed with error: %s", sqlite3_errstr(result));
-                sqlite3_finalize(statement);
-                return false;
+                size_t Conflicts = 0;
+                if (!RunStatement(Step.ConflictCheck, {}, [Version, &Conflicts](sqlite3_stmt* statement) {
+                        const char* Value = (const char*)sqlite3_column_text(statement, 0);
+                        Warning("[Version %i] '%s' appears in %i rows.", Version, Value ? Value : "", sqlite3_column_int(statement, 1));
+                        Conflicts++;
+                    }))
+                {
+                    Execute("ROLLBACK");
+                    return false;
+                }
+
+                if (Conflicts > 0)
+                {
+                    Warning("[Version %i] Found %zu conflicting values, existing rows have been left as they are and the fallback will be used instead.", Version, Conflicts);
+                    Sql = Step.FallbackSql;
+                }
             }
-        }
-        else if (auto CastValue = std::get_if<int64_t>(&Value))
-        {
-            if (int result = sqlite3_bind_int64(statement, i + 1, *CastValue); result != SQLITE_OK)
+
+            if (!Execute(Sql))
             {
-                Error("sqlite3_bind_int failed with error: %s", sqlite3_errstr(result));
-                sqlite3_finalize(statement);
+                Execute("ROLLBACK");
                 return false;
             }
         }
-        else if (auto CastValue = std::get_if<uint64_t>(&Value))
+
+        // Pragmas can't take parameters.
+        if (!Execute("PRAGMA user_version = " + std::to_string(Version)) || !Execute("COMMIT"))
         {
-            if (int result = sqlite3_bind_int64(statement, i + 1, *CastValue); result != SQLITE_OK)
-            {
-                Error("sqlite3_bind_int failed with error: %s", sqlite3_errstr(result));
-                sqlite3_finalize(statement);
-                return false;
-            }
+            Execute("ROLLBACK");
+            return false;
         }
-        else if (auto CastValue = std::get_if<uint32_t>(&Value))
+
+        Log("Migrated database schema to version %i in %.2f seconds.", Version, GetHighResolutionSeconds() - StartTime);
+    }
+
+    return true;
+}
+
+ServerDatabase::PreparedStatement* ServerDatabase::FindOrPrepareStatement(std::string_view sql)
+{
+    if (auto Iter = Statements.find(sql); Iter != Statements.end())
+    {
+        return Iter->second.get();
+    }
+
+    std::unique_ptr<PreparedStatement> Entry = std::make_unique<PreparedStatement>();
+    Entry->Sql = sql;
+
+    if (int result = sqlite3_prepare_v3(db_handle, Entry->Sql.c_str(), (int)Entry->Sql.length(), SQLITE_PREPARE_PERSISTENT, &Entry->Statement, nullptr); result != SQLITE_OK)
+    {
+        Error("sqlite3_prepare_v3 (%s) failed with error: %s", Entry->Sql.c_str(), sqlite3_errstr(result));
+        return nullptr;
+    }
+
+    if (TrackStatistics)
+    {
+        Entry->Timer = std::make_unique<DebugTimer>("Database Query: " + Entry->Sql);
+        Entry->Calls = std::make_unique<DebugCounter>("Database Query: " + Entry->Sql);
+    }
+
+    PreparedStatement* Result = Entry.get();
+    Statements.emplace(std::string_view(Result->Sql), std::move(Entry));
+
+    return Result;
+}
+
+void ServerDatabase::FinalizeStatements()
+{
+    for (auto& [Sql, Entry] : Statements)
+    {
+        sqlite3_finalize(Entry->Statement);
+    }
+    Statements.clear();
+}
+
+bool ServerDatabase::RunStatement(std::string_view sql, std::initializer_list<DatabaseValue> Values, RowCallback Callback)
+{
+    std::scoped_lock lock(StatementMutex);
+
+    std::optional<DebugTimerScope> Scope;
+    if (TrackStatistics)
+    {
+        Scope.emplace(Debug::DatabaseQueryTime);
+        Debug::DatabaseQueries.Add(1.0f);
+    }
+
+    PreparedStatement* Prepared = FindOrPrepareStatement(sql);
+    if (Prepared == nullptr)
+    {
+        return false;
+    }
+
+    // Only happens if a row callback runs the statement its being called from, 
+    // give it its own statement so we don't reset the one being stepped.
+    sqlite3_stmt* statement = Prepared->Statement;
+    bool Temporary = Prepared->InUse;
+    if (Temporary)
+    {
+        if (int result = sqlite3_prepare_v2(db_handle, Prepared->Sql.c_str(), (int)Prepared->Sql.length(), &statement, nullptr); result != SQLITE_OK)
         {
-            // Eeeeeh, this is a shitty way to handle this, but it technically doesn't truncate the value.
-            if (int result = sqlite3_bind_int64(statement, i + 1, *CastValue); result != SQLITE_OK)
-            {
-                Error("sqlite3_bind_int failed with error: %s", sqlite3_errstr(result));
-                sqlite3_finalize(statement);
-                return false;
-            }
+            Error("sqlite3_prepare_v2 (%s) failed with error: %s", Prepared->Sql.c_str(), sqlite3_errstr(result));
+            return false;
         }
-        else if (auto CastValue = std::get_if<float>(&Value))
+    }
+
+    std::optional<DebugTimerScope> StatementScope;
+    if (Prepared->Timer)
+    {
+        StatementScope.emplace(*Prepared->Timer);
+        Prepared->Calls->Add(1.0f);
+    }
+    Prepared->InUse = true;
+
+    // Puts the statement back in a reusable state however we leave.
+    struct StatementReset
+    {
+        PreparedStatement* Prepared;
+        sqlite3_stmt* Statement;
+        bool Temporary;
+
+        ~StatementReset()
         {
-            if (int result = sqlite3_bind_double(statement, i + 1, *CastValue); result != SQLITE_OK)
+            if (Temporary)
             {
-                Error("sqlite3_bind_double failed with error: %s", sqlite3_errstr(result));
-                sqlite3_finalize(statement);
-                return false;
+                sqlite3_finalize(Statement);
+                return;
             }
+
+            sqlite3_reset(Statement);
+            sqlite3_clear_bindings(Statement);
+            Prepared->InUse = false;
         }
-        else if (auto CastValue = std::get_if<std::vector<uint8_t>>(&Value))
+    } Reset = { Prepared, statement, Temporary };
+
+    int Index = 1;
+    for (const DatabaseValue& Value : Values)
+    {
+        int result = SQLITE_OK;
+        switch (Value.Type)
         {
-            if (int result = sqlite3_bind_blob(statement, i + 1, CastValue->data(), (int)CastValue->size(), SQLITE_STATIC); result != SQLITE_OK)
+        case DatabaseValue::ValueType::Int:
             {
-                Error("sqlite3_bind_int failed with error: %s", sqlite3_errstr(result));
-                sqlite3_finalize(statement);
-                return false;
+                result = sqlite3_bind_int(statement, Index, (int)Value.Int);
+                break;
             }
+        case DatabaseValue::ValueType::Int64:
+            {
+                result = sqlite3_bind_int64(statement, Index, Value.Int);
+                break;
+            }
+        case DatabaseValue::ValueType::Double:
+            {
+                result = sqlite3_bind_double(statement, Index, Value.Double);
+                break;
+            }
+        case DatabaseValue::ValueType::Text:
+            {
+                result = sqlite3_bind_text(statement, Index, (const char*)Value.Data, (int)Value.Length, SQLITE_STATIC);
+                break;
+            }
+        case DatabaseValue::ValueType::Blob:
+            {
+                result = sqlite3_bind_blob(statement, Index, Value.Data, (int)Value.Length, SQLITE_STATIC);
+                break;
+            }
+        }
+
+        if (result != SQLITE_OK)
+        {
+            Error("sqlite3_bind (%s, parameter %i) failed with error: %s", Prepared->Sql.c_str(), Index, sqlite3_errstr(result));
+            return false;
         }
+
+        Index++;
     }
+
     while (true)
     {
         int result = sqlite3_step(statement);
@@ -281,12 +641,196 @@ bool ServerDatabase::RunStatement(const std::string& sql, const std::vector<Data
             return false;
         }
     }
-    if (int result = sqlite3_finalize(statement); result != SQLITE_OK)
+
+    return true;
+}
+
+void ServerDatabase::QueueWrite(WriteOperation Operation, WriteCallback Callback)
+{
+    Debug::DatabaseWritesQueued.Add(1.0f);
+
+    bool WakeThread = false;
+    {
+        std::scoped_lock lock(WriteMutex);
+
+        if (WriteQueue.empty())
+        {
+            WriteQueueStartTime = std::chrono::steady_clock::now();
+        }
+
+        WriteQueue.push_back({ std::move(Operation), std::move(Callback) });
+
+        // The thread only needs waking to start a new batch or to commit a full one early.
+        WakeThread = (WriteQueue.size() == 1 || WriteQueue.size() >= CommitMaxOperations);
+    }
+
+    if (WakeThread)
+    {
+        WriteCvar.notify_one();
+    }
+}
+
+void ServerDatabase::WriteThreadEntry()
+{
+    std::vector<QueuedWrite> Batch;
+    std::vector<CompletedWrite> Completed;
+
+    while (true)
+    {
+        {
+            std::unique_lock lock(WriteMutex);
+            WriteCvar.wait(lock, [this]() { return !WriteQueue.empty() || WriteThreadQuit; });
+
+            if (WriteQueue.empty())
+            {
+                return;
+            }
+
+            // Give the batch a chance to fill up before committing it.
+            WriteCvar.wait_until(lock, WriteQueueStartTime + CommitInterval, [this]() { 
+                return WriteQueue.size() >= CommitMaxOperations || WriteThreadQuit; 
+            });
+
+            Batch.swap(WriteQueue);
+            WriteBatchSize = Batch.size();
+        }
+
+        double StartTime = GetHighResolutionSeconds();
+
+        // Callers have already been handed ids for a lot of these writes, so try hard not to lose them. Retry
+        // the whole batch a few times in case its something transient, before anything newer is written.
+        std::vector<bool> Results(Batch.size(), false);
+        bool Committed = false;
+
+        for (int Attempt = 1; Attempt <= k_max_commit_attempts && !Committed; Attempt++)
+        {
+            Committed = RunWriteTransaction(Batch, 0, Batch.size(), Results);
+            if (!Committed)
+            {
+                Warning("Failed to commit %zu queued database writes (attempt %i of %i).", Batch.size(), Attempt, k_max_commit_attempts);
+
+                if (Attempt < k_max_commit_attempts)
+                {
+                    std::this_thread::sleep_for(std::chrono::duration<double>(k_commit_retry_delay * (1 << (Attempt - 1))));
+                }
+            }
+        }
+
+        // Still failing, so commit each write on its own so one bad write can't take the rest of the batch with it.
+        if (!Committed)
+        {
+            for (size_t i = 0; i < Batch.size(); i++)
+            {
+                if (!RunWriteTransaction(Batch, i, 1, Results))
+                {
+                    Error("Dropping queued database write %zu of %zu as it failed to commit.", i + 1, Batch.size());
+                    Results[i] = false;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < Batch.size(); i++)
+        {
+            Completed.push_back({ std::move(Batch[i].Callback), Results[i] });
+        }
+
+        double CommitTime = GetHighResolutionSeconds() - StartTime;
+
+        bool HasCallbacks = false;
+        {
+            std::scoped_lock lock(WriteMutex);
+
+            for (CompletedWrite& Write : Completed)
+            {
+                if (Write.Callback)
+                {
+                    CompletedWrites.push_back(std::move(Write));
+                    HasCallbacks = true;
+                }
+            }
+
+            CommitTimes.push_back(CommitTime);
+            WritesCommitted += Batch.size();
+            WriteBatchSize = 0;
+        }
+
+        Batch.clear();
+        Completed.clear();
+
+        // Get the main thread to run the callbacks rather than waiting for it to wake up on its own.
+        if (HasCallbacks)
+        {
+            NetEventLoop::Get().Wake();
+        }
+    }
+}
+
+bool ServerDatabase::RunWriteTransaction(std::vector<QueuedWrite>& Writes, size_t Start, size_t Count, std::vector<bool>& Results)
+{
+    sqlite3* Handle = WriteConnection->db_handle;
+
+    if (!WriteConnection->RunStatement("BEGIN IMMEDIATE", {}, nullptr))
     {
-        Error("sqlite3_finalize failed with error: %s", sqlite3_errstr(result));
         return false;
     }
-    return true;
+
+    bool Success = true;
+    for (size_t i = Start; i < Start + Count && Success; i++)
+    {
+        Results[i] = Writes[i].Operation(*WriteConnection);
+
+        // Some errors roll back the transaction by themselves, carrying on would leave the rest of the writes 
+        // being committed one at a time, and then run a second time when the batch is retried.
+        if (sqlite3_get_autocommit(Handle))
+        {
+            Success = false;
+        }
+    }
+
+    if (Success && WriteConnection->RunStatement("COMMIT", {}, nullptr))
+    {
+        return true;
+    }
+
+    if (!sqlite3_get_autocommit(Handle))
+    {
+        WriteConnection->RunStatement("ROLLBACK", {}, nullptr);
+    }
+
+    return false;
+}
+
+void ServerDatabase::Poll()
+{
+    if (!WriteBehind)
+    {
+        return;
+    }
+
+    std::vector<CompletedWrite> Completed;
+    std::vector<double> Commits;
+    size_t Committed = 0;
+    size_t QueueDepth = 0;
+    {
+        std::scoped_lock lock(WriteMutex);
+        QueueDepth = WriteQueue.size() + WriteBatchSize;
+        Completed.swap(CompletedWrites);
+        Commits.swap(CommitTimes);
+        std::swap(Committed, WritesCommitted);
+    }
+
+    Debug::DatabaseWriteQueueDepth.Set((double)QueueDepth);
+    Debug::DatabaseWritesCommitted.Add((double)Committed);
+    Debug::DatabaseCommits.Add((double)Commits.size());
+    for (double Time : Commits)
+    {
+        Debug::DatabaseCommitTime.AddSample(Time);
+    }
+
+    for (CompletedWrite& Write : Completed)
+    {
+        Write.Callback(Write.Success);
+    }
 }
 
 bool ServerDatabase::FindOrCreatePlayer(const std::string& SteamId, uint32_t& PlayerId)
@@ -302,6 +846,8 @@ bool ServerDatabase::FindOrCreatePlayer(const std::string& SteamId, uint32_t& Pl
 
     if (PlayerId == 0)
     {
+        std::scoped_lock lock(StatementMutex);
+
         if (!RunStatement("INSERT INTO Players(PlayerSteamId) VALUES(?1)", { SteamId }, nullptr))
         {
             return false;
@@ -450,13 +996,35 @@ std::vector<std::shared_ptr<BloodMessage>> ServerDatabase::GetAllBloodMessages()
 
 std::shared_ptr<BloodMessage> ServerDatabase::CreateBloodMessage(uint32_t AreaId, uint64_t CellId, uint32_t PlayerId, const std::string& PlayerSteamId, uint32_t CharacterId, const std::vector<uint8_t>& Data)
 {
-    if (!RunStatement("INSERT INTO BloodMessages(OnlineAreaId, CellId, PlayerId, PlayerSteamId, CharacterId, RatingPoor, RatingGood, Data, CreatedTime) VALUES(?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, datetime('now'))", { (uint32_t)AreaId, (uint64_t)CellId, PlayerId, PlayerSteamId, CharacterId, 0, 0, Data }, nullptr))
+    uint32_t MessageId = 0;
+
+    if (WriteBehind)
     {
-        return nullptr;
+        MessageId = NextBloodMessageId++;
+
+        QueueWrite([=](ServerDatabase& Connection) {
+            return Connection.RunStatement("INSERT INTO BloodMessages(MessageId, OnlineAreaId, CellId, PlayerId, PlayerSteamId, CharacterId, RatingPoor, RatingGood, Data, CreatedTime) VALUES(?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, datetime('now'))", { MessageId, (uint32_t)AreaId, (uint64_t)CellId, PlayerId, PlayerSteamId, CharacterId, 0, 0, Data }, nullptr);
+        }, [MessageId](bool Success) {
+            if (!Success)
+            {
+                Warning("Failed to write blood message %u to database.", MessageId);
+            }
+        });
+    }
+    else
+    {
+        std::scoped_lock lock(StatementMutex);
+
+        if (!RunStatement("INSERT INTO BloodMessages(OnlineAreaId, CellId, PlayerId, PlayerSteamId, CharacterId, RatingPoor, RatingGood, Data, CreatedTime) VALUES(?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, datetime('now'))", { (uint32_t)AreaId, (uint64_t)CellId, PlayerId, PlayerSteamId, CharacterId, 0, 0, Data }, nullptr))
+        {
+            return nullptr;
+        }
+
+        MessageId = (uint32_t)sqlite3_last_insert_rowid(db_handle);
     }
 
     std::shared_ptr<BloodMessage> Result = std::make_shared<BloodMessage>();
-    Result->MessageId = (uint32_t)sqlite3_last_insert_rowid(db_handle);
+    Result->MessageId = MessageId;
     Result->OnlineAreaId = AreaId;
     Result->CellId = CellId;
     Result->CharacterId = CharacterId;
@@ -469,18 +1037,50 @@ std::shared_ptr<BloodMessage> ServerDatabase::CreateBloodMessage(uint32_t AreaId
     return Result;
 }
 
-bool ServerDatabase::RemoveOwnBloodMessage(uint32_t PlayerId, uint32_t MessageId)
+void ServerDatabase::RemoveOwnBloodMessage(uint32_t PlayerId, uint32_t MessageId, std::function<void(bool Removed)> Callback)
 {
+    if (WriteBehind)
+    {
+        // The message may only have just been created, queueing the delete puts it after that write rather than 
+        // waiting for the queue to drain. The result is only known once its committed, so its reported from Poll.
+        std::shared_ptr<bool> Removed = std::make_shared<bool>(false);
+        QueueWrite([=](ServerDatabase& Connection) {
+            return Connection.DeleteOwnBloodMessage(PlayerId, MessageId, *Removed);
+        }, [Removed, Callback](bool Success) {
+            Callback(Success && *Removed);
+        });
+        return;
+    }
+
+    bool Removed = false;
+    Callback(DeleteOwnBloodMessage(PlayerId, MessageId, Removed) && Removed);
+}
+
+bool ServerDatabase::DeleteOwnBloodMessage(uint32_t PlayerId, uint32_t MessageId, bool& Removed)
+{
+    std::scoped_lock lock(StatementMutex);
+
     if (!RunStatement("DELETE FROM BloodMessages WHERE MessageId = ?1 AND PlayerId = ?2", { MessageId, PlayerId }, nullptr))
     {
         return false;
     }
 
-    return sqlite3_changes(db_handle) > 0;
+    Removed = sqlite3_changes(db_handle) > 0;
+    return true;
 }
 
 bool ServerDatabase::SetBloodMessageEvaluation(uint32_t MessageId, uint32_t Poor, uint32_t Good)
 {
+    if (WriteBehind)
+    {
+        QueueWrite([=](ServerDatabase& Connection) {
+            return Connection.SetBloodMessageEvaluation(MessageId, Poor, Good);
+        });
+        return true;
+    }
+
+    std::scoped_lock lock(StatementMutex);
+
     if (!RunStatement("UPDATE BloodMessages SET RatingPoor = ?1, RatingGood = ?2 WHERE MessageId = ?3", { Poor, Good, MessageId }, nullptr))
     {
         return false;
@@ -566,13 +1166,35 @@ std::vector<std::shared_ptr<Bloodstain>> ServerDatabase::FindRecentBloodstains(u
 
 std::shared_ptr<Bloodstain> ServerDatabase::CreateBloodstain(uint32_t AreaId, uint64_t CellId, uint32_t PlayerId, const std::string& PlayerSteamId, const std::vector<uint8_t>& Data, const std::vector<uint8_t>& GhostData)
 {
-    if (!RunStatement("INSERT INTO Bloodstains(OnlineAreaId, CellId, PlayerId, PlayerSteamId, Data, GhostData, CreatedTime) VALUES(?1, ?2, ?3, ?4, ?5, ?6, datetime('now'))", { (uint32_t)AreaId, CellId, PlayerId, PlayerSteamId, Data, GhostData }, nullptr))
+    uint32_t BloodstainId = 0;
+
+    if (WriteBehind)
     {
-        return nullptr;
+        BloodstainId = NextBloodstainId++;
+
+        QueueWrite([=](ServerDatabase& Connection) {
+            return Connection.RunStatement("INSERT INTO Bloodstains(BloodstainId, OnlineAreaId, CellId, PlayerId, PlayerSteamId, Data, GhostData, CreatedTime) VALUES(?1, ?2, ?3, ?4, ?5, ?6, ?7, datetime('now'))", { BloodstainId, (uint32_t)AreaId, CellId, PlayerId, PlayerSteamId, Data, GhostData }, nullptr);
+        }, [BloodstainId](bool Success) {
+            if (!Success)
+            {
+                Warning("Failed to write bloodstain %u to database.", BloodstainId);
+            }
+        });
+    }
+    else
+    {
+        std::scoped_lock lock(StatementMutex);
+
+        if (!RunStatement("INSERT INTO Bloodstains(OnlineAreaId, CellId, PlayerId, PlayerSteamId, Data, GhostData, CreatedTime) VALUES(?1, ?2, ?3, ?4, ?5, ?6, datetime('now'))", { (uint32_t)AreaId, CellId, PlayerId, PlayerSteamId, Data, GhostData }, nullptr))
+        {
+            return nullptr;
+        }
+
+        BloodstainId = (uint32_t)sqlite3_last_insert_rowid(db_handle);
     }
 
     std::shared_ptr<Bloodstain> Result = std::make_shared<Bloodstain>();
-    Result->BloodstainId = (uint32_t)sqlite3_last_insert_rowid(db_handle);
+    Result->BloodstainId = BloodstainId;
     Result->OnlineAreaId = AreaId;
     Result->CellId = CellId;
     Result->PlayerId = PlayerId;
@@ -632,13 +1254,35 @@ std::vector<std::shared_ptr<Ghost>> ServerDatabase::FindRecentGhosts(uint32_t Ar
 
 std::shared_ptr<Ghost> ServerDatabase::CreateGhost(uint32_t AreaId, uint64_t CellId, uint32_t PlayerId, const std::string& PlayerSteamId, const std::vector<uint8_t>& Data)
 {
-    if (!RunStatement("INSERT INTO Ghosts(OnlineAreaId, CellId, PlayerId, PlayerSteamId, Data, CreatedTime) VALUES(?1, ?2, ?3, ?4, ?5, datetime('now'))", { (uint32_t)AreaId, CellId, PlayerId, PlayerSteamId, Data }, nullptr))
+    uint32_t GhostId = 0;
+
+    if (WriteBehind)
     {
-        return nullptr;
+        GhostId = NextGhostId++;
+
+        QueueWrite([=](ServerDatabase& Connection) {
+            return Connection.RunStatement("INSERT INTO Ghosts(GhostId, OnlineAreaId, CellId, PlayerId, PlayerSteamId, Data, CreatedTime) VALUES(?1, ?2, ?3, ?4, ?5, ?6, datetime('now'))", { GhostId, (uint32_t)AreaId, CellId, PlayerId, PlayerSteamId, Data }, nullptr);
+        }, [GhostId](bool Success) {
+            if (!Success)
+            {
+                Warning("Failed to write ghost %u to database.", GhostId);
+            }
+        });
+    }
+    else
+    {
+        std::scoped_lock lock(StatementMutex);
+
+        if (!RunStatement("INSERT INTO Ghosts(OnlineAreaId, CellId, PlayerId, PlayerSteamId, Data, CreatedTime) VALUES(?1, ?2, ?3, ?4, ?5, datetime('now'))", { (uint32_t)AreaId, CellId, PlayerId, PlayerSteamId, Data }, nullptr))
+        {
+            return nullptr;
+        }
+
+        GhostId = (uint32_t)sqlite3_last_insert_rowid(db_handle);
     }
 
     std::shared_ptr<Ghost> Result = std::make_shared<Ghost>();
-    Result->GhostId = (uint32_t)sqlite3_last_insert_rowid(db_handle);
+    Result->GhostId = GhostId;
     Result->OnlineAreaId = AreaId;
     Result->CellId = CellId;
     Result->PlayerId = PlayerId;
@@ -653,140 +1297,136 @@ void ServerDatabase::TrimGhosts(size_t MaxEntries)
     TrimTable("Ghosts", "GhostId", MaxEntries);
 }
 
-std::shared_ptr<Ranking> ServerDatabase::RegisterScore(uint32_t BoardId, uint32_t PlayerId, uint32_t CharacterId, uint32_t Score, const std::vector<uint8_t>& Data)
+bool ServerDatabase::LoadRankings()
 {
-    // Delete existing ranking.
-    if (!RunStatement("DELETE FROM Rankings WHERE BoardId = ?1 AND PlayerId = ?2 AND CharacterId = ?3", { BoardId, PlayerId, CharacterId }, nullptr))
-    {
-        return nullptr;
-    }
-
-    // Insert new ranking.
-    if (!RunStatement("INSERT INTO Rankings(BoardId, PlayerId, CharacterId, Score, Data, CreatedTime) VALUES(?1, ?2, ?3, ?4, ?5, datetime('now'))", { BoardId, PlayerId, CharacterId, Score, Data }, nullptr))
+    RankingBoards.clear();
+
+    double StartTime = GetHighResolutionSeconds();
+    size_t Count = 0;
+
+    if (!RunStatement("SELECT ScoreId, BoardId, PlayerId, CharacterId, Score, Data FROM Rankings", {}, [this, &Count](sqlite3_stmt* statement) {
+            std::shared_ptr<Ranking> Entry = std::make_shared<Ranking>();
+            Entry->Id = sqlite3_column_int(statement, 0);
+            Entry->BoardId = sqlite3_column_int(statement, 1);
+            Entry->PlayerId = sqlite3_column_int(statement, 2);
+            Entry->CharacterId = sqlite3_column_int(statement, 3);
+            Entry->Score = sqlite3_column_int(statement, 4);
+            Entry->Rank = 0;
+            Entry->SerialRank = 0;
+
+            const uint8_t* data_blob = (const uint8_t*)sqlite3_column_blob(statement, 5);
+            Entry->Data.assign(data_blob, data_blob + sqlite3_column_bytes(statement, 5));
+
+            RankingBoards[Entry->BoardId].Add(std::move(Entry));
+            Count++;
+        }))
     {
-        return nullptr;
+        return false;
     }
 
-    uint32_t NewRankingId = (uint32_t)sqlite3_last_insert_rowid(db_handle);
-    uint32_t NewRank = 1;
-    uint32_t NewSerialRank = 1;
+    Log("Loaded %zu rankings across %zu boards in %.2f seconds.", Count, RankingBoards.size(), GetHighResolutionSeconds() - StartTime);
 
-    // Update rankings of all socre entries. 
-    // TODO: If we get any reasonable frequency of ranking registrations we should do these lazily 
-    //       at a periodic interval to keep load down.
-    
-    uint32_t CurrentRank = 1;
-    uint32_t CurrentRankScore = 0;
-    uint32_t CurrentSerialRank = 1;
+    return true;
+}
 
-    std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> ScoreRanks;
+std::shared_ptr<Ranking> ServerDatabase::RegisterScore(uint32_t BoardId, uint32_t PlayerId, uint32_t CharacterId, uint32_t Score, const std::vector<uint8_t>& Data)
+{
+    uint32_t NewRankingId = 0;
 
-    RunStatement("SELECT ScoreId, Score FROM Rankings WHERE BoardId = ?1 ORDER BY Score DESC, CreatedTime ASC", { BoardId }, [&CurrentRank, &CurrentRankScore, &CurrentSerialRank, &ScoreRanks, NewRankingId, &NewRank, &NewSerialRank] (sqlite3_stmt* statement) {
-        uint32_t ScoreId = sqlite3_column_int(statement, 0);
-        uint32_t Score = sqlite3_column_int(statement, 1);
-        uint32_t ScoreRank = 0;
-        uint32_t ScoreSerialRank = 0;
+    // Replaces the characters existing ranking.
+    if (WriteBehind)
+    {
+        NewRankingId = NextRankingId++;
 
-        if (CurrentSerialRank == 1)
-        {
-            CurrentRankScore = Score;
-        }
-        else if (Score < CurrentRankScore)
-        {
-            CurrentRank++;
-            CurrentRankScore = Score;
-        }
+        QueueWrite([=](ServerDatabase& Connection) {
+            return Connection.RunStatement("DELETE FROM Rankings WHERE BoardId = ?1 AND PlayerId = ?2 AND CharacterId = ?3", { BoardId, PlayerId, CharacterId }, nullptr) &&
+                   Connection.RunStatement("INSERT INTO Rankings(ScoreId, BoardId, PlayerId, CharacterId, Score, Data, CreatedTime) VALUES(?1, ?2, ?3, ?4, ?5, ?6, datetime('now'))", { NewRankingId, BoardId, PlayerId, CharacterId, Score, Data }, nullptr);
+        }, [NewRankingId](bool Success) {
+            if (!Success)
+            {
+                Warning("Failed to write ranking %u to database.", NewRankingId);
+            }
+        });
+    }
+    else
+    {
+        std::scoped_lock lock(StatementMutex);
 
-        if (ScoreId == NewRankingId)
+        if (!RunStatement("DELETE FROM Rankings WHERE BoardId = ?1 AND PlayerId = ?2 AND CharacterId = ?3", { BoardId, PlayerId, CharacterId }, nullptr))
         {
-            NewRank = CurrentRank;
-            NewSerialRank = CurrentSerialRank;
+            return nullptr;
         }
 
-        ScoreRanks.push_back(std::make_tuple(ScoreId, CurrentRank, CurrentSerialRank));
-
-        CurrentSerialRank++;       
-    });
-
-    for (auto& tuple : ScoreRanks)
-    {
-        if (!RunStatement("UPDATE Rankings SET Rank = ?1, SerialRank = ?2 WHERE ScoreId = ?3", { std::get<1>(tuple), std::get<2>(tuple), std::get<0>(tuple) }, nullptr))
+        if (!RunStatement("INSERT INTO Rankings(BoardId, PlayerId, CharacterId, Score, Data, CreatedTime) VALUES(?1, ?2, ?3, ?4, ?5, datetime('now'))", { BoardId, PlayerId, CharacterId, Score, Data }, nullptr))
         {
             return nullptr;
         }
+
+        NewRankingId = (uint32_t)sqlite3_last_insert_rowid(db_handle);
     }
 
-    // Create and return a ranking to the caller.
-    std::shared_ptr<Ranking> Result = std::make_shared<Ranking>();
-    Result->Id = NewRankingId;
-    Result->BoardId = BoardId;
-    Result->PlayerId = PlayerId;
-    Result->CharacterId = CharacterId;
-    Result->Score = Score;
-    Result->Data = Data;
-    Result->Rank = NewRank; 
-    Result->SerialRank = NewSerialRank;
+    std::shared_ptr<Ranking> Entry = std::make_shared<Ranking>();
+    Entry->Id = NewRankingId;
+    Entry->BoardId = BoardId;
+    Entry->PlayerId = PlayerId;
+    Entry->CharacterId = CharacterId;
+    Entry->Score = Score;
+    Entry->Data = Data;
+    Entry->Rank = 0;
+    Entry->SerialRank = 0;
 
-    return Result;
+    RankingBoard& Board = RankingBoards[BoardId];
+    Board.Add(std::move(Entry));
+
+    return Board.Find(PlayerId, CharacterId);
 }
 
 std::vector<std::shared_ptr<Ranking>> ServerDatabase::GetRankings(uint32_t BoardId, uint32_t Offset, uint32_t Count)
 {
-    std::vector<std::shared_ptr<Ranking>> Result;
-
-    RunStatement("SELECT ScoreId, PlayerId, CharacterId, Rank, SerialRank, Score, Data FROM Rankings WHERE BoardId = ?1 ORDER BY SerialRank ASC LIMIT ?2 OFFSET ?3", { BoardId, Count, Offset - 1 }, [&Result, BoardId](sqlite3_stmt* statement) {
-        std::shared_ptr<Ranking> Entry = std::make_shared<Ranking>();
-        Entry->Id = sqlite3_column_int(statement, 0);
-        Entry->BoardId = BoardId;
-        Entry->PlayerId = sqlite3_column_int(statement, 1);
-        Entry->CharacterId = sqlite3_column_int(statement, 2);
-        Entry->Rank = sqlite3_column_int(statement, 3);
-        Entry->SerialRank = sqlite3_column_int(statement, 4);
-        Entry->Score = sqlite3_column_int(statement, 5);
-
-        const uint8_t* data_blob = (const uint8_t*)sqlite3_column_blob(statement, 6);
-        Entry->Data.assign(data_blob, data_blob + sqlite3_column_bytes(statement, 6));
-
-        Result.push_back(Entry);
-    });
+    auto Iter = RankingBoards.find(BoardId);
+    if (Iter == RankingBoards.end())
+    {
+        return {};
+    }
 
-    return Result;
+    // Offset is the 1-based rank to start from.
+    return Iter->second.GetRange(Offset > 0 ? Offset - 1 : 0, Count);
 }
 
 std::shared_ptr<Ranking> ServerDatabase::GetCharacterRanking(uint32_t BoardId, uint32_t PlayerId, uint32_t CharacterId)
 {
-    std::shared_ptr<Ranking> Result;
-
-    RunStatement("SELECT ScoreId, Rank, SerialRank, Score, Data FROM Rankings WHERE BoardId = ?1 AND PlayerId = ?2 AND CharacterId = ?3 LIMIT 1", { BoardId, PlayerId, CharacterId }, [&Result, BoardId, PlayerId, CharacterId](sqlite3_stmt* statement) {
-        Result = std::make_shared<Ranking>();
-        Result->Id = sqlite3_column_int(statement, 0);
-        Result->BoardId = BoardId;
-        Result->PlayerId = PlayerId;
-        Result->CharacterId = CharacterId;
-        Result->Rank = sqlite3_column_int(statement, 1);
-        Result->SerialRank = sqlite3_column_int(statement, 2);
-        Result->Score = sqlite3_column_int(statement, 3);
-
-        const uint8_t* data_blob = (const uint8_t*)sqlite3_column_blob(statement, 4);
-        Result->Data.assign(data_blob, data_blob + sqlite3_column_bytes(statement, 4));
-    });
+    auto Iter = RankingBoards.find(BoardId);
+    if (Iter == RankingBoards.end())
+    {
+        return nullptr;
+    }
 
-    return Result;
+    return Iter->second.Find(PlayerId, CharacterId);
 }
 
 uint32_t ServerDatabase::GetRankingCount(uint32_t BoardId)
 {
-    uint32_t Result = 0;
-
-    RunStatement("SELECT COUNT(*) FROM Rankings WHERE BoardId = ?1", { BoardId }, [&Result](sqlite3_stmt* statement) {
-        Result = sqlite3_column_int(statement, 0);
-    });
+    auto Iter = RankingBoards.find(BoardId);
+    if (Iter == RankingBoards.end())
+    {
+        return 0;
+    }
 
-    return Result;
+    return (uint32_t)Iter->second.GetCount();
 }
 
 bool ServerDatabase::CreateOrUpdateCharacter(uint32_t PlayerId, uint32_t CharacterId, const std::vector<uint8_t>& Data)
 {
+    if (WriteBehind)
+    {
+        QueueWrite([=](ServerDatabase& Connection) {
+            return Connection.CreateOrUpdateCharacter(PlayerId, CharacterId, Data);
+        });
+        return true;
+    }
+
+    std::scoped_lock lock(StatementMutex);
+
     if (!RunStatement("UPDATE Characters SET Data = ?3 WHERE PlayerId = ?1 AND CharacterId = ?2", { PlayerId, CharacterId, Data }, nullptr))
     {
         return false;
@@ -827,6 +1467,14 @@ std::shared_ptr<Character> ServerDatabase::FindCharacter(uint32_t PlayerId, uint
 
 bool ServerDatabase::UpdateCharacterQuickMatchRank(uint32_t PlayerId, uint32_t CharacterId, uint32_t DualRank, uint32_t DualXp, uint32_t BrawlRank, uint32_t BrawlXp)
 {
+    if (WriteBehind)
+    {
+        QueueWrite([=](ServerDatabase& Connection) {
+            return Connection.UpdateCharacterQuickMatchRank(PlayerId, CharacterId, DualRank, DualXp, BrawlRank, BrawlXp);
+        });
+        return true;
+    }
+
     std::shared_ptr<Character> Result;
 
     if (!RunStatement("UPDATE Characters SET QuickMatchDuelRank = ?1, QuickMatchDuelXp = ?2, QuickMatchBrawlRank = ?3, QuickMatchBrawlXp = ?4  WHERE PlayerId = ?5 AND CharacterId = ?6", { 
@@ -846,6 +1494,15 @@ bool ServerDatabase::UpdateCharacterQuickMatchRank(uint32_t PlayerId, uint32_t C
 
 void ServerDatabase::AddMatchingSample(const std::string& Name, const std::string& Scope, int64_t Count, uint32_t Level, uint32_t WeaponLevel)
 {
+    if (WriteBehind)
+    {
+        QueueWrite([=](ServerDatabase& Connection) {
+            Connection.AddMatchingSample(Name, Scope, Count, Level, WeaponLevel);
+            return true;
+        });
+        return;
+    }
+
     RunStatement("INSERT INTO MatchingSamples(Name, Scope, Count, Level, WeaponLevel, CreatedTime) VALUES(?1, ?2, ?3, ?4, ?5, datetime('now'))", { Name, Scope, Count, Level, WeaponLevel }, nullptr);
 }
 
@@ -856,6 +1513,17 @@ void ServerDatabase::AddStatistic(const std::string& Name, const std::string& Sc
         return;
     }
 
+    if (WriteBehind)
+    {
+        QueueWrite([=](ServerDatabase& Connection) {
+            Connection.AddStatistic(Name, Scope, Count);
+            return true;
+        });
+        return;
+    }
+
+    std::scoped_lock lock(StatementMutex);
+
     if (!RunStatement("UPDATE Statistics SET Value = Value + ?3 WHERE Name = ?1 AND Scope = ?2", { Name, Scope, Count }, nullptr))
     {
         return;
@@ -877,6 +1545,17 @@ void ServerDatabase::SetStatistic(const std::string& Name, const std::string& Sc
         return;
     }
 
+    if (WriteBehind)
+    {
+        QueueWrite([=](ServerDatabase& Connection) {
+            Connection.SetStatistic(Name, Scope, Count);
+            return true;
+        });
+        return;
+    }
+
+    std::scoped_lock lock(StatementMutex);
+
     if (!RunStatement("UPDATE Statistics SET Value = ?3 WHERE Name = ?1 AND Scope = ?2", { Name, Scope, Count }, nullptr))
     {
         return;
@@ -989,6 +1668,8 @@ float ServerDatabase::GetAntiCheatPenaltyScore(const std::string& SteamId)
 
 void ServerDatabase::AddAntiCheatPenaltyScore(const std::string& SteamId, float Amount)
 {
+    std::scoped_lock lock(StatementMutex);
+
     if (!RunStatement("UPDATE AntiCheatStates SET Score = Score + ?2 WHERE PlayerSteamId = ?1", { SteamId, Amount }, nullptr))
     {
         return;
@@ -1005,6 +1686,15 @@ void ServerDatabase::AddAntiCheatPenaltyScore(const std::string& SteamId, float
 
 void ServerDatabase::LogAntiCheatTrigger(const std::string& SteamId, const std::string& TriggerName, float Penalty, const std::string& ExtraInfo)
 {
+    if (WriteBehind)
+    {
+        QueueWrite([=](ServerDatabase& Connection) {
+            Connection.LogAntiCheatTrigger(SteamId, TriggerName, Penalty, ExtraInfo);
+            return true;
+        });
+        return;
+    }
+
     if (!RunStatement("INSERT INTO AntiCheatLogs(PlayerSteamId, Score, TriggerName, ExtraInfo) VALUES(?1, ?2, ?3, ?4)", { SteamId, Penalty, TriggerName, ExtraInfo }, nullptr))
     {
         return;
@@ -1030,6 +1720,15 @@ std::vector<AntiCheatLog> ServerDatabase::GetAntiCheatLogs(const std::string& St
 
 void ServerDatabase::TrimTable(const std::string& TableName, const std::string& IdColumn, size_t MaxEntries)
 {
+    if (WriteBehind)
+    {
+        QueueWrite([=](ServerDatabase& Connection) {
+            Connection.TrimTable(TableName, IdColumn, MaxEntries);
+            return true;
+        });
+        return;
+    }
+
     size_t TotalEntries = 0;
 
     RunStatement("SELECT COUNT(*) FROM " + TableName, { }, [&TotalEntries](sqlite3_stmt* statement) {
@@ -1046,6 +1745,21 @@ void ServerDatabase::TrimTable(const std::string& TableName, const std::string&
     RunStatement("DELETE FROM " + TableName + " WHERE " + IdColumn + " IN (SELECT " + IdColumn + " FROM " + TableName + " ORDER BY " + IdColumn + " ASC LIMIT ?1)", { (int32_t)ToRemove }, nullptr);
 }
 
+uint32_t ServerDatabase::GetNextRowId(const std::string& TableName, const std::string& IdColumn)
+{
+    int64_t LastId = 0;
+
+    // Autoincrement never reuses ids, even those of rows that have since been deleted.
+    RunStatement("SELECT seq FROM sqlite_sequence WHERE name = ?1", { TableName }, [&LastId](sqlite3_stmt* statement) {
+        LastId = std::max(LastId, (int64_t)sqlite3_column_int64(statement, 0));
+    });
+    RunStatement("SELECT MAX(" + IdColumn + ") FROM " + TableName, { }, [&LastId](sqlite3_stmt* statement) {
+        LastId = std::max(LastId, (int64_t)sqlite3_column_int64(statement, 0));
+    });
+
+    return (uint32_t)(LastId + 1);
+}
+
 void ServerDatabase::Trim()
 {
     if constexpr (!BuildConfig::STORE_PER_PLAYER_STATISTICS)
@@ -11,14 +11,50 @@
 
 #include <filesystem>
 #include <functional>
-#include <variant>
+#include <string_view>
+#include <unordered_map>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
 
 #include "Server/Database/DatabaseTypes.h"
+#include "Server/Database/RankingBoard.h"
+
+#include "Shared/Core/Utils/DebugTimer.h"
+#include "Shared/Core/Utils/DebugCounter.h"
 
 struct sqlite3;
 struct sqlite3_stmt;
 
+// Options controlling how the database's connections are opened and tuned. Empty and zero values
+// leave sqlite's defaults alone. See RuntimeConfig for a description of each.
+struct DatabaseSettings
+{
+    bool WriteBehind = false;
+    double CommitInterval = 0.5;
+    size_t CommitMaxOperations = 256;
+
+    std::string JournalMode;
+    std::string Synchronous;
+    std::string TempStore;
+    int CacheSizeKb = 0;
+    int MmapSizeMb = 0;
+    double CheckpointInterval = 0.0;
+};
+
 // Interface to the sqlite database.
+//
+// If write-behind is enabled, writes that callers don't need to wait on (statistics, new blood
+// messages, character updates, etc) are queued and run on a dedicated thread with its own connection,
+// rather than each being its own transaction on the main thread. Queued writes are batched into a 
+// single transaction which is committed once CommitInterval seconds have passed since the first
+// write in it was queued, or once CommitMaxOperations writes are queued, whichever comes first.
+//
+// Reads are still done on the main thread's connection, so may not see a queued write until
+// the batch it's in has been committed.
 
 class ServerDatabase
 {
@@ -26,9 +62,18 @@ public:
     ServerDatabase();
     ~ServerDatabase();
 
-    bool Open(const std::filesystem::path& path);
+    bool Open(const std::filesystem::path& path, const DatabaseSettings& Settings = DatabaseSettings());
     bool Close();
 
+    // Opens a read-only connection to a database that is already open elsewhere in the process. Its
+    // used to keep lengthy queries (eg. from the WebUI) from holding up the main connection, and is 
+    // safe to use from multiple threads.
+    bool OpenReadOnly(const std::filesystem::path& path, const DatabaseSettings& Settings = DatabaseSettings());
+
+    // Runs the completion callbacks of committed writes and updates debug statistics, should
+    // be called regularly on the main thread.
+    void Poll();
+
     // Trims any neccessary internal tables.
     void Trim();
 
@@ -91,10 +136,14 @@ public:
     std::vector<std::shared_ptr<BloodMessage>> FindRecentBloodMessage(uint32_t AreaId, int Count);
 
     // Creates a new blood message with the given data and returns a representation of it.
+    // With write-behind enabled the returned message's id is reserved up front, so can be used 
+    // straight away even though the row won't exist until the next commit.
     std::shared_ptr<BloodMessage> CreateBloodMessage(uint32_t AreaId, uint64_t CellId, uint32_t PlayerId, const std::string& PlayerSteamId, uint32_t CharacterId, const std::vector<uint8_t>& Data);
 
-    // Removes a blood message from the database that is owned by the given player.
-    bool RemoveOwnBloodMessage(uint32_t PlayerId, uint32_t MessageId);
+    // Removes a blood message from the database that is owned by the given player. The callback is 
+    // told if the message was removed, with write-behind enabled this is once the delete has been 
+    // committed (from Poll), otherwise its called before returning.
+    void RemoveOwnBloodMessage(uint32_t PlayerId, uint32_t MessageId, std::function<void(bool Removed)> Callback);
 
     // Updates the evaluation ratings of a blood message.
     bool SetBloodMessageEvaluation(uint32_t MessageId, uint32_t Poor, uint32_t Good);
@@ -141,6 +190,8 @@ public:
     // ----------------------------------------------------------------
     // Rankings interface
     // ----------------------------------------------------------------
+    // Leaderboards are loaded into memory when the database is opened and ranks are 
+    // worked out from there, the Rank and SerialRank columns are no longer kept up to date.
 
     // Registers a new score to a leaderboard.
     std::shared_ptr<Ranking> RegisterScore(uint32_t BoardId, uint32_t PlayerId, uint32_t CharcterId, uint32_t Score, const std::vector<uint8_t>& Data);
@@ -206,17 +257,163 @@ public:
 
 protected:
 
-    using DatabaseValue = std::variant<std::string, int, uint32_t, float, std::vector<uint8_t>, int64_t, uint64_t>;
+    // Called on the main thread once a queued write has been committed, or has failed.
+    typedef std::function<void(bool Success)> WriteCallback;
+
+    // Run on the write thread against its own connection.
+    typedef std::function<bool(ServerDatabase& Connection)> WriteOperation;
+
+    // Queues an operation to be run in the next batch on the write thread. Anything the 
+    // operation uses should be captured by value.
+    void QueueWrite(WriteOperation Operation, WriteCallback Callback = nullptr);
+
+    // A value to bind to a statement parameter. Strings and blobs are referenced rather than copied, 
+    // so the original has to outlive the statement. Values passed inline to RunStatement always do.
+    struct DatabaseValue
+    {
+        enum class ValueType
+        {
+            Int,
+            Int64,
+            Double,
+            Text,
+            Blob
+        };
+
+        DatabaseValue(int Value)                            : Type(ValueType::Int), Int(Value) {}
+        DatabaseValue(uint32_t Value)                       : Type(ValueType::Int64), Int(Value) {}
+        DatabaseValue(int64_t Value)                        : Type(ValueType::Int64), Int(Value) {}
+        DatabaseValue(uint64_t Value)                       : Type(ValueType::Int64), Int((int64_t)Value) {}
+        DatabaseValue(float Value)                          : Type(ValueType::Double), Double(Value) {}
+        DatabaseValue(const std::string& Value)             : Type(ValueType::Text), Data(Value.data()), Length(Value.size()) {}
+        DatabaseValue(const std::vector<uint8_t>& Value)    : Type(ValueType::Blob), Data(Value.data()), Length(Value.size()) {}
+
+        ValueType Type;
+        int64_t Int = 0;
+        double Double = 0.0;
+        const void* Data = nullptr;
+        size_t Length = 0;
+    };
 
     typedef std::function<void(sqlite3_stmt* statement)> RowCallback;
 
-    bool RunStatement(const std::string& sql, const std::vector<DatabaseValue>& Values, RowCallback Callback);
+    bool RunStatement(std::string_view sql, std::initializer_list<DatabaseValue> Values, RowCallback Callback);
 
     bool CreateTables();
 
+    // Brings the schema of an existing database up to date, see the migration list in ServerDatabase.cpp.
+    bool MigrateSchema();
+
     void TrimTable(const std::string& TableName, const std::string& IdColumn, size_t MaxEntries);
 
+    // Gets the id the next row inserted into an autoincrement table will be given.
+    uint32_t GetNextRowId(const std::string& TableName, const std::string& IdColumn);
+
+    bool LoadRankings();
+
 private:
+
+    bool OpenConnection(const std::filesystem::path& path, const DatabaseSettings& Settings, bool ReadOnly);
+
+    // Runs a one-off statement without preparing and caching it.
+    bool Execute(const std::string& Sql);
+
+    void WriteThreadEntry();
+    void CheckpointThreadEntry();
+
+    struct QueuedWrite
+    {
+        WriteOperation Operation;
+        WriteCallback Callback;
+    };
+
+    struct CompletedWrite
+    {
+        WriteCallback Callback;
+        bool Success;
+    };
+
+    // Runs a range of queued writes in a single transaction on the write connection. Results is only
+    // meaningful if the transaction was committed.
+    bool RunWriteTransaction(std::vector<QueuedWrite>& Writes, size_t Start, size_t Count, std::vector<bool>& Results);
+
+    // Runs the delete for RemoveOwnBloodMessage, Removed is set if a row was actually deleted.
+    bool DeleteOwnBloodMessage(uint32_t PlayerId, uint32_t MessageId, bool& Removed);
+
+    // Statements are prepared the first time their sql is run and then reused for the lifetime of the
+    // database connection, so sql should always use parameters rather than having values formatted into it.
+    struct PreparedStatement
+    {
+        std::string Sql;
+        sqlite3_stmt* Statement = nullptr;
+
+        // Set while the statement is being stepped, if the same sql is run from inside a row callback
+        // a temporary statement is prepared for it instead.
+        bool InUse = false;
+
+        std::unique_ptr<DebugTimer> Timer;
+        std::unique_ptr<DebugCounter> Calls;
+    };
+
+    PreparedStatement* FindOrPrepareStatement(std::string_view sql);
+
+    void FinalizeStatements();
+
     sqlite3* db_handle = nullptr;
 
+    // Held while running a statement, read-only connections are shared between threads. Callers that read
+    // sqlite3_changes or sqlite3_last_insert_rowid after a statement also hold it until they have done so.
+    std::recursive_mutex StatementMutex;
+
+    // Debug statistics are only safe to touch from the main thread, so this is cleared on the write thread's connection.
+    bool TrackStatistics = true;
+
+    bool WriteBehind = false;
+    std::chrono::steady_clock::duration CommitInterval;
+    size_t CommitMaxOperations = 0;
+
+    // Connection used by the write thread, only exists if write-behind is enabled.
+    std::unique_ptr<ServerDatabase> WriteConnection;
+    std::thread WriteThread;
+
+    std::mutex WriteMutex;
+    std::condition_variable WriteCvar;
+    std::vector<QueuedWrite> WriteQueue;
+    std::chrono::steady_clock::time_point WriteQueueStartTime;
+    size_t WriteBatchSize = 0;
+    bool WriteThreadQuit = false;
+
+    // Results from the write thread waiting to be picked up by Poll.
+    std::vector<CompletedWrite> CompletedWrites;
+    std::vector<double> CommitTimes;
+    size_t WritesCommitted = 0;
+
+    // When the journal is in WAL mode, checkpoints are run periodically on their own thread and connection 
+    // rather than by whichever connection happens to commit when the log gets large.
+    sqlite3* CheckpointHandle = nullptr;
+    std::thread CheckpointThread;
+    std::mutex CheckpointMutex;
+    std::condition_variable CheckpointCvar;
+    std::chrono::steady_clock::duration CheckpointInterval;
+    bool CheckpointThreadQuit = false;
+
+    // Ids handed out to rows created by queued writes.
+    uint32_t NextBloodMessageId = 0;
+    uint32_t NextBloodstainId = 0;
+    uint32_t NextGhostId = 0;
+    uint32_t NextRankingId = 0;
+
+    std::unordered_map<uint32_t, RankingBoard> RankingBoards;
+
+    // How long (in milliseconds) a connection waits for the other to release its lock before a statement fails.
+    static inline constexpr int k_busy_timeout_ms = 5000;
+
+    // Number of times a batch of queued writes is tried before its writes are committed one at a time, and
+    // the delay (in seconds) before the first retry, which doubles with each attempt.
+    static inline constexpr int k_max_commit_attempts = 4;
+    static inline constexpr double k_commit_retry_delay = 0.1;
+
+    // Keyed by views of each statement's own Sql.
+    std::unordered_map<std::string_view, std::unique_ptr<PreparedStatement>> Statements;
+
 };
\ No newline at end of file
@@ -40,6 +40,6 @@ public:
     virtual void GetStatistics(GameService& Service, std::unordered_map<std::string, std::string>& Stats) = 0;
 
     // Messages
-    virtual void SendManagementMessage(Frpg2ReliableUdpMessageStream& stream, const std::string& TextMessage) = 0;
+    virtual void SendManagementMessage(GameService& Service, const std::vector<std::shared_ptr<GameClient>>& Clients, const std::string& TextMessage) = 0;
 
 };
\ No newline at end of file
@@ -34,6 +34,8 @@ GameClient::GameClient(GameService* OwningService, std::shared_ptr<NetConnection
     LastMessageRecievedTime = GetSeconds();
 
     MessageStream = std::make_shared<Frpg2ReliableUdpMessageStream>(InConnection, CwcKey, AuthToken, false, &Service->GetServer()->GetGameInterface());
+    MessageStream->SetAckDelay(Service->GetServer()->GetConfig().GameServerAckDelay);
+    MessageStream->SetParallelIngress(Service->GetServer()->GetConfig().GameServerParallelIngress);
 
     State = Service->GetServer()->GetGameInterface().CreatePlayerState();
 }
@@ -108,25 +110,8 @@ bool GameClient::HandleMessage(const Frpg2ReliableUdpMessage& Message)
 {
     //WarningS(GetName().c_str(), "-> %s", Message.Protobuf->GetTypeName().c_str());
 
-    const std::vector<std::shared_ptr<GameManager>>& Managers = Service->GetManagers();
-    for (auto& Manager : Managers)
-    {
-        MessageHandleResult Result = Manager->OnMessageRecieved(this, Message);
-        if (Result == MessageHandleResult::Error)
-        {
-            return true;
-        }
-        else if (Result == MessageHandleResult::Handled)
-        {
-            return false;
-        }
-        else if (Result == MessageHandleResult::Unhandled)
-        {
-            // Continue;
-        }
-    }
-
-    return true;
+    MessageHandleResult Result = Service->GetMessageDispatchTable().Dispatch(this, Message);
+    return Result != MessageHandleResult::Handled;
 }
 
 std::string GameClient::GetName()
@@ -136,5 +121,5 @@ std::string GameClient::GetName()
 
 void GameClient::SendTextMessage(const std::string& TextMessage)
 {
-    Service->GetServer()->GetGameInterface().SendManagementMessage(*MessageStream, TextMessage);
+    Service->GetServer()->GetGameInterface().SendManagementMessage(*Service, { shared_from_this() }, TextMessage);
 }
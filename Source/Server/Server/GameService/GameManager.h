@@ -12,6 +12,7 @@
 #include <string>
 
 class GameClient;
+class MessageDispatchTable;
 struct Frpg2ReliableUdpMessage;
 
 enum class MessageHandleResult
@@ -45,9 +46,9 @@ public:
     // Called when we have a lost a player previously registered with OnGainPlayer.
     virtual void OnLostPlayer(GameClient* Client) { };
 
-    // Called when a game client recieves a message.
-    // Returns true if an error occured and the client should be disconnected.
-    virtual MessageHandleResult OnMessageRecieved(GameClient* Client, const Frpg2ReliableUdpMessage& Message) { return MessageHandleResult::Unhandled; }
+    // Called before Init to register handlers for each type of message the manager deals with. Handlers
+    // should return Error if the client should be disconnected.
+    virtual void RegisterMessageHandlers(MessageDispatchTable& Table) { };
 
     // Returns a general descriptive name of the manager for logging.
     virtual std::string GetName() = 0;
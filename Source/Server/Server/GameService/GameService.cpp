@@ -24,6 +24,9 @@
 #include "Config/BuildConfig.h"
 #include "Config/RuntimeConfig.h"
 
+#include <thread>
+#include <algorithm>
+
 GameService::GameService(Server* OwningServer, RSAKeyPair* InServerRSAKey)
     : ServerInstance(OwningServer)
     , ServerRSAKey(InServerRSAKey)
@@ -43,18 +46,46 @@ bool GameService::Init()
 {
     ServerInstance->GetGameInterface().RegisterGameManagers(*this);
 
-    Connection = std::make_shared<NetConnectionUDP>("Game Service");
-    int Port = ServerInstance->GetConfig().GameServerPort;
-    if (!Connection->Listen(Port))
+    const RuntimeConfig& Config = ServerInstance->GetConfig();
+
+    int ShardCount = Config.GameServerShardCount;
+    if (ShardCount <= 0)
     {
-        Error("Game service failed to listen on port %i.", Port);
-        return false;
+        ShardCount = std::max(1, (int)std::thread::hardware_concurrency());
     }
 
-    Log("Game service is now listening on port %i.", Port);
+#if !defined(__linux__)
+    if (ShardCount > 1)
+    {
+        Warning("Game service sharding is only supported on linux, falling back to a single shard.");
+        ShardCount = 1;
+    }
+#endif
+
+    int Port = Config.GameServerPort;
+    for (int i = 0; i < ShardCount; i++)
+    {
+        std::string Name = (ShardCount > 1 ? StringFormat("Game Service (Shard %i)", i) : "Game Service");
+
+        std::shared_ptr<NetConnectionUDP> Connection = std::make_shared<NetConnectionUDP>(Name);
+        Connection->SetBatchedIO(Config.GameServerBatchedIO, Config.GameServerBatchSize);
+        Connection->SetReusePort(ShardCount > 1);
+
+        if (!Connection->Listen(Port))
+        {
+            Error("Game service failed to listen on port %i.", Port);
+            return false;
+        }
+
+        Connections.push_back(Connection);
+    }
+
+    Log("Game service is now listening on port %i (%i shards).", Port, ShardCount);
 
     for (auto& Manager : Managers)
     {
+        Manager->RegisterMessageHandlers(MessageDispatch);
+
         if (!Manager->Init())
         {
             Error("Failed to initialize game manager '%s'", Manager->GetName().c_str());
@@ -99,16 +130,22 @@ void GameService::Poll()
 {
     DebugTimerScope Scope(Debug::GameService_PollTime);
 
-    Connection->Pump();
+    for (auto& Connection : Connections)
+    {
+        Connection->Pump();
+    }
 
     for (auto& Manager : Managers)
     {
         Manager->Poll();
     }
 
-    while (std::shared_ptr<NetConnection> ClientConnection = Connection->Accept())
+    for (auto& Connection : Connections)
     {
-        HandleClientConnection(ClientConnection);
+        while (std::shared_ptr<NetConnection> ClientConnection = Connection->Accept())
+        {
+            HandleClientConnection(ClientConnection);
+        }
     }
 
     if (GetSeconds() > NextDatabaseTrim)
@@ -225,7 +262,7 @@ std::string GameService::GetName()
 
 void GameService::CreateAuthToken(uint64_t AuthToken, const std::vector<uint8_t>& CwcKey)
 {
-    VerboseS(Connection->GetName().c_str(), "Created authentication token 0x%016llx", AuthToken);
+    VerboseS(Connections[0]->GetName().c_str(), "Created authentication token 0x%016llx", AuthToken);
 
     GameClientAuthenticationState AuthState;
     AuthState.AuthToken = AuthToken;
@@ -269,6 +306,37 @@ std::shared_ptr<GameClient> GameService::FindClientBySteamId(const std::string&
     return nullptr;
 }
 
+bool GameService::SendToClients(const std::vector<std::shared_ptr<GameClient>>& Targets, google::protobuf::MessageLite* Message)
+{
+    if (Targets.empty())
+    {
+        return true;
+    }
+
+    bool Success = true;
+
+    // Prepared payloads are always sent as push messages, anything else has to be sent individually.
+    Frpg2ReliableUdpMessageType Type;
+    std::shared_ptr<const Frpg2PreparedPayload> Prepared;
+    if (ServerInstance->GetGameInterface().Protobuf_To_ReliableUdpMessageType(Message, Type) && 
+        Type == Frpg2ReliableUdpMessageType::Push)
+    {
+        Prepared = Frpg2ReliableUdpMessageStream::PrepareProtobuf(Message);
+    }
+
+    for (const std::shared_ptr<GameClient>& Client : Targets)
+    {
+        bool Sent = Prepared ? Client->MessageStream->SendPrepared({ Prepared }) : Client->MessageStream->Send(Message);
+        if (!Sent)
+        {
+            WarningS(Client->GetName().c_str(), "Failed to send %s.", Message->GetTypeName().c_str());
+            Success = false;
+        }
+    }
+
+    return Success;
+}
+
 std::vector<std::shared_ptr<GameClient>> GameService::FindClients(std::function<bool(const std::shared_ptr<GameClient>&)> Predicate)
 {
     std::vector<std::shared_ptr<GameClient>> Result;
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "Server/Service.h"
+#include "Server/GameService/MessageDispatchTable.h"
 
 #include <memory>
 #include <vector>
@@ -61,6 +62,8 @@ public:
 
     void RegisterManager(std::shared_ptr<GameManager> Manager);
 
+    MessageDispatchTable& GetMessageDispatchTable() { return MessageDispatch; }
+
     template <typename T>
     std::shared_ptr<T> GetManager()
     {
@@ -84,6 +87,11 @@ public:
     std::vector<std::shared_ptr<GameClient>> FindClients(std::function<bool(const std::shared_ptr<GameClient>&)> Predicate);
     std::vector<std::shared_ptr<GameClient>> GetClients() { return Clients; }
 
+    // Sends the same push message to all the given clients. The message is serialized (and compressed if
+    // above the compression threshold) once, only the framing and encryption is done for each client. 
+    // Failures are logged against the client, returns false if sending to any of them failed.
+    bool SendToClients(const std::vector<std::shared_ptr<GameClient>>& Targets, google::protobuf::MessageLite* Message);
+
 protected:
 
     void HandleClientConnection(std::shared_ptr<NetConnection> ClientConnection);
@@ -93,13 +101,17 @@ protected:
 private:
     Server* ServerInstance;
 
-    std::shared_ptr<NetConnectionUDP> Connection;
+    // Listening connections for the game port. There is normally only one of these, but 
+    // multiple are created when sharding with SO_REUSEPORT (see GameServerShardCount).
+    std::vector<std::shared_ptr<NetConnectionUDP>> Connections;
 
     std::vector<std::shared_ptr<GameClient>> Clients;
     std::vector<std::shared_ptr<GameClient>> DisconnectingClients;
 
     std::vector<std::shared_ptr<GameManager>> Managers;
 
+    MessageDispatchTable MessageDispatch;
+
     std::unordered_map<uint64_t, GameClientAuthenticationState> AuthenticationStates;
 
     RSAKeyPair* ServerRSAKey;
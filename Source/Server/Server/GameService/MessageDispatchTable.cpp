@@ -0,0 +1,110 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#include "Server/GameService/MessageDispatchTable.h"
+
+#include "Shared/Platform/Platform.h"
+#include "Shared/Core/Utils/Logging.h"
+#include "Shared/Core/Utils/Strings.h"
+
+#include <algorithm>
+
+bool MessageDispatchTable::Register(Frpg2ReliableUdpMessageType Type, GameManager* Manager, HandlerFunction_t Handler)
+{
+    size_t Index = (size_t)Type;
+    if (Index >= Entries.size())
+    {
+        Entries.resize(Index + 1);
+    }
+
+    Entry& Slot = Entries[Index];
+    if (Slot.Handler)
+    {
+        Warning("Game manager '%s' attempted to register handler for message type 0x%04x, but its already handled by '%s'.", 
+            Manager->GetName().c_str(), (int)Type, Slot.Manager->GetName().c_str());
+        return false;
+    }
+
+    Slot.Manager = Manager;
+    Slot.Handler = std::move(Handler);
+    Slot.Statistics.Type = Type;
+
+    return true;
+}
+
+MessageHandleResult MessageDispatchTable::Dispatch(GameClient* Client, const Frpg2ReliableUdpMessage& Message)
+{
+    size_t Index = (size_t)Message.Header.msg_type;
+    if (Index >= Entries.size() || !Entries[Index].Handler)
+    {
+        return MessageHandleResult::Unhandled;
+    }
+
+    Entry& Slot = Entries[Index];
+
+    double StartTime = GetHighResolutionSeconds();
+    MessageHandleResult Result = Slot.Handler(Client, Message);
+    double ElapsedTime = GetHighResolutionSeconds() - StartTime;
+
+    MessageStatistics& Stats = Slot.Statistics;
+    if (Stats.Name.empty() && Message.Protobuf)
+    {
+        // Drop the package name, its the same for everything.
+        Stats.Name = Message.Protobuf->GetTypeName();
+        if (size_t Offset = Stats.Name.find_last_of('.'); Offset != std::string::npos)
+        {
+            Stats.Name = Stats.Name.substr(Offset + 1);
+        }
+    }
+
+    Stats.Calls++;
+    Stats.TotalTime += ElapsedTime;
+    Stats.PeakTime = std::max(Stats.PeakTime, ElapsedTime);
+
+    if (Result == MessageHandleResult::Error)
+    {
+        Stats.Errors++;
+    }
+
+    size_t Bucket = std::upper_bound(k_latency_buckets.begin(), k_latency_buckets.end(), ElapsedTime) - k_latency_buckets.begin();
+    Stats.LatencyHistogram[Bucket]++;
+
+    return Result;
+}
+
+std::vector<MessageDispatchTable::MessageStatistics> MessageDispatchTable::GetStatistics()
+{
+    std::vector<MessageStatistics> Result;
+
+    for (Entry& Slot : Entries)
+    {
+        if (Slot.Statistics.Calls > 0)
+        {
+            Result.push_back(Slot.Statistics);
+        }
+    }
+
+    return Result;
+}
+
+std::string MessageDispatchTable::GetLatencyBucketName(size_t Index)
+{
+    auto FormatTime = [](double Seconds) {
+        return Seconds < 0.001 ? StringFormat("%.0f us", Seconds * 1000000.0) : StringFormat("%.0f ms", Seconds * 1000.0);
+    };
+
+    if (Index < k_latency_buckets.size())
+    {
+        return "< " + FormatTime(k_latency_buckets[Index]);
+    }
+    else
+    {
+        return ">= " + FormatTime(k_latency_buckets.back());
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "Server/GameService/GameManager.h"
+#include "Server/Streams/Frpg2ReliableUdpMessage.h"
+
+#include <array>
+#include <vector>
+#include <string>
+#include <functional>
+
+class GameClient;
+
+// Maps each message type to the game manager handler responsible for it. Managers register
+// their handlers in RegisterMessageHandlers, and incoming messages are then dispatched
+// with a single lookup rather than asking each manager in turn.
+//
+// Also keeps track of how often each message is handled and how long it takes, which is 
+// shown on the web ui's debug page.
+
+class MessageDispatchTable
+{
+public:
+    using HandlerFunction_t = std::function<MessageHandleResult(GameClient* Client, const Frpg2ReliableUdpMessage& Message)>;
+
+    // Upper bound (in seconds) of each bucket in the latency histograms, the last bucket catches everything else.
+    static inline constexpr std::array<double, 9> k_latency_buckets = {
+        0.00001, 0.00005, 0.0001, 0.0005, 0.001, 0.005, 0.01, 0.05, 0.1
+    };
+
+    static inline constexpr size_t k_latency_bucket_count = k_latency_buckets.size() + 1;
+
+    struct MessageStatistics
+    {
+        // Name of the protobuf recieved with the message, filled in the first time its handled.
+        std::string Name;
+
+        Frpg2ReliableUdpMessageType Type;
+
+        size_t Calls = 0;
+        size_t Errors = 0;
+
+        double TotalTime = 0.0;
+        double PeakTime = 0.0;
+
+        std::array<size_t, k_latency_bucket_count> LatencyHistogram = {};
+    };
+
+    // Registers the handler for a given message type, only one handler can be registered for each type.
+    bool Register(Frpg2ReliableUdpMessageType Type, GameManager* Manager, HandlerFunction_t Handler);
+
+    // Short hand for registering a manager's member function as a handler.
+    template <typename TypeEnum, typename ManagerType>
+    bool Register(TypeEnum Type, ManagerType* Manager, MessageHandleResult(ManagerType::*Handler)(GameClient* Client, const Frpg2ReliableUdpMessage& Message))
+    {
+        return Register((Frpg2ReliableUdpMessageType)(int)Type, Manager, [Manager, Handler](GameClient* Client, const Frpg2ReliableUdpMessage& Message) {
+            return (Manager->*Handler)(Client, Message);
+        });
+    }
+
+    // Passes the message to the handler registered for its type. Returns Unhandled if there is none.
+    MessageHandleResult Dispatch(GameClient* Client, const Frpg2ReliableUdpMessage& Message);
+
+    // Gets statistics for every message type that has been handled at least once.
+    std::vector<MessageStatistics> GetStatistics();
+
+    // Human readable label for a latency histogram bucket.
+    static std::string GetLatencyBucketName(size_t Index);
+
+private:
+
+    struct Entry
+    {
+        GameManager* Manager = nullptr;
+        HandlerFunction_t Handler;
+        MessageStatistics Statistics;
+    };
+
+    // Indexed by message type, which are small enough that this doesn't need to be sparse.
+    std::vector<Entry> Entries;
+
+};
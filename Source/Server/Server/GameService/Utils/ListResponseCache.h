@@ -0,0 +1,236 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "Server/Streams/Frpg2ReliableUdpFragment.h"
+#include "Server/GameService/Utils/OnlineAreaPool.h"
+
+#include "Shared/Platform/Platform.h"
+#include "Shared/Core/Utils/DebugObjects.h"
+
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <limits>
+
+// Caches the serialized and compressed responses to list requests (blood messages, bloodstains,
+// ghosts, etc) built from an OnlineAreaPool. Busy areas get asked for these by lots of clients at
+// once, without this each one would be built, serialized and compressed from scratch.
+//
+// Two levels of caching are done:
+//  - Each entry's serialized form is kept until its invalidated or dropped from the pool.
+//  - Each area's random selection of entries is kept, serialized and compressed, for a short time
+//    (see SetTimeout). Every client asking for that area in that time gets the same selection.
+//
+// The serialize function should write out a response containing only the entry given. As protobuf
+// merges repeated fields, concatenating these gives the serialized form of a response containing all
+// of the entries. Any other fields the response needs can be serialized separately and sent as
+// another part alongside these (see Frpg2ReliableUdpMessageStream::SendPrepared).
+
+template <typename IdType, typename ValueType>
+class ListResponseCache
+{
+public:
+    using SerializeFunction_t = std::function<bool(const ValueType& Value, std::vector<uint8_t>& Output)>;
+
+    ListResponseCache(SerializeFunction_t InSerializeFunction)
+        : SerializeFunction(InSerializeFunction)
+    {
+    }
+
+    // How long (in seconds) an area's selection is reused for. 0 builds a new selection for every request.
+    void SetTimeout(double Seconds)
+    {
+        Timeout = Seconds;
+    }
+
+    // Returns a payload containing up to MaxCount random entries from the given area, or nullptr if it
+    // failed to be built. EntryCount is set to the number of entries in the payload.
+    std::shared_ptr<const Frpg2PreparedPayload> GetRandomSet(OnlineAreaPool<IdType, ValueType>& Pool, IdType AreaId, int MaxCount, int& EntryCount)
+    {
+        return GetSnapshot(AreaId, MaxCount, EntryCount, [&Pool, AreaId, MaxCount]() {
+            return Pool.GetRandomSet(AreaId, MaxCount);
+        });
+    }
+
+    // Same as above, but selects from every area in the pool that passes the filter. The selection is
+    // cached under SelectionId, which should uniquely identify the filter and be what is passed to
+    // InvalidateArea when the entries it could contain change.
+    std::shared_ptr<const Frpg2PreparedPayload> GetRandomSet(OnlineAreaPool<IdType, ValueType>& Pool, IdType SelectionId, int MaxCount, typename OnlineAreaPool<IdType, ValueType>::AreaFilterFunction_t Filter, int& EntryCount)
+    {
+        return GetSnapshot(SelectionId, MaxCount, EntryCount, [&Pool, &Filter, MaxCount]() {
+            return Pool.GetRandomSet(MaxCount, Filter);
+        });
+    }
+
+    // Should be called whenever an entry is modified so its not served stale.
+    void Invalidate(IdType AreaId, const std::shared_ptr<ValueType>& Value)
+    {
+        Entries.erase(Value.get());
+        InvalidateArea(AreaId);
+    }
+
+    // Should be called whenever entries are removed from an area so they stop being handed out
+    // straight away. New entries just show up once the area's selection times out.
+    void InvalidateArea(IdType AreaId)
+    {
+        auto Start = AreaSnapshots.lower_bound({ AreaId, std::numeric_limits<int>::min() });
+        auto End = AreaSnapshots.upper_bound({ AreaId, std::numeric_limits<int>::max() });
+        AreaSnapshots.erase(Start, End);
+    }
+
+    // Drops expired selections and entries that no longer exist. Should be called regularly.
+    void Poll()
+    {
+        double CurrentTime = GetSeconds();
+        if (CurrentTime - LastTrimTime < k_trim_interval)
+        {
+            return;
+        }
+        LastTrimTime = CurrentTime;
+
+        for (auto Iter = AreaSnapshots.begin(); Iter != AreaSnapshots.end(); )
+        {
+            if (CurrentTime - Iter->second.CreateTime >= Timeout)
+            {
+                Iter = AreaSnapshots.erase(Iter);
+            }
+            else
+            {
+                Iter++;
+            }
+        }
+
+        for (auto Iter = Entries.begin(); Iter != Entries.end(); )
+        {
+            if (Iter->second.Value.expired())
+            {
+                Iter = Entries.erase(Iter);
+            }
+            else
+            {
+                Iter++;
+            }
+        }
+    }
+
+private:
+
+    std::shared_ptr<const Frpg2PreparedPayload> GetSnapshot(IdType AreaId, int MaxCount, int& EntryCount, std::function<std::vector<std::shared_ptr<ValueType>>()> SelectFunction)
+    {
+        double CurrentTime = GetSeconds();
+
+        AreaSnapshotKey Key = { AreaId, MaxCount };
+        if (auto Iter = AreaSnapshots.find(Key); Iter != AreaSnapshots.end())
+        {
+            if (CurrentTime - Iter->second.CreateTime < Timeout)
+            {
+                Debug::ListResponseCacheHits.Add(1);
+
+                EntryCount = Iter->second.EntryCount;
+                return Iter->second.Payload;
+            }
+        }
+
+        Debug::ListResponseCacheMisses.Add(1);
+
+        std::vector<std::shared_ptr<ValueType>> Values = SelectFunction();
+
+        std::vector<uint8_t> Payload;
+        for (const std::shared_ptr<ValueType>& Value : Values)
+        {
+            const std::vector<uint8_t>* Serialized = GetSerializedEntry(Value);
+            if (Serialized == nullptr)
+            {
+                return nullptr;
+            }
+
+            Payload.insert(Payload.end(), Serialized->begin(), Serialized->end());
+        }
+
+        std::shared_ptr<Frpg2PreparedPayload> Result = Frpg2PreparedPayload::Create(std::move(Payload));
+        if (!Result)
+        {
+            return nullptr;
+        }
+
+        if (Timeout > 0.0)
+        {
+            AreaSnapshot& Snapshot = AreaSnapshots[Key];
+            Snapshot.Payload = Result;
+            Snapshot.EntryCount = (int)Values.size();
+            Snapshot.CreateTime = CurrentTime;
+        }
+
+        EntryCount = (int)Values.size();
+        return Result;
+    }
+
+    const std::vector<uint8_t>* GetSerializedEntry(const std::shared_ptr<ValueType>& Value)
+    {
+        // Entries are keyed by address, the weak pointer makes sure we don't return a stale entry
+        // if the original has been freed and the address reused.
+        if (auto Iter = Entries.find(Value.get()); Iter != Entries.end())
+        {
+            if (Iter->second.Value.lock() == Value)
+            {
+                Debug::ListResponseCacheEntryHits.Add(1);
+                return &Iter->second.Data;
+            }
+        }
+
+        Debug::ListResponseCacheEntryMisses.Add(1);
+
+        SerializedEntry& Entry = Entries[Value.get()];
+        Entry.Value = Value;
+        Entry.Data.clear();
+
+        if (!SerializeFunction(*Value, Entry.Data))
+        {
+            Entries.erase(Value.get());
+            return nullptr;
+        }
+
+        return &Entry.Data;
+    }
+
+private:
+
+    struct SerializedEntry
+    {
+        std::weak_ptr<ValueType> Value;
+        std::vector<uint8_t> Data;
+    };
+
+    struct AreaSnapshot
+    {
+        std::shared_ptr<const Frpg2PreparedPayload> Payload;
+        int EntryCount = 0;
+        double CreateTime = 0.0;
+    };
+
+    // Area (or selection) and maximum number of entries requested. Ordered so all of an area's
+    // snapshots can be found by InvalidateArea, IdType needs an operator< for this.
+    using AreaSnapshotKey = std::pair<IdType, int>;
+
+    SerializeFunction_t SerializeFunction;
+
+    std::unordered_map<const ValueType*, SerializedEntry> Entries;
+    std::map<AreaSnapshotKey, AreaSnapshot> AreaSnapshots;
+
+    double Timeout = 1.0;
+    double LastTrimTime = 0.0;
+
+    // How often (in seconds) expired selections and entries are purged.
+    static inline constexpr double k_trim_interval = 10.0;
+
+};
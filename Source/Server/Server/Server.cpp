@@ -288,12 +288,29 @@ bool Server::Init()
     }
 
     // Open connection to our database.
-    if (!Database.Open(DatabasePath))
+    DatabaseSettings Settings;
+    Settings.WriteBehind = Config.DatabaseWriteBehind;
+    Settings.CommitInterval = Config.DatabaseCommitInterval;
+    Settings.CommitMaxOperations = (size_t)std::max(Config.DatabaseCommitMaxOperations, 1);
+    Settings.JournalMode = Config.DatabaseJournalMode;
+    Settings.Synchronous = Config.DatabaseSynchronous;
+    Settings.TempStore = Config.DatabaseTempStore;
+    Settings.CacheSizeKb = Config.DatabaseCacheSizeKb;
+    Settings.MmapSizeMb = Config.DatabaseMmapSizeMb;
+    Settings.CheckpointInterval = Config.DatabaseCheckpointInterval;
+
+    if (!Database.Open(DatabasePath, Settings))
     {
         Error("Failed to open database at '%s'.", DatabasePath.string().c_str());
         return false;
     }
 
+    if (!ReadOnlyDatabase.OpenReadOnly(DatabasePath, Settings))
+    {
+        Error("Failed to open read-only database connection at '%s'.", DatabasePath.string().c_str());
+        return false;
+    }
+
     // Initialize all our services.
     for (auto& Service : Services)
     {
@@ -334,7 +351,7 @@ bool Server::Term()
         }
     }
 
-    if (!Database.Close())
+    if (!ReadOnlyDatabase.Close() || !Database.Close())
     {
         Error("Failed to close database.");
         return false;
@@ -486,6 +503,8 @@ void Server::Poll()
             Service->Poll();
         }
 
+        Database.Poll();
+
         PollDiscordNotices();
         PollServerAdvertisement();
     }
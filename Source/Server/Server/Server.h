@@ -69,6 +69,10 @@ public:
     RuntimeConfig& GetMutableConfig()   { return Config; }
     ServerDatabase& GetDatabase()       { return Database; }
 
+    // Read-only connection to the database that can be used from any thread, for queries that
+    // don't need to be on the main thread (eg. from the WebUI).
+    ServerDatabase& GetReadOnlyDatabase() { return ReadOnlyDatabase; }
+
     NetIPAddress GetPublicIP()          { return PublicIP; }
     NetIPAddress GetPrivateIP()         { return PrivateIP; }
 
@@ -142,6 +146,7 @@ private:
     ServerManager* Manager;
 
     ServerDatabase Database;
+    ServerDatabase ReadOnlyDatabase;
 
     double NextKeepAliveTime = 0.0;
 
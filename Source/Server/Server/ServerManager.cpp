@@ -10,6 +10,8 @@
 #include "Server/ServerManager.h"
 #include "Server/Server.h"
 #include "Config/BuildConfig.h"
+#include "Shared/Core/Network/NetEventLoop.h"
+#include "Shared/Core/Network/NetReactor.h"
 #include "Shared/Core/Utils/Logging.h"
 #include "Shared/Core/Utils/File.h"
 #include "Shared/Core/Utils/Strings.h"
@@ -17,10 +19,12 @@
 #include "Shared/Core/Utils/DebugCounter.h"
 #include "Shared/Core/Utils/DebugObjects.h"
 #include "Shared/Core/Utils/DebugTimer.h"
+#include "Shared/Core/Utils/WorkerPool.h"
 
 #include <thread>
 #include <chrono>
 #include <fstream>
+#include <algorithm>
 
 ServerManager::ServerManager()
 {
@@ -28,6 +32,7 @@ ServerManager::ServerManager()
     CtrlSignalHandle = PlatformEvents::OnCtrlSignal.Register([=]() {
         Warning("Quit signal recieved, starting shutdown.");        
         QuitRecieved = true;
+        NetEventLoop::Get().Wake();
     });
 }
 
@@ -40,6 +45,17 @@ bool ServerManager::Init()
 {
     Log("Initializing server manager ...");
 
+    // Start the network threads before any servers, so all their sockets get shared between them.
+    if (!NetReactor::Get().Start(BuildConfig::NETWORK_THREAD_COUNT))
+    {
+        Warning("Network threads are not supported on this platform, each connection will use its own threads.");
+    }
+
+    if (!WorkerPool::Get().Start(BuildConfig::WORKER_THREAD_COUNT))
+    {
+        Warning("Failed to start worker threads, incoming packets will be processed on the main thread.");
+    }
+
     // Bring up all the servers that we have configuration for.
     SavedPath = std::filesystem::current_path() / std::filesystem::path("Saved");
 
@@ -83,6 +99,9 @@ bool ServerManager::Term()
         Success |= StopServer(Id);
     }
 
+    WorkerPool::Get().Stop();
+    NetReactor::Get().Stop();
+
     return Success;
 }
 
@@ -90,10 +109,11 @@ void ServerManager::RunUntilQuit()
 {
     Success("Server manager is now running.");
 
-    // We should really do this event driven ...
-    // This suffices for now.
     while (!QuitRecieved)
     {
+        // Sleep until there is something to do, see NetEventLoop for what can wake us.
+        NetEventLoop::Get().Wait(BuildConfig::SERVER_MANAGER_MAX_WAIT_TIME);
+
         std::scoped_lock lock(m_mutex);
 
         {
@@ -131,7 +151,10 @@ void ServerManager::RunUntilQuit()
                 PlayerCount += Server->GetService<GameService>()->GetClients().size();
             }
 
-            WriteLog(true, ConsoleColor::Grey, "", "Log", "%zi players | %zi servers | %.2f ms update | connections auth %.2f login %.2f game %.2f p/s | tcp in %.2f out %.2f kb/s | udp in %.2f out %.2f kb/s | database queries %.2f p/s ",
+            double UdpRecieveBatchSize = Debug::UdpDatagramsRecieved.GetAverageRate() / std::max(1.0, Debug::UdpRecieveBatches.GetAverageRate());
+            double UdpSendBatchSize = Debug::UdpDatagramsSent.GetAverageRate() / std::max(1.0, Debug::UdpSendBatches.GetAverageRate());
+
+            WriteLog(true, ConsoleColor::Grey, "", "Log", "%zi players | %zi servers | %.2f ms update | connections auth %.2f login %.2f game %.2f p/s | tcp in %.2f out %.2f kb/s | udp in %.2f out %.2f kb/s | udp batch in %.1f out %.1f | database queries %.2f p/s ",
                 PlayerCount,
                 ServerInstances.size(),
                 Debug::AllServerUpdateTime.GetAverage() * 1000.0f,
@@ -142,6 +165,8 @@ void ServerManager::RunUntilQuit()
                 (Debug::TcpBytesSent.GetAverageRate()) / 1024.0f,
                 (Debug::UdpBytesRecieved.GetAverageRate()) / 1024.0f,
                 (Debug::UdpBytesSent.GetAverageRate()) / 1024.0f,
+                UdpRecieveBatchSize,
+                UdpSendBatchSize,
                 Debug::DatabaseQueries.GetAverageRate()
             );
 
@@ -150,8 +175,7 @@ void ServerManager::RunUntilQuit()
 
         DebugCounter::PollAll();
         DebugTimer::PollAll();
-
-        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        DebugGauge::PollAll();
     }
 }
 
@@ -165,9 +189,13 @@ bool ServerManager::NewServer(const std::string& Name, const std::string& Passwo
 
 void ServerManager::QueueCallback(std::function<void()> callback)
 {
-    std::scoped_lock lock(CallbackMutex);
+    {
+        std::scoped_lock lock(CallbackMutex);
+
+        Callbacks.push_back(callback);
+    }
 
-    Callbacks.push_back(callback);
+    NetEventLoop::Get().Wake();
 }
 
 bool ServerManager::StartServer(const std::string& ServerId, const std::string& Name, const std::string& Password, GameType InGameType)
@@ -0,0 +1,98 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "Shared/Core/Utils/DebugObjects.h"
+
+#include <vector>
+#include <memory>
+#include <mutex>
+
+// Recycles protobuf objects of a single type. Every request we recieve and most responses we send
+// are built into a fresh protobuf, each of which allocates its strings, sub-messages and repeated
+// fields as it gets filled in. Clearing a protobuf keeps all of that storage around, so handing out
+// previously used (and cleared) objects means that once the pool has warmed up building a message
+// mostly reuses memory from the last message of the same type rather than going to the allocator.
+//
+// Objects are returned to the pool when the last reference to them is released, which can be on any
+// thread. In practice requests are released at the end of the game service tick that handled them
+// and responses as soon as the handler that built them returns.
+
+template <typename ProtobufClass>
+class Frpg2ProtobufPool
+{
+public:
+
+    static std::shared_ptr<ProtobufClass> Acquire()
+    {
+        return Get().AcquireInternal();
+    }
+
+private:
+
+    static Frpg2ProtobufPool& Get()
+    {
+        // Intentionally leaked, objects can still be released back to the pool during static destruction.
+        static Frpg2ProtobufPool* Instance = new Frpg2ProtobufPool();
+        return *Instance;
+    }
+
+    std::shared_ptr<ProtobufClass> AcquireInternal()
+    {
+        ProtobufClass* Protobuf = nullptr;
+        {
+            std::scoped_lock lock(Mutex);
+
+            if (FreeList.empty())
+            {
+                Debug::ProtobufPoolAllocations.Add(1);
+            }
+            else
+            {
+                Protobuf = FreeList.back().release();
+                FreeList.pop_back();
+            }
+        }
+
+        if (Protobuf == nullptr)
+        {
+            Protobuf = new ProtobufClass();
+        }
+
+        return std::shared_ptr<ProtobufClass>(Protobuf, [this](ProtobufClass* Protobuf) {
+            Release(Protobuf);
+        });
+    }
+
+    void Release(ProtobufClass* Protobuf)
+    {
+        Protobuf->Clear();
+
+        {
+            std::scoped_lock lock(Mutex);
+
+            if (FreeList.size() < k_max_free_objects)
+            {
+                FreeList.emplace_back(Protobuf);
+                return;
+            }
+        }
+
+        delete Protobuf;
+    }
+
+    std::mutex Mutex;
+    std::vector<std::unique_ptr<ProtobufClass>> FreeList;
+
+    // Maximum number of unused objects kept around. Each of these holds onto the storage of the
+    // largest message it was used for, so this stops a burst of traffic pinning lots of memory.
+    static inline constexpr size_t k_max_free_objects = 64;
+
+};
@@ -10,8 +10,10 @@
 #pragma once
 
 #include "Shared/Core/Utils/Endian.h"
+#include "Shared/Core/Utils/Compression.h"
 
 #include <vector>
+#include <memory>
 
 // See ds3server_packet.bt for commentry on what each of these
 // fields appears to represent.
@@ -55,4 +57,37 @@ public:
 
     std::string Disassembly;
 
-};
\ No newline at end of file
+};
+
+// Part of a payload that has been serialized and compressed ahead of time, so it can be sent to any 
+// number of clients without having to be rebuilt and recompressed for each one. 
+struct Frpg2PreparedPayload
+{
+public:
+    std::vector<uint8_t> Payload;
+
+    // Payload compressed with CompressChunk, only set if bCompressed is true.
+    CompressedChunk Compressed;
+    bool bCompressed = false;
+
+    // Payloads smaller than this are sent uncompressed, so there is no point compressing them ahead of time.
+    static inline constexpr size_t MIN_SIZE_FOR_COMPRESSION = 512;
+
+    // Takes ownership of the payload and compresses it if its large enough, returns nullptr on failure.
+    static std::shared_ptr<Frpg2PreparedPayload> Create(std::vector<uint8_t>&& InPayload)
+    {
+        std::shared_ptr<Frpg2PreparedPayload> Result = std::make_shared<Frpg2PreparedPayload>();
+        Result->Payload = std::move(InPayload);
+        if (Result->Payload.size() >= MIN_SIZE_FOR_COMPRESSION)
+        {
+            if (!CompressChunk(Result->Payload.data(), Result->Payload.size(), Result->Compressed))
+            {
+                return nullptr;
+            }
+            Result->bCompressed = true;
+        }
+        return Result;
+    }
+};
+
+using Frpg2PreparedPayloadList = std::vector<std::shared_ptr<const Frpg2PreparedPayload>>;
\ No newline at end of file
@@ -31,14 +31,13 @@ Frpg2ReliableUdpFragmentStream::Frpg2ReliableUdpFragmentStream(std::shared_ptr<N
 
 bool Frpg2ReliableUdpFragmentStream::Send(const Frpg2ReliableUdpFragment& Fragment)
 {
-    std::vector<uint8_t> Payload = Fragment.Payload;
     bool bCompressed = (Fragment.Payload.size() >= MIN_SIZE_FOR_COMPRESSION);
-    uint32_t UncompressedSize = (uint32_t)Payload.size();
+    uint32_t UncompressedSize = (uint32_t)Fragment.Payload.size();
 
+    // Compress straight out of the fragment, if its not compressed we just fragment the original payload.
     if (bCompressed)
     {        
-        std::vector<uint8_t> UncompressPayload = Payload;
-        if (!Compress(UncompressPayload, Payload))
+        if (!Compress(Fragment.Payload, CompressedPayload))
         {
             WarningS(Connection->GetName().c_str(), "Failed to compress packet data.");
             InErrorState = true;
@@ -46,6 +45,50 @@ bool Frpg2ReliableUdpFragmentStream::Send(const Frpg2ReliableUdpFragment& Fragme
         }
     }
 
+    return SendFragmented(Fragment, bCompressed ? CompressedPayload : Fragment.Payload, bCompressed, UncompressedSize);
+}
+
+bool Frpg2ReliableUdpFragmentStream::Send(const Frpg2ReliableUdpFragment& Fragment, const Frpg2PreparedPayloadList& Suffix)
+{
+    size_t UncompressedSize = Fragment.Payload.size();
+    bool bAllPrecompressed = true;
+    for (auto& Prepared : Suffix)
+    {
+        UncompressedSize += Prepared->Payload.size();
+        bAllPrecompressed &= Prepared->bCompressed;
+    }
+
+    // Too small to be worth compressing, or made of parts that were too small to compress ahead of 
+    // time, just stitch it all together and send it as normal.
+    if (UncompressedSize < MIN_SIZE_FOR_COMPRESSION || !bAllPrecompressed)
+    {
+        Frpg2ReliableUdpFragment Combined = Fragment;
+        for (auto& Prepared : Suffix)
+        {
+            Combined.Payload.insert(Combined.Payload.end(), Prepared->Payload.begin(), Prepared->Payload.end());
+        }
+        return Send(Combined);
+    }
+
+    std::vector<const CompressedChunk*> Chunks;
+    Chunks.reserve(Suffix.size());
+    for (auto& Prepared : Suffix)
+    {
+        Chunks.push_back(&Prepared->Compressed);
+    }
+
+    if (!CompressSpliced(Fragment.Payload.data(), Fragment.Payload.size(), Chunks, CompressedPayload))
+    {
+        WarningS(Connection->GetName().c_str(), "Failed to compress packet data.");
+        InErrorState = true;
+        return false;
+    }
+
+    return SendFragmented(Fragment, CompressedPayload, true, (uint32_t)UncompressedSize);
+}
+
+bool Frpg2ReliableUdpFragmentStream::SendFragmented(const Frpg2ReliableUdpFragment& Fragment, const std::vector<uint8_t>& Payload, bool bCompressed, uint32_t UncompressedSize)
+{
     size_t FragmentCount = (Payload.size() + (MAX_FRAGMENT_LENGTH - 1)) / MAX_FRAGMENT_LENGTH;
 
     // Fragment up if payload is larger than max payload size.
@@ -55,19 +98,15 @@ bool Frpg2ReliableUdpFragmentStream::Send(const Frpg2ReliableUdpFragment& Fragme
         int BytesRemaining = (int)Payload.size() - FragmentOffset;
         int FragmentLength = std::min(MAX_FRAGMENT_LENGTH, BytesRemaining);
 
-        Frpg2ReliableUdpFragment SendFragment;
-        SendFragment.Header.compress_flag = bCompressed;
-        SendFragment.Header.fragment_index = (uint8_t)i;
-        SendFragment.Header.fragment_length = FragmentLength;
-        SendFragment.Header.total_payload_length = (uint16_t)Payload.size();
-        SendFragment.Header.packet_counter = SentFragmentCounter;
-        SendFragment.PayloadDecompressedLength = UncompressedSize;
-        SendFragment.Payload.resize(FragmentLength);
+        Frpg2ReliableUdpFragmentHeader Header;
+        Header.compress_flag = bCompressed;
+        Header.fragment_index = (uint8_t)i;
+        Header.fragment_length = FragmentLength;
+        Header.total_payload_length = (uint16_t)Payload.size();
+        Header.packet_counter = SentFragmentCounter;
 
-        memcpy(SendFragment.Payload.data(), Payload.data() + FragmentOffset, FragmentLength);
-
-        Frpg2ReliableUdpPacket SendPacket;
-        if (!EncodeFragment(SendFragment, SendPacket))
+        SendPacket.Header = Frpg2ReliableUdpPacketHeader();
+        if (!EncodeFragment(Header, UncompressedSize, Payload.data() + FragmentOffset, FragmentLength, SendPacket))
         {
             WarningS(Connection->GetName().c_str(), "Failed to encode fragment to packet.");
             InErrorState = true;
@@ -85,11 +124,15 @@ bool Frpg2ReliableUdpFragmentStream::Send(const Frpg2ReliableUdpFragment& Fragme
         // Disassemble if required.
         if constexpr (BuildConfig::DISASSEMBLE_SENT_MESSAGES)
         {
+            Frpg2ReliableUdpFragment SendFragment;
+            SendFragment.Header = Header;
+
             SendPacket.Disassembly = Fragment.Disassembly;
             SendPacket.Disassembly.append(Disassemble(SendFragment));
         }
 
-        if (!Frpg2ReliableUdpPacketStream::Send(SendPacket))
+        // The packet's payload is moved into the send queue, we get back a previously used buffer to build the next one in.
+        if (!Frpg2ReliableUdpPacketStream::Send(std::move(SendPacket)))
         {
             WarningS(Connection->GetName().c_str(), "Failed to send fragment packet.");
             InErrorState = true;
@@ -106,43 +149,15 @@ bool Frpg2ReliableUdpFragmentStream::Recieve(Frpg2ReliableUdpFragment* Fragment)
 {
     if (RecieveQueue.size() > 0)
     {
-        *Fragment = RecieveQueue[0];
-        RecieveQueue.erase(RecieveQueue.begin());
+        *Fragment = std::move(RecieveQueue.front());
+        RecieveQueue.pop_front();
         return true;
     }
 
     return false;
 }
 
-bool Frpg2ReliableUdpFragmentStream::RecieveInternal(Frpg2ReliableUdpFragment* Fragment)
-{
-    Frpg2ReliableUdpPacket Packet;
-    if (!Frpg2ReliableUdpPacketStream::Recieve(&Packet))
-    {
-        return false;
-    }
-
-    if (!DecodeFragment(Packet, *Fragment))
-    {
-        WarningS(Connection->GetName().c_str(), "Failed to convert packet payload to Fragment.");
-        InErrorState = true;
-        return false;
-    }
-
-    // TODO: Remove when we have a better way to handle this without breaking abstraction.
-    uint32_t Remote;
-    Packet.Header.GetAckCounters(Fragment->AckSequenceIndex, Remote);
-
-    // Disassemble if required.
-    if constexpr (BuildConfig::DISASSEMBLE_RECIEVED_MESSAGES)
-    {
-        Fragment->Disassembly = Packet.Disassembly;
-    }
-
-    return true;
-}
-
-bool Frpg2ReliableUdpFragmentStream::DecodeFragment(const Frpg2ReliableUdpPacket& Packet, Frpg2ReliableUdpFragment& Fragment)
+bool Frpg2ReliableUdpFragmentStream::DecodeFragmentHeader(const Frpg2ReliableUdpPacket& Packet, Frpg2ReliableUdpFragmentHeader& Header, uint32_t& PayloadDecompressedLength, size_t& PayloadOffset)
 {
     if (Packet.Payload.size() < sizeof(Frpg2ReliableUdpFragmentHeader))
     {
@@ -151,51 +166,56 @@ bool Frpg2ReliableUdpFragmentStream::DecodeFragment(const Frpg2ReliableUdpPacket
         return false;
     }
 
-    memcpy(&Fragment.Header, Packet.Payload.data(), sizeof(Frpg2ReliableUdpFragmentHeader));
-    Fragment.Header.SwapEndian();
+    memcpy(&Header, Packet.Payload.data(), sizeof(Frpg2ReliableUdpFragmentHeader));
+    Header.SwapEndian();
 
-    size_t PayloadOffset = sizeof(Frpg2ReliableUdpFragmentHeader);
-    size_t PayloadLength = Packet.Payload.size() - PayloadOffset;
+    PayloadOffset = sizeof(Frpg2ReliableUdpFragmentHeader);
+    PayloadDecompressedLength = 0;
 
-    if (Fragment.Header.compress_flag && Fragment.Header.fragment_index == 0)
+    if (Header.compress_flag && Header.fragment_index == 0)
     {
-        memcpy(&Fragment.PayloadDecompressedLength, Packet.Payload.data() + PayloadOffset, 4);
-        Fragment.PayloadDecompressedLength = BigEndianToHostOrder(Fragment.PayloadDecompressedLength);
+        if (Packet.Payload.size() < PayloadOffset + 4)
+        {
+            WarningS(Connection->GetName().c_str(), "Packet payload is too small to contain decompressed length, failed to deserialize.");
+            InErrorState = true;
+            return false;
+        }
+
+        memcpy(&PayloadDecompressedLength, Packet.Payload.data() + PayloadOffset, 4);
+        PayloadDecompressedLength = BigEndianToHostOrder(PayloadDecompressedLength);
 
         PayloadOffset += 4;
-        PayloadLength -= 4;
     }
 
-    Fragment.Payload.resize(PayloadLength);
-    memcpy(Fragment.Payload.data(), Packet.Payload.data() + PayloadOffset, PayloadLength);
-
     return true;
 }
 
-bool Frpg2ReliableUdpFragmentStream::EncodeFragment(const Frpg2ReliableUdpFragment& Fragment, Frpg2ReliableUdpPacket& Packet)
+bool Frpg2ReliableUdpFragmentStream::EncodeFragment(const Frpg2ReliableUdpFragmentHeader& Header, uint32_t PayloadDecompressedLength, const uint8_t* Data, size_t Length, Frpg2ReliableUdpPacket& Packet)
 {
-    Frpg2ReliableUdpFragment ByteSwappedFragment = Fragment;
-    ByteSwappedFragment.Header.SwapEndian();
-    ByteSwappedFragment.PayloadDecompressedLength = HostOrderToBigEndian(ByteSwappedFragment.PayloadDecompressedLength);
+    Frpg2ReliableUdpFragmentHeader ByteSwappedHeader = Header;
+    ByteSwappedHeader.SwapEndian();
+
+    bool bWriteDecompressedLength = (Header.compress_flag && Header.fragment_index == 0);
 
-    size_t PayloadSize = sizeof(Frpg2ReliableUdpFragmentHeader) + ByteSwappedFragment.Payload.size();
-    if (ByteSwappedFragment.Header.compress_flag && ByteSwappedFragment.Header.fragment_index == 0)
+    size_t PayloadSize = sizeof(Frpg2ReliableUdpFragmentHeader) + Length;
+    if (bWriteDecompressedLength)
     {
         PayloadSize += 4;
     }
 
     Packet.Payload.resize(PayloadSize);
 
-    memcpy(Packet.Payload.data(), &ByteSwappedFragment.Header, sizeof(Frpg2ReliableUdpFragmentHeader));
+    memcpy(Packet.Payload.data(), &ByteSwappedHeader, sizeof(Frpg2ReliableUdpFragmentHeader));
 
     size_t WriteOffset = sizeof(Frpg2ReliableUdpFragmentHeader);
-    if (ByteSwappedFragment.Header.compress_flag && ByteSwappedFragment.Header.fragment_index == 0)
+    if (bWriteDecompressedLength)
     {
-        memcpy(Packet.Payload.data() + WriteOffset, &ByteSwappedFragment.PayloadDecompressedLength, 4);
+        uint32_t ByteSwappedLength = HostOrderToBigEndian(PayloadDecompressedLength);
+        memcpy(Packet.Payload.data() + WriteOffset, &ByteSwappedLength, 4);
         WriteOffset += 4;
     }
 
-    memcpy(Packet.Payload.data() + WriteOffset, ByteSwappedFragment.Payload.data(), ByteSwappedFragment.Payload.size());
+    memcpy(Packet.Payload.data() + WriteOffset, Data, Length);
 
     return true;
 }
@@ -204,7 +224,8 @@ void Frpg2ReliableUdpFragmentStream::Reset()
 {
     Frpg2ReliableUdpPacketStream::Reset();
 
-    Fragments.clear();
+    AssemblingFragment = Frpg2ReliableUdpFragment();
+    Assembling = false;
     RecieveQueue.clear();
     RecievedFragmentLength = 0;
 }
@@ -219,68 +240,100 @@ bool Frpg2ReliableUdpFragmentStream::Pump()
     // TODO: I have the horrible feeling the client multiplex's fragments from different packets.
     //       If this is the case we need to check the packet_counter when defragmenting packets and keep them together.
 
-    Frpg2ReliableUdpFragment Fragment;
-    while (RecieveInternal(&Fragment))
+    Frpg2ReliableUdpPacket Packet;
+    while (Frpg2ReliableUdpPacketStream::Recieve(&Packet))
     {
-        RecievedFragmentLength += Fragment.Header.fragment_length;
-        if (RecievedFragmentLength >= Fragment.Header.total_payload_length)
+        Frpg2ReliableUdpFragmentHeader Header;
+        uint32_t PayloadDecompressedLength = 0;
+        size_t PayloadOffset = 0;
+        if (!DecodeFragmentHeader(Packet, Header, PayloadDecompressedLength, PayloadOffset))
         {
-            // Compact all payloads together into one combined packet.
-            if (Fragments.size() > 0)
-            {
-                Frpg2ReliableUdpFragment CombinedFragment = Fragments[0];
-                CombinedFragment.AckSequenceIndex = Fragment.AckSequenceIndex; // Ack the last packet in the fragment list.
-                CombinedFragment.Header.fragment_index = 0;
-                CombinedFragment.Header.fragment_length = Fragment.Header.total_payload_length;
-
-                CombinedFragment.Payload.resize(CombinedFragment.Header.total_payload_length);
-                int Offset = Fragments[0].Header.fragment_length;
-                for (int i = 1; i < Fragments.size(); i++)
-                {
-                    const Frpg2ReliableUdpFragment& Fragment = Fragments[i];
-                    memcpy(CombinedFragment.Payload.data() + Offset, Fragment.Payload.data(), Fragment.Payload.size());
-                    Offset += (int)Fragment.Payload.size();
-                }
-
-                memcpy(CombinedFragment.Payload.data() + Offset, Fragment.Payload.data(), Fragment.Payload.size());
-
-                Fragment = CombinedFragment;
-            }
+            WarningS(Connection->GetName().c_str(), "Failed to convert packet payload to Fragment.");
+            return true;
+        }
 
-            // Decompress data if required.
-            if (Fragment.Header.compress_flag)
-            {
-                std::vector<uint8_t> UncompressPayload = Fragment.Payload;
-                if (!Decompress(UncompressPayload, Fragment.Payload, Fragment.PayloadDecompressedLength))
-                {
-                    WarningS(Connection->GetName().c_str(), "Failed to decompress packet data.");
-                    InErrorState = true;
-                    return true;
-                }
-
-                Fragment.Header.compress_flag = false;
-            }
+        // First fragment of a new payload, the header fields are taken from this one.
+        if (!Assembling)
+        {
+            AssemblingFragment.Header = Header;
+            AssemblingFragment.PayloadDecompressedLength = PayloadDecompressedLength;
+            AssemblingFragment.Payload.clear();
+            AssemblingFragment.Payload.reserve(Header.total_payload_length);
 
-            // Disassemble if required.
             if constexpr (BuildConfig::DISASSEMBLE_RECIEVED_MESSAGES)
             {
-                Fragment.Disassembly.append(Disassemble(Fragment));
+                AssemblingFragment.Disassembly = Packet.Disassembly;
             }
 
-            RecieveQueue.push_back(Fragment);
-
-            Fragments.clear();
-            RecievedFragmentLength = 0;
+            Assembling = true;
         }
-        else
+
+        AssemblingFragment.Payload.insert(AssemblingFragment.Payload.end(), Packet.Payload.begin() + PayloadOffset, Packet.Payload.end());
+
+        // TODO: Remove when we have a better way to handle this without breaking abstraction.
+        // Ack the last packet in the fragment list.
+        uint32_t Remote;
+        Packet.Header.GetAckCounters(AssemblingFragment.AckSequenceIndex, Remote);
+
+        RecievedFragmentLength += Header.fragment_length;
+        if (RecievedFragmentLength >= Header.total_payload_length)
         {
-            Fragments.push_back(Fragment);
+            AssemblingFragment.Header.fragment_index = 0;
+            AssemblingFragment.Header.fragment_length = Header.total_payload_length;
+
+            Assembling = false;
+            RecievedFragmentLength = 0;
+
+            if (!HandleAssembledFragment(std::move(AssemblingFragment)))
+            {
+                return true;
+            }
+
+            AssemblingFragment = Frpg2ReliableUdpFragment();
         }
     }
 
     return false;
 }
 
+bool Frpg2ReliableUdpFragmentStream::HandleAssembledFragment(Frpg2ReliableUdpFragment&& Fragment)
+{
+    if (!DecompressFragment(Fragment))
+    {
+        WarningS(Connection->GetName().c_str(), "Failed to decompress packet data.");
+        InErrorState = true;
+        return false;
+    }
+
+    // Disassemble if required.
+    if constexpr (BuildConfig::DISASSEMBLE_RECIEVED_MESSAGES)
+    {
+        Fragment.Disassembly.append(Disassemble(Fragment));
+    }
+
+    RecieveQueue.push_back(std::move(Fragment));
+
+    return true;
+}
+
+bool Frpg2ReliableUdpFragmentStream::DecompressFragment(Frpg2ReliableUdpFragment& Fragment)
+{
+    if (!Fragment.Header.compress_flag)
+    {
+        return true;
+    }
+
+    std::vector<uint8_t> CompressedPayload = std::move(Fragment.Payload);
+    if (!Decompress(CompressedPayload, Fragment.Payload, Fragment.PayloadDecompressedLength))
+    {
+        return false;
+    }
+
+    Fragment.Header.compress_flag = false;
+
+    return true;
+}
+
 std::string Frpg2ReliableUdpFragmentStream::Disassemble(const Frpg2ReliableUdpFragment& Packet)
 {
     std::string Result = "";
@@ -12,6 +12,8 @@
 #include "Server/Streams/Frpg2ReliableUdpPacketStream.h"
 #include "Server/Streams/Frpg2ReliableUdpFragment.h"
 
+#include <deque>
+
 class RSAKeyPair;
 class Cipher;
 
@@ -25,6 +27,10 @@ public:
     // is likely saturated or the packet is invalid.
     virtual bool Send(const Frpg2ReliableUdpFragment& Fragment);
 
+    // Same as above but sends the fragment's payload followed by each of the prepared payloads. Only the
+    // fragment's own payload needs compressing, the prepared payloads are spliced in already compressed.
+    virtual bool Send(const Frpg2ReliableUdpFragment& Fragment, const Frpg2PreparedPayloadList& Suffix);
+
     // Returns true if a packet was recieved and stores packet in OutputPacket.
     virtual bool Recieve(Frpg2ReliableUdpFragment* Fragment);
 
@@ -36,25 +42,44 @@ public:
 
 protected:
 
-    virtual bool RecieveInternal(Frpg2ReliableUdpFragment* Fragment);
+    // Reads the fragment header at the start of the packet, PayloadOffset is set to where the fragment's payload starts.
+    bool DecodeFragmentHeader(const Frpg2ReliableUdpPacket& Packet, Frpg2ReliableUdpFragmentHeader& Header, uint32_t& PayloadDecompressedLength, size_t& PayloadOffset);
+
+    // Writes a fragment header followed by the given slice of payload into the packet.
+    bool EncodeFragment(const Frpg2ReliableUdpFragmentHeader& Header, uint32_t PayloadDecompressedLength, const uint8_t* Data, size_t Length, Frpg2ReliableUdpPacket& Packet);
 
-    bool DecodeFragment(const Frpg2ReliableUdpPacket& Packet, Frpg2ReliableUdpFragment& Fragment);
-    bool EncodeFragment(const Frpg2ReliableUdpFragment& Fragment, Frpg2ReliableUdpPacket& Packet);
+    // Called by Pump with each fully reassembled (but still compressed) fragment. By default this
+    // decompresses it and queues it for Recieve. Returns false if the stream is now in an error state.
+    virtual bool HandleAssembledFragment(Frpg2ReliableUdpFragment&& Fragment);
+
+    // Doesn't touch any stream state, so is safe to call from worker threads.
+    static bool DecompressFragment(Frpg2ReliableUdpFragment& Fragment);
 
     virtual void Reset() override;
 
 private:
 
-    std::vector<Frpg2ReliableUdpFragment> Fragments;
+    // Splits an already compressed (or not) payload into fragments and sends them. Each fragment is written
+    // straight from the payload into the packet that gets queued for sending.
+    bool SendFragmented(const Frpg2ReliableUdpFragment& Fragment, const std::vector<uint8_t>& Payload, bool bCompressed, uint32_t UncompressedSize);
+
+    // Fragment currently being reassembled. Its payload is allocated up front from the total payload length 
+    // given by the first fragment, and each fragment's payload is copied straight into it from its packet.
+    Frpg2ReliableUdpFragment AssemblingFragment;
+    bool Assembling = false;
     uint32_t RecievedFragmentLength = 0;
 
-    std::vector<Frpg2ReliableUdpFragment> RecieveQueue;
+    std::deque<Frpg2ReliableUdpFragment> RecieveQueue;
+
+    // Reused between sends so we don't allocate new buffers for every message.
+    std::vector<uint8_t> CompressedPayload;
+    Frpg2ReliableUdpPacket SendPacket;
     
     uint32_t SentFragmentCounter = 0;
 
     // Includes header + compressed payload.
     // The main game seems to allow up to 1024, so we can boost this a bit if needed.
     const int MAX_FRAGMENT_LENGTH = 900;
-    const int MIN_SIZE_FOR_COMPRESSION = 512;
+    const size_t MIN_SIZE_FOR_COMPRESSION = Frpg2PreparedPayload::MIN_SIZE_FOR_COMPRESSION;
 
 };
\ No newline at end of file
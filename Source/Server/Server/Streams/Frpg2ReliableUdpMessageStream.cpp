@@ -15,6 +15,7 @@
 #include "Config/BuildConfig.h"
 
 #include "Shared/Core/Network/NetConnection.h"
+#include "Shared/Core/Network/NetEventLoop.h"
 
 #include "Shared/Core/Utils/Logging.h"
 #include "Shared/Core/Utils/File.h"
@@ -32,7 +33,7 @@ Frpg2ReliableUdpMessageStream::Frpg2ReliableUdpMessageStream(std::shared_ptr<Net
 {
 }
 
-bool Frpg2ReliableUdpMessageStream::SendInternal(const Frpg2ReliableUdpMessage& Message, const Frpg2ReliableUdpMessage* ResponseTo)
+bool Frpg2ReliableUdpMessageStream::SendInternal(const Frpg2ReliableUdpMessage& Message, const Frpg2ReliableUdpMessage* ResponseTo, const Frpg2PreparedPayloadList* Suffix)
 {
     Frpg2ReliableUdpMessage SendMessage = Message;
     if (SendMessage.Header.IsType(Frpg2ReliableUdpMessageType::Push))
@@ -67,7 +68,19 @@ bool Frpg2ReliableUdpMessageStream::SendInternal(const Frpg2ReliableUdpMessage&
     // Disassemble if required.
     if constexpr (BuildConfig::DISASSEMBLE_SENT_MESSAGES)
     {
-        Packet.Disassembly = Disassemble(SendMessage);
+        if (Suffix != nullptr)
+        {
+            Frpg2ReliableUdpMessage FullMessage = SendMessage;
+            for (auto& Prepared : *Suffix)
+            {
+                FullMessage.Payload.insert(FullMessage.Payload.end(), Prepared->Payload.begin(), Prepared->Payload.end());
+            }
+            Packet.Disassembly = Disassemble(FullMessage);
+        }
+        else
+        {
+            Packet.Disassembly = Disassemble(SendMessage);
+        }
     }
 
     // TODO: Remove when we have a better way to handle this without breaking abstraction.
@@ -76,7 +89,8 @@ bool Frpg2ReliableUdpMessageStream::SendInternal(const Frpg2ReliableUdpMessage&
         Packet.AckSequenceIndex = ResponseTo->AckSequenceIndex;
     }
 
-    if (!Frpg2ReliableUdpFragmentStream::Send(Packet))
+    bool bSent = (Suffix != nullptr) ? Frpg2ReliableUdpFragmentStream::Send(Packet, *Suffix) : Frpg2ReliableUdpFragmentStream::Send(Packet);
+    if (!bSent)
     {
         return false;
     }
@@ -155,35 +169,167 @@ bool Frpg2ReliableUdpMessageStream::SendRawProtobuf(const std::vector<uint8_t>&
     return true;
 }
 
-bool Frpg2ReliableUdpMessageStream::Recieve(Frpg2ReliableUdpMessage* Message)
+bool Frpg2ReliableUdpMessageStream::SendPrepared(const Frpg2PreparedPayloadList& Parts, const Frpg2ReliableUdpMessage* ResponseTo)
 {
-    Frpg2ReliableUdpFragment Packet;
-    if (!Frpg2ReliableUdpFragmentStream::Recieve(&Packet))
+    Frpg2ReliableUdpMessage ResponseMessage;
+
+    if (ResponseTo == nullptr)
+    {
+        ResponseMessage.Header.msg_type = Frpg2ReliableUdpMessageType::Push;
+    }
+    else
+    {
+        // TODO: Remove when we have a better way to handle this without breaking abstraction.
+        ResponseMessage.AckSequenceIndex = ResponseTo->AckSequenceIndex;
+    }
+
+    if (!SendInternal(ResponseMessage, ResponseTo, &Parts))
     {
         return false;
     }
 
-    if (!DecodeMessage(Packet, *Message))
+    return true;
+}
+
+std::shared_ptr<const Frpg2PreparedPayload> Frpg2ReliableUdpMessageStream::PrepareProtobuf(google::protobuf::MessageLite* Message)
+{
+    std::vector<uint8_t> Payload;
+    Payload.resize(Message->ByteSize());
+
+    if (!Message->SerializeToArray(Payload.data(), (int)Payload.size()))
     {
-        WarningS(Connection->GetName().c_str(), "Failed to convert packet payload to message.");
+        return nullptr;
+    }
+
+    return Frpg2PreparedPayload::Create(std::move(Payload));
+}
+
+bool Frpg2ReliableUdpMessageStream::HandleAssembledFragment(Frpg2ReliableUdpFragment&& Fragment)
+{
+    if (!IngressStrand)
+    {
+        return Frpg2ReliableUdpFragmentStream::HandleAssembledFragment(std::move(Fragment));
+    }
+
+    // Disassemble if required.
+    if constexpr (BuildConfig::DISASSEMBLE_RECIEVED_MESSAGES)
+    {
+        Fragment.Disassembly.append(Frpg2ReliableUdpFragmentStream::Disassemble(Fragment));
+    }
+
+    std::shared_ptr<IngressMessage> Entry = std::make_shared<IngressMessage>();
+    IngressMessages.push_back(Entry);
+
+    IngressStrand->Submit([Entry, Fragment = std::move(Fragment), GameInterface = GameInterface]() mutable {
+
+        Frpg2ReliableUdpMessage& Message = Entry->Message;
+
+        if (!DecompressFragment(Fragment))
+        {
+            Entry->Error = "Failed to decompress packet data.";
+        }
+        else if (!DecodeMessage(Fragment, Message))
+        {
+            Entry->Error = "Failed to convert packet payload to message.";
+        }
+        else
+        {
+            // TODO: Remove when we have a better way to handle this without breaking abstraction.
+            Message.AckSequenceIndex = Fragment.AckSequenceIndex;
+
+            if constexpr (BuildConfig::DISASSEMBLE_RECIEVED_MESSAGES)
+            {
+                Message.Disassembly = Fragment.Disassembly;
+            }
+
+            // Replies can only be typed by looking up the message they are replying to, so they get
+            // parsed in Recieve. If parsing fails here we also leave it to Recieve, which will fail
+            // the same way and deal with the reporting.
+            if (!Message.Header.IsType(Frpg2ReliableUdpMessageType::Reply))
+            {
+                std::shared_ptr<google::protobuf::MessageLite> Protobuf;
+                if (GameInterface->ReliableUdpMessageType_To_Protobuf(Message.Header.msg_type, false, Protobuf) &&
+                    Protobuf->ParseFromArray(Message.Payload.data(), (int)Message.Payload.size()))
+                {
+                    Message.Protobuf = std::move(Protobuf);
+                }
+            }
+        }
+
+        Entry->Complete.store(true, std::memory_order_release);
+
+        NetEventLoop::Get().Wake();
+    });
+
+    return true;
+}
+
+bool Frpg2ReliableUdpMessageStream::RecieveDecoded(Frpg2ReliableUdpMessage* Message)
+{
+    if (IngressMessages.empty() || !IngressMessages.front()->Complete.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    std::shared_ptr<IngressMessage> Entry = std::move(IngressMessages.front());
+    IngressMessages.pop_front();
+
+    if (Entry->Error != nullptr)
+    {
+        WarningS(Connection->GetName().c_str(), "%s", Entry->Error);
         InErrorState = true;
         return false;
     }
 
+    *Message = std::move(Entry->Message);
+
+    return true;
+}
+
+bool Frpg2ReliableUdpMessageStream::Recieve(Frpg2ReliableUdpMessage* Message)
+{
+    if (IngressStrand)
+    {
+        if (!RecieveDecoded(Message))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        Frpg2ReliableUdpFragment Packet;
+        if (!Frpg2ReliableUdpFragmentStream::Recieve(&Packet))
+        {
+            return false;
+        }
+
+        if (!DecodeMessage(Packet, *Message))
+        {
+            WarningS(Connection->GetName().c_str(), "Failed to convert packet payload to message.");
+            InErrorState = true;
+            return false;
+        }
+
+        if constexpr (BuildConfig::DISASSEMBLE_RECIEVED_MESSAGES)
+        {
+            Message->Disassembly = Packet.Disassembly;
+        }
+
+        // TODO: Remove when we have a better way to handle this without breaking abstraction.
+        Message->AckSequenceIndex = Packet.AckSequenceIndex;
+        Message->Protobuf = nullptr;
+    }
+
     Debug::RequestsRecieved.Add(1);
 
     // Disassemble if required.
     if constexpr (BuildConfig::DISASSEMBLE_RECIEVED_MESSAGES)
     {
-        Message->Disassembly = Packet.Disassembly;
         Message->Disassembly.append(Disassemble(*Message));
 
         Log("\n<< RECV\n%s", Message->Disassembly.c_str());
     }
 
-    // TODO: Remove when we have a better way to handle this without breaking abstraction.
-    Message->AckSequenceIndex = Packet.AckSequenceIndex;
-
     // Create protobuf based on the type provided.
     Frpg2ReliableUdpMessageType MessageType = Message->Header.msg_type;
     bool IsResponse = false;
@@ -205,6 +351,16 @@ bool Frpg2ReliableUdpMessageStream::Recieve(Frpg2ReliableUdpMessage* Message)
         IsResponse = true;
     }
 
+    // Already parsed on the worker pool.
+    if (Message->Protobuf)
+    {
+        if constexpr (BuildConfig::LOG_PROTOBUF_STREAM)
+        {
+            Log("<< %s", Message->Protobuf->GetTypeName().c_str());
+        }
+        return true;
+    }
+
     if (!GameInterface->ReliableUdpMessageType_To_Protobuf(MessageType, IsResponse, Message->Protobuf))
     {
         WarningS(Connection->GetName().c_str(), "Failed to create protobuf instance for message: type=0x%08x index=0x%08x", MessageType, Message->Header.msg_index);
@@ -251,8 +407,6 @@ bool Frpg2ReliableUdpMessageStream::DecodeMessage(const Frpg2ReliableUdpFragment
 {
     if (Packet.Payload.size() < sizeof(Frpg2ReliableUdpMessageHeader))
     {
-        WarningS(Connection->GetName().c_str(), "Packet payload is less than the minimum size of a message, failed to deserialize.");
-        InErrorState = true;
         return false;
     }
 
@@ -263,6 +417,11 @@ bool Frpg2ReliableUdpMessageStream::DecodeMessage(const Frpg2ReliableUdpFragment
 
     if (Message.Header.IsType(Frpg2ReliableUdpMessageType::Reply))
     {
+        if (Packet.Payload.size() < ReadOffset + sizeof(Frpg2ReliableUdpMessageResponseHeader))
+        {
+            return false;
+        }
+
         memcpy(&Message.ResponseHeader, Packet.Payload.data() + ReadOffset, sizeof(Frpg2ReliableUdpMessageResponseHeader));
         ReadOffset += sizeof(Frpg2ReliableUdpMessageResponseHeader);
     }
@@ -310,6 +469,7 @@ void Frpg2ReliableUdpMessageStream::Reset()
 
     SentMessageCounter = 0;
     OutstandingResponses.clear();
+    IngressMessages.clear();
 }
 
 std::string Frpg2ReliableUdpMessageStream::Disassemble(const Frpg2ReliableUdpMessage& Message)
@@ -15,6 +15,8 @@
 #include "Protobuf/SharedProtobufs.h"
 
 #include <unordered_map>
+#include <deque>
+#include <atomic>
 
 class Cipher;
 class Game;
@@ -31,6 +33,15 @@ public:
     // If we have a protobuf thats already serialized we can send it via this. Code assumes it should be sent with Push message type.
     virtual bool SendRawProtobuf(const std::vector<uint8_t>& Data, const Frpg2ReliableUdpMessage* ResponseTo = nullptr);
 
+    // Sends a protobuf that has been serialized and compressed ahead of time, split into one or more parts
+    // which are concatenated to form the payload. Lets the same payload be sent to many clients without 
+    // being serialized and compressed for each. Like SendRawProtobuf, assumes Push if not a response.
+    virtual bool SendPrepared(const Frpg2PreparedPayloadList& Parts, const Frpg2ReliableUdpMessage* ResponseTo = nullptr);
+
+    // Serializes a protobuf so it can be passed to SendPrepared, compressing it as well if its large enough 
+    // to be sent compressed (see Frpg2PreparedPayload::Create). Returns nullptr on failure.
+    static std::shared_ptr<const Frpg2PreparedPayload> PrepareProtobuf(google::protobuf::MessageLite* Message);
+
     // Returns true if a packet was recieved and stores packet in OutputPacket.
     virtual bool Recieve(Frpg2ReliableUdpMessage* Message);
 
@@ -46,15 +57,38 @@ protected:
 
     // Returns true if send was successful, if false is returned the send queue
     // is likely saturated or the packet is invalid.
-    virtual bool SendInternal(const Frpg2ReliableUdpMessage& Message, const Frpg2ReliableUdpMessage* ResponseTo = nullptr);
+    // If Suffix is provided its appended to the message's payload.
+    virtual bool SendInternal(const Frpg2ReliableUdpMessage& Message, const Frpg2ReliableUdpMessage* ResponseTo = nullptr, const Frpg2PreparedPayloadList* Suffix = nullptr);
 
-    bool DecodeMessage(const Frpg2ReliableUdpFragment& Packet, Frpg2ReliableUdpMessage& Message);
+    // Doesn't touch any stream state, so is safe to call from worker threads.
+    static bool DecodeMessage(const Frpg2ReliableUdpFragment& Packet, Frpg2ReliableUdpMessage& Message);
     bool EncodeMessage(const Frpg2ReliableUdpMessage& Message, Frpg2ReliableUdpFragment& Packet);
 
+    // With parallel ingress enabled this hands the fragment off to the worker pool to be decompressed,
+    // decoded and have its protobuf parsed, otherwise it queues it as normal.
+    virtual bool HandleAssembledFragment(Frpg2ReliableUdpFragment&& Fragment) override;
+
+    // Pops the oldest message decoded on the worker pool, if it has finished decoding.
+    bool RecieveDecoded(Frpg2ReliableUdpMessage* Message);
+
     virtual void Reset() override;
 
 private:
 
+    // A message being decoded on the worker pool. Only touched by the worker until Complete is set.
+    struct IngressMessage
+    {
+        std::atomic<bool> Complete = false;
+
+        // Set if decoding failed, the stream should be put into an error state.
+        const char* Error = nullptr;
+
+        Frpg2ReliableUdpMessage Message;
+    };
+
+    // Messages in the order they were recieved, they are only handed out in this order.
+    std::deque<std::shared_ptr<IngressMessage>> IngressMessages;
+
     struct MessageHistoryEntry
     {
         uint32_t MessageIndex;
@@ -0,0 +1,89 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#include "Server/Streams/Frpg2ReliableUdpMessageTypeTable.h"
+
+void Frpg2ReliableUdpMessageTypeTable::AddType(Frpg2ReliableUdpMessageType Type, bool ExpectsResponse, FactoryFunction_t CreateRequest, FactoryFunction_t CreateResponse)
+{
+    size_t Index = (size_t)Type;
+    if (Index >= Types.size())
+    {
+        Types.resize(Index + 1);
+    }
+
+    // If a type is defined multiple times the first definition wins.
+    TypeInfo& Info = Types[Index];
+    if (Info.Valid)
+    {
+        return;
+    }
+
+    Info.Valid = true;
+    Info.ExpectsResponse = ExpectsResponse;
+    Info.CreateRequest = CreateRequest;
+    Info.CreateResponse = CreateResponse;
+}
+
+void Frpg2ReliableUdpMessageTypeTable::AddProtobuf(std::type_index ProtobufType, Frpg2ReliableUdpMessageType Type)
+{
+    // Same as above, if a protobuf is used by multiple types its sent as the first.
+    ProtobufTypes.insert({ ProtobufType, Type });
+}
+
+const Frpg2ReliableUdpMessageTypeTable::TypeInfo* Frpg2ReliableUdpMessageTypeTable::FindType(Frpg2ReliableUdpMessageType Type) const
+{
+    size_t Index = (size_t)Type;
+    if (Index >= Types.size() || !Types[Index].Valid)
+    {
+        return nullptr;
+    }
+    return &Types[Index];
+}
+
+bool Frpg2ReliableUdpMessageTypeTable::GetMessageType(const google::protobuf::MessageLite& Message, Frpg2ReliableUdpMessageType& Output) const
+{
+    auto Iter = ProtobufTypes.find(typeid(Message));
+    if (Iter == ProtobufTypes.end())
+    {
+        return false;
+    }
+
+    Output = Iter->second;
+    return true;
+}
+
+bool Frpg2ReliableUdpMessageTypeTable::CreateProtobuf(Frpg2ReliableUdpMessageType Type, bool IsResponse, std::shared_ptr<google::protobuf::MessageLite>& Output) const
+{
+    const TypeInfo* Info = FindType(Type);
+    if (Info == nullptr)
+    {
+        return false;
+    }
+
+    FactoryFunction_t Factory = (IsResponse ? Info->CreateResponse : Info->CreateRequest);
+    if (Factory == nullptr)
+    {
+        return false;
+    }
+
+    Output = Factory();
+    return true;
+}
+
+bool Frpg2ReliableUdpMessageTypeTable::ExpectsResponse(Frpg2ReliableUdpMessageType Type) const
+{
+    // RequestSendMessageToPlayers shares its type with push messages, which never get a response.
+    if (Type == Frpg2ReliableUdpMessageType::Push)
+    {
+        return false;
+    }
+
+    const TypeInfo* Info = FindType(Type);
+    return Info != nullptr && Info->ExpectsResponse;
+}
@@ -0,0 +1,87 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "Server/Streams/Frpg2ReliableUdpMessage.h"
+#include "Server/Streams/Frpg2ProtobufPool.h"
+
+#include <vector>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+
+// Maps between message types and the protobufs sent with them. Each game builds one of these from 
+// its list of message types (eg. DS3_Frpg2ReliableUdpMessageTypes.inc) so resolving a type is a single
+// array index (by message type) or hash lookup (by protobuf class) rather than walking the whole list.
+//
+// Once built the table is only read from, so its safe to use from multiple threads.
+
+class Frpg2ReliableUdpMessageTypeTable
+{
+public:
+    using FactoryFunction_t = std::shared_ptr<google::protobuf::MessageLite>(*)();
+
+    template <typename RequestClass, typename ResponseClass>
+    void AddRequestResponse(Frpg2ReliableUdpMessageType Type)
+    {
+        AddType(Type, true, &CreateProtobuf<RequestClass>, &CreateProtobuf<ResponseClass>);
+        AddProtobuf(typeid(RequestClass), Type);
+    }
+
+    template <typename MessageClass>
+    void AddMessage(Frpg2ReliableUdpMessageType Type)
+    {
+        AddType(Type, false, &CreateProtobuf<MessageClass>, nullptr);
+        AddProtobuf(typeid(MessageClass), Type);
+    }
+
+    // Push messages are only ever sent by the server, and all share the Push message type.
+    template <typename MessageClass>
+    void AddPushMessage()
+    {
+        AddProtobuf(typeid(MessageClass), Frpg2ReliableUdpMessageType::Push);
+    }
+
+    // Returns the message type a protobuf should be sent as.
+    bool GetMessageType(const google::protobuf::MessageLite& Message, Frpg2ReliableUdpMessageType& Output) const;
+
+    // Creates an empty protobuf of the type sent with the given message, or its response. The protobuf
+    // is taken from the type's Frpg2ProtobufPool and returned to it once released.
+    bool CreateProtobuf(Frpg2ReliableUdpMessageType Type, bool IsResponse, std::shared_ptr<google::protobuf::MessageLite>& Output) const;
+
+    bool ExpectsResponse(Frpg2ReliableUdpMessageType Type) const;
+
+private:
+
+    struct TypeInfo
+    {
+        bool Valid = false;
+        bool ExpectsResponse = false;
+        FactoryFunction_t CreateRequest = nullptr;
+        FactoryFunction_t CreateResponse = nullptr;
+    };
+
+    template <typename ProtobufClass>
+    static std::shared_ptr<google::protobuf::MessageLite> CreateProtobuf()
+    {
+        return Frpg2ProtobufPool<ProtobufClass>::Acquire();
+    }
+
+    void AddType(Frpg2ReliableUdpMessageType Type, bool ExpectsResponse, FactoryFunction_t CreateRequest, FactoryFunction_t CreateResponse);
+    void AddProtobuf(std::type_index ProtobufType, Frpg2ReliableUdpMessageType Type);
+
+    const TypeInfo* FindType(Frpg2ReliableUdpMessageType Type) const;
+
+    // Indexed by message type, message types are small enough that this doesn't need to be sparse.
+    std::vector<TypeInfo> Types;
+
+    std::unordered_map<std::type_index, Frpg2ReliableUdpMessageType> ProtobufTypes;
+
+};
@@ -180,7 +180,10 @@ private:
     friend class Frpg2ReliableUdpPacketStream;
 
     // Use for internal bookkeeping when sending/recieving the packet.
-    double SendTime;
-    double RawSendTime;
+    double SendTime = 0.0;
+    double RawSendTime = 0.0;
+
+    // How many times this packet has been retransmitted.
+    uint32_t RetransmitCount = 0;
 
 };
\ No newline at end of file
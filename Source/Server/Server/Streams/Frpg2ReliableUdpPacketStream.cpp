@@ -14,10 +14,12 @@
 #include "Config/BuildConfig.h"
 
 #include "Shared/Core/Network/NetConnection.h"
+#include "Shared/Core/Network/NetEventLoop.h"
 
 #include "Shared/Core/Utils/Logging.h"
 #include "Shared/Core/Utils/File.h"
 #include "Shared/Core/Utils/Strings.h"
+#include "Shared/Core/Utils/DebugObjects.h"
 
 #include "Shared/Core/Crypto/RSAKeyPair.h"
 #include "Shared/Core/Crypto/RSACipher.h"
@@ -25,6 +27,8 @@
 #include <thread>
 #include <chrono>
 #include <cstring>
+#include <cmath>
+#include <algorithm>
 
 Frpg2ReliableUdpPacketStream::Frpg2ReliableUdpPacketStream(std::shared_ptr<NetConnection> Connection, const std::vector<uint8_t>& CwcKey, uint64_t AuthToken, bool AsClient)
     : Frpg2UdpPacketStream(Connection, CwcKey, AuthToken, AsClient)
@@ -50,6 +54,16 @@ void Frpg2ReliableUdpPacketStream::Connect(const std::string& ClientSteamId)
 }
 
 bool Frpg2ReliableUdpPacketStream::Send(const Frpg2ReliableUdpPacket& Input)
+{
+    return QueueSend(Input, nullptr);
+}
+
+bool Frpg2ReliableUdpPacketStream::Send(Frpg2ReliableUdpPacket&& Input)
+{
+    return QueueSend(Input, &Input.Payload);
+}
+
+bool Frpg2ReliableUdpPacketStream::QueueSend(const Frpg2ReliableUdpPacket& Input, std::vector<uint8_t>* Payload)
 {
     // Swallow any packets being sent while we are closing.
     if (State == Frpg2ReliableUdpStreamState::Closing)
@@ -59,7 +73,26 @@ bool Frpg2ReliableUdpPacketStream::Send(const Frpg2ReliableUdpPacket& Input)
 
     if (IsOpcodeSequenced(Input.Header.opcode) || Input.Header.opcode == Frpg2ReliableUdpOpCode::Unset)
     {
-        Frpg2ReliableUdpPacket SentPacket = Input;
+        // We've used the entire sequence space without the remote acknowledging anything.
+        if (SendQueue.Find(SequenceIndex) != nullptr || RetransmitBuffer.Find(SequenceIndex) != nullptr)
+        {
+            WarningS(Connection->GetName().c_str(), "Send queue is saturated, unable to send packet.");
+            return false;
+        }
+
+        std::unique_ptr<Frpg2ReliableUdpPacket> Entry = AllocatePacket();
+        Entry->Header = Input.Header;
+        if (Payload != nullptr)
+        {
+            Entry->Payload.swap(*Payload);
+        }
+        else
+        {
+            Entry->Payload.assign(Input.Payload.begin(), Input.Payload.end());
+        }
+        Entry->Disassembly = Input.Disassembly;
+
+        Frpg2ReliableUdpPacket& SentPacket = *Entry;
         SentPacket.SendTime = GetSeconds();
         SentPacket.RawSendTime = 0.0f;
 
@@ -85,9 +118,9 @@ bool Frpg2ReliableUdpPacketStream::Send(const Frpg2ReliableUdpPacket& Input)
             }
         }
 
+        SendQueue.Insert(SequenceIndex, std::move(Entry));
+
         SequenceIndex = (SequenceIndex + 1) % MAX_ACK_VALUE;
-        
-        SendQueue.push_back(SentPacket);
     }
     else
     {
@@ -99,15 +132,50 @@ bool Frpg2ReliableUdpPacketStream::Send(const Frpg2ReliableUdpPacket& Input)
 
 bool Frpg2ReliableUdpPacketStream::Recieve(Frpg2ReliableUdpPacket* Output)
 {
-    if (RecieveQueue.size() > 0)
+    if (RecieveQueue.Empty())
     {
-        *Output = RecieveQueue[0];
-        RecieveQueue.erase(RecieveQueue.begin());
+        return false;
+    }
 
-        return true;
+    std::unique_ptr<Frpg2ReliableUdpPacket> Packet = RecieveQueue.PopFront();
+
+    // Swap rather than copy, the outputs old storage goes back on the free list.
+    Output->Header = Packet->Header;
+    Output->Payload.swap(Packet->Payload);
+    Output->Disassembly.swap(Packet->Disassembly);
+
+    ReleasePacket(std::move(Packet));
+
+    return true;
+}
+
+std::unique_ptr<Frpg2ReliableUdpPacket> Frpg2ReliableUdpPacketStream::AllocatePacket()
+{
+    if (FreePackets.empty())
+    {
+        return std::make_unique<Frpg2ReliableUdpPacket>();
     }
 
-    return false;
+    std::unique_ptr<Frpg2ReliableUdpPacket> Packet = std::move(FreePackets.back());
+    FreePackets.pop_back();
+    return Packet;
+}
+
+void Frpg2ReliableUdpPacketStream::ReleasePacket(std::unique_ptr<Frpg2ReliableUdpPacket> Packet)
+{
+    if (!Packet || FreePackets.size() >= MAX_FREE_PACKETS)
+    {
+        return;
+    }
+
+    Packet->Header = Frpg2ReliableUdpPacketHeader();
+    Packet->Payload.clear();
+    Packet->Disassembly.clear();
+    Packet->SendTime = 0.0;
+    Packet->RawSendTime = 0.0;
+    Packet->RetransmitCount = 0;
+
+    FreePackets.push_back(std::move(Packet));
 }
 
 bool Frpg2ReliableUdpPacketStream::DecodeReliablePacket(const Frpg2UdpPacket& Input, Frpg2ReliableUdpPacket& Output)
@@ -190,11 +258,13 @@ void Frpg2ReliableUdpPacketStream::HandleIncoming()
             Packet.Payload = StrippedPayload;
         }
 
-        Frpg2ReliableUdpPacket ReliablePacket;
+        std::unique_ptr<Frpg2ReliableUdpPacket> ReliablePacketEntry = AllocatePacket();
+        Frpg2ReliableUdpPacket& ReliablePacket = *ReliablePacketEntry;
         if (!DecodeReliablePacket(Packet, ReliablePacket))
         {
             WarningS(Connection->GetName().c_str(), "Failed to convert packet payload to message.");
             InErrorState = true;
+            ReleasePacket(std::move(ReliablePacketEntry));
             continue;
         }
 
@@ -210,7 +280,7 @@ void Frpg2ReliableUdpPacketStream::HandleIncoming()
             }
         }
 
-        HandleIncomingPacket(ReliablePacket);
+        HandleIncomingPacket(std::move(ReliablePacketEntry));
 
         ConsumeIncomingPackets();
     }
@@ -221,20 +291,31 @@ void Frpg2ReliableUdpPacketStream::HandleIncoming()
 void Frpg2ReliableUdpPacketStream::ConsumeIncomingPackets()
 {
     // Process as many packets as we can off the pending queue.
-    while (PendingRecieveQueue.size() > 0)
+    while (!PendingRecieveQueue.Empty())
     {
-        Frpg2ReliableUdpPacket& Next = PendingRecieveQueue[0];
-
-        uint32_t Local, Remote;
-        Next.Header.GetAckCounters(Local, Remote);
+        uint32_t Local = PendingRecieveQueue.FrontSequence();
 
         if (Local == GetNextRemoteSequenceIndex())
         {
-            ProcessPacket(Next);
+            std::unique_ptr<Frpg2ReliableUdpPacket> Next = PendingRecieveQueue.PopFront();
 
-            PendingRecieveQueue.erase(PendingRecieveQueue.begin());
+            ProcessPacket(*Next);
 
             RemoteSequenceIndex = (RemoteSequenceIndex + 1) % MAX_ACK_VALUE;
+
+            // Data packets get passed on to whoever calls Recieve(), everything else is done with.
+            if (Next->Header.opcode == Frpg2ReliableUdpOpCode::DAT ||
+                Next->Header.opcode == Frpg2ReliableUdpOpCode::DAT_ACK)
+            {
+                if (!RecieveQueue.Insert(Local, std::move(Next)))
+                {
+                    WarningS(Connection->GetName().c_str(), "Recieve queue is saturated, dropping packet %i.", Local);
+                }
+            }
+            else
+            {
+                ReleasePacket(std::move(Next));
+            }
         }
         else
         {
@@ -244,21 +325,6 @@ void Frpg2ReliableUdpPacketStream::ConsumeIncomingPackets()
     }
 }
 
-int Frpg2ReliableUdpPacketStream::GetPacketIndexByLocalSequence(const std::vector<Frpg2ReliableUdpPacket>& Queue, uint32_t SequenceIndex)
-{
-    for (size_t i = 0; i < Queue.size(); i++)
-    {
-        uint32_t Local, Remote;
-        Queue[i].Header.GetAckCounters(Local, Remote);
-
-        if (Local == SequenceIndex)
-        {
-            return (int)i;
-        }
-    }
-    return -1;
-}
-
 bool Frpg2ReliableUdpPacketStream::IsOpcodeSequenced(Frpg2ReliableUdpOpCode Opcode)
 {
     // Determines if an opcode causes incrementing of the sequence value and 
@@ -270,8 +336,10 @@ bool Frpg2ReliableUdpPacketStream::IsOpcodeSequenced(Frpg2ReliableUdpOpCode Opco
            Opcode == Frpg2ReliableUdpOpCode::FIN_ACK;
 }
 
-void Frpg2ReliableUdpPacketStream::HandleIncomingPacket(const Frpg2ReliableUdpPacket& Packet)
+void Frpg2ReliableUdpPacketStream::HandleIncomingPacket(std::unique_ptr<Frpg2ReliableUdpPacket> PacketEntry)
 {
+    const Frpg2ReliableUdpPacket& Packet = *PacketEntry;
+
     LastPacketRecievedTime = GetSeconds();
 
     uint32_t LocalAck, RemoteAck;
@@ -304,7 +372,7 @@ void Frpg2ReliableUdpPacketStream::HandleIncomingPacket(const Frpg2ReliableUdpPa
             IsInCorrectSequence = true;
         }
 
-        if (GetPacketIndexByLocalSequence(PendingRecieveQueue, LocalAck) >= 0)
+        if (PendingRecieveQueue.Find(LocalAck) != nullptr)
         {
             VerboseS(Connection->GetName().c_str(), "Ignoring incoming packet, duplicate that we already have.");
             IsInCorrectSequence = true;
@@ -317,18 +385,19 @@ void Frpg2ReliableUdpPacketStream::HandleIncomingPacket(const Frpg2ReliableUdpPa
             Verbose("Sending ack as not sent in a while.");
 
             Send_ACK(RemoteSequenceIndexAcked);
-
-            return;
         }
         else if (!IsInCorrectSequence)
         {
-            PendingRecieveQueue.push_back(Packet);
+            PendingRecieveQueue.Insert(LocalAck, std::move(PacketEntry));
+            return;
         }
     }
     else
     {
         ProcessPacket(Packet);
     }
+
+    ReleasePacket(std::move(PacketEntry));
 }
 
 void Frpg2ReliableUdpPacketStream::ProcessPacket(const Frpg2ReliableUdpPacket & Packet)
@@ -496,6 +565,12 @@ void Frpg2ReliableUdpPacketStream::Handle_ACK(const Frpg2ReliableUdpPacket& Pack
     {
         SequenceIndexAcked = std::max(SequenceIndexAcked, InRemoteAck);
     }
+
+    // Acks that don't move us forward while we have packets in flight suggest something has been lost.
+    if (SequenceIndexAcked == SequenceIndexAckedOriginal && !RetransmitBuffer.Empty())
+    {
+        DuplicateAckCount++;
+    }
 }
 void Frpg2ReliableUdpPacketStream::Handle_RACK(const Frpg2ReliableUdpPacket& Packet)
 {
@@ -512,9 +587,9 @@ void Frpg2ReliableUdpPacketStream::Handle_DAT(const Frpg2ReliableUdpPacket& Pack
 
     ExpectedDatAckResponses.insert(InLocalAck);
 
-    RecieveQueue.push_back(Packet);
+    // Packet gets moved onto the recieve queue by ConsumeIncomingPackets.
 
-    Send_ACK(InLocalAck);
+    QueueAck(InLocalAck);
 }
 
 void Frpg2ReliableUdpPacketStream::Handle_DAT_ACK(const Frpg2ReliableUdpPacket& Packet)
@@ -535,9 +610,9 @@ void Frpg2ReliableUdpPacketStream::Handle_DAT_ACK(const Frpg2ReliableUdpPacket&
     }
 
     // Send an ACK for this DAT_ACK.
-    Send_ACK(InLocalAck);
+    QueueAck(InLocalAck);
 
-    RecieveQueue.push_back(Packet);
+    // Packet gets moved onto the recieve queue by ConsumeIncomingPackets.
 }
 
 void Frpg2ReliableUdpPacketStream::Send_SYN()
@@ -587,6 +662,14 @@ void Frpg2ReliableUdpPacketStream::Send_ACK(uint32_t RemoteIndex)
 
     RemoteSequenceIndexAcked = RemoteIndex;
     LastAckSendTime = GetSeconds();
+
+    // Anything we were delaying is covered by this.
+    if (AckPending && !IsRemoteSequenceAfter(PendingAckSequence, RemoteIndex))
+    {
+        AckPending = false;
+    }
+
+    Debug::UdpAcksSent.Add(1);
 }
 
 void Frpg2ReliableUdpPacketStream::Send_DAT_ACK(uint32_t LocalIndex, uint32_t RemoteIndex)
@@ -674,107 +757,312 @@ void Frpg2ReliableUdpPacketStream::Reset()
     RemoteSequenceIndex = 0;
     RemoteSequenceIndexAcked = 0;
 
-    PendingRecieveQueue.clear();
-    RecieveQueue.clear();    
-    SendQueue.clear();
-    RetransmitBuffer.clear();
+    for (PacketQueue* Queue : { &PendingRecieveQueue, &RecieveQueue, &SendQueue, &RetransmitBuffer })
+    {
+        while (!Queue->Empty())
+        {
+            ReleasePacket(Queue->PopFront());
+        }
+    }
+
+    HasRttSample = false;
+    SmoothedRtt = 0.0;
+    RttVariance = 0.0;
+    RetransmitTimeout = INITIAL_RETRANSMIT_TIMEOUT;
+    DuplicateAckCount = 0;
+    InRecovery = false;
+    CongestionWindow = INITIAL_CONGESTION_WINDOW;
+    SlowStartThreshold = MAX_CONGESTION_WINDOW;
+    LossRate = 0.0;
+    AckPending = false;
 }
 
-void Frpg2ReliableUdpPacketStream::HandleOutgoing()
+bool Frpg2ReliableUdpPacketStream::IsSequenceAcked(uint32_t Index)
+{
+    // TODO: Handle overflow - This is super crude,  do it in a better way.
+    return (Index > MAX_ACK_VALUE_TOP_QUART && SequenceIndexAcked < MAX_ACK_VALUE_BOTTOM_QUART) ||
+           Index <= SequenceIndexAcked;
+}
+
+void Frpg2ReliableUdpPacketStream::UpdateRtt(double Sample)
+{
+    if (!HasRttSample)
+    {
+        SmoothedRtt = Sample;
+        RttVariance = Sample * 0.5;
+        HasRttSample = true;
+    }
+    else
+    {
+        RttVariance = (0.75 * RttVariance) + (0.25 * std::abs(SmoothedRtt - Sample));
+        SmoothedRtt = (0.875 * SmoothedRtt) + (0.125 * Sample);
+    }
+
+    RetransmitTimeout = std::clamp(SmoothedRtt + (4.0 * RttVariance), MIN_RETRANSMIT_TIMEOUT, MAX_RETRANSMIT_TIMEOUT);
+}
+
+void Frpg2ReliableUdpPacketStream::QueueAck(uint32_t RemoteIndex)
+{
+    if (AckDelay <= 0.0)
+    {
+        Send_ACK(RemoteIndex);
+        return;
+    }
+
+    if (!AckPending)
+    {
+        AckPending = true;
+        PendingAckSequence = RemoteIndex;
+        PendingAckTime = GetSeconds() + AckDelay;
+
+        NetEventLoop::Get().WakeAt(PendingAckTime);
+    }
+    // Acks are cumulative so only ever move forwards.
+    else if (IsRemoteSequenceAfter(RemoteIndex, PendingAckSequence))
+    {
+        PendingAckSequence = RemoteIndex;
+    }
+}
+
+bool Frpg2ReliableUdpPacketStream::IsRemoteSequenceAfter(uint32_t A, uint32_t B)
+{
+    uint32_t Distance = (A + MAX_ACK_VALUE - B) % MAX_ACK_VALUE;
+    return Distance != 0 && Distance < (MAX_ACK_VALUE / 2);
+}
+
+void Frpg2ReliableUdpPacketStream::FlushDelayedAck(double CurrentTime)
 {
-    // Trim off any retransmit packets that are not long relevant.
-    for (auto iter = RetransmitBuffer.begin(); iter != RetransmitBuffer.end(); /* empty */)
+    if (AckPending && CurrentTime >= PendingAckTime)
     {
-        Frpg2ReliableUdpPacket& Packet = *iter;
+        Send_ACK(PendingAckSequence);
+    }
+}
 
-        uint32_t InLocalAck, InRemoteAck;
-        Packet.Header.GetAckCounters(InLocalAck, InRemoteAck);
+void Frpg2ReliableUdpPacketStream::PiggybackDelayedAck(Frpg2ReliableUdpPacket& Packet)
+{
+    if (!AckPending)
+    {
+        return;
+    }
+
+    uint32_t Local, Remote;
+    Packet.Header.GetAckCounters(Local, Remote);
 
-        // TODO: Handle overflow - This is super crude,  do it in a better way.
-        if (InLocalAck > MAX_ACK_VALUE_TOP_QUART && SequenceIndexAcked < MAX_ACK_VALUE_BOTTOM_QUART ||
-            InLocalAck <= SequenceIndexAcked)
+    // Plain data packets can be turned into a DAT_ACK to carry the ack. Packets that are already 
+    // a DAT_ACK are a reply to a specific packet, so we leave them alone and only count them as
+    // covering our ack if they acknowledge as far as we need.
+    if (Packet.Header.opcode == Frpg2ReliableUdpOpCode::DAT)
+    {
+        Packet.Header.SetAckCounters(Local, PendingAckSequence);
+        Packet.Header.opcode = Frpg2ReliableUdpOpCode::DAT_ACK;
+    }
+    else if (Packet.Header.opcode != Frpg2ReliableUdpOpCode::DAT_ACK || IsRemoteSequenceAfter(PendingAckSequence, Remote))
+    {
+        return;
+    }
+
+    RemoteSequenceIndexAcked = PendingAckSequence;
+    LastAckSendTime = GetSeconds();
+    AckPending = false;
+
+    Debug::UdpAcksPiggybacked.Add(1);
+}
+
+void Frpg2ReliableUdpPacketStream::GrowCongestionWindow(size_t AckedCount)
+{
+    for (size_t i = 0; i < AckedCount; i++)
+    {
+        if (CongestionWindow < SlowStartThreshold)
         {
-            iter = RetransmitBuffer.erase(iter);
+            CongestionWindow += 1.0;
         }
         else
         {
-            iter++;
+            CongestionWindow += 1.0 / CongestionWindow;
         }
     }
 
-    // If we have not had ack of packets in the retransmit queue for long enough, retransmit 
-    // the first one and hope it gets acked soon.
-    double CurrentTime = GetSeconds();
-    if (!IsRetransmitting)
+    CongestionWindow = std::min(CongestionWindow, MAX_CONGESTION_WINDOW);
+}
+
+void Frpg2ReliableUdpPacketStream::ShrinkCongestionWindow(bool Timeout)
+{
+    // Based on what was actually in flight rather than the window, which may be much larger if we haven't been using it.
+    SlowStartThreshold = std::max(RetransmitBuffer.Size() / 2.0, MIN_CONGESTION_WINDOW);
+
+    if (Timeout)
     {
-        if (RetransmitBuffer.size() > 0)
-        {
-            Frpg2ReliableUdpPacket& Packet = RetransmitBuffer[0];
+        CongestionWindow = MIN_CONGESTION_WINDOW;
+    }
+    else
+    {
+        CongestionWindow = SlowStartThreshold;
+    }
 
-            uint32_t InLocalAck, InRemoteAck;
-            Packet.Header.GetAckCounters(InLocalAck, InRemoteAck);
+    VerboseS(Connection->GetName().c_str(), "Reduced congestion window (%s): CongestionWindow=%.1f SlowStartThreshold=%.1f", 
+        Timeout ? "timeout" : "loss", CongestionWindow, SlowStartThreshold);
+}
 
-            double ElapsedTime = (CurrentTime - Packet.SendTime);
-            double RawElapsedTime = (CurrentTime - Packet.RawSendTime);
-            if (ElapsedTime > RETRANSMIT_INTERVAL)
-            {
-                VerboseS(Connection->GetName().c_str(), "Starting retransmit as we have unacknowledged packets (packet %i, last-ack %i, sent %.2f s, raw sent %.2f s).", InLocalAck, SequenceIndexAcked, ElapsedTime, RawElapsedTime);
+void Frpg2ReliableUdpPacketStream::UpdateLossRate(bool Retransmit)
+{
+    LossRate = ((1.0 - LOSS_RATE_SMOOTHING) * LossRate) + (Retransmit ? LOSS_RATE_SMOOTHING : 0.0);
+}
 
-                SendRaw(Packet);
+void Frpg2ReliableUdpPacketStream::RetransmitOldest(const char* Reason)
+{
+    Frpg2ReliableUdpPacket& Packet = RetransmitBuffer.Front();
 
-                IsRetransmitting = true;
-                RetransmittingIndex = InLocalAck;
-                RetransmitPacket = Packet;
-                RetransmitAttempts = 0;
-                RetransmissionTimer = GetSeconds();
-            }
-        } 
+    uint32_t InLocalAck, InRemoteAck;
+    Packet.Header.GetAckCounters(InLocalAck, InRemoteAck);
+
+    VerboseS(Connection->GetName().c_str(), "Retransmitting packet (%s): packet=%u SequenceIndexAcked=%u RetransmitCount=%u RetransmitTimeout=%.3f SmoothedRtt=%.3f LastPacketLocalAck=%u LastPacketRemoteAck=%u", 
+        Reason, InLocalAck, SequenceIndexAcked, Packet.RetransmitCount, RetransmitTimeout, SmoothedRtt, LastPacketLocalAck, LastPacketRemoteAck);
+
+    Packet.RawSendTime = GetSeconds();
+    Packet.RetransmitCount++;
+
+    SendRaw(Packet);
+    UpdateLossRate(true);
+
+    Debug::UdpRetransmits.Add(1);
+
+    // Everything in flight right now needs acknowledging before we consider ourselves recovered.
+    if (!InRecovery)
+    {
+        InRecovery = true;
+
+        RecoverySequenceIndex = RetransmitBuffer.BackSequence();
     }
-    // TODO: Handle overflow - This is super crude,  do it in a better way.
-    else
+}
+
+void Frpg2ReliableUdpPacketStream::HandleOutgoing()
+{
+    double CurrentTime = GetSeconds();
+
+    // Trim off any retransmit packets that have now been acknowledged.
+    bool AckAdvanced = false;
+    size_t AckedCount = 0;
+    double RttSample = -1.0;
+
+    // Only grow the window if we were actually using it, otherwise a connection that trickles 
+    // packets out would end up with a huge window it has never tested the path with.
+    bool WindowLimited = (RetransmitBuffer.Size() * 2) >= (size_t)CongestionWindow;
+
+    while (!RetransmitBuffer.Empty())
     {
-        double ElapsedTime = (CurrentTime - RetransmissionTimer);
-        double ElapsedLastPacketTime = (CurrentTime - LastPacketRecievedTime);
+        Frpg2ReliableUdpPacket& Packet = RetransmitBuffer.Front();
+
+        if (!IsSequenceAcked(RetransmitBuffer.FrontSequence()))
+        {
+            break;
+        }
+
+        if (Packet.RetransmitCount == 0)
+        {
+            RttSample = CurrentTime - Packet.RawSendTime;
+        }
+
+        AckAdvanced = true;
+        AckedCount++;
+        ReleasePacket(RetransmitBuffer.PopFront());
+    }
 
-        if (RetransmittingIndex > MAX_ACK_VALUE_TOP_QUART && SequenceIndexAcked < MAX_ACK_VALUE_BOTTOM_QUART ||
-            SequenceIndexAcked >= RetransmittingIndex)
+    if (AckAdvanced)
+    {
+        if (RttSample >= 0.0)
         {
-            VerboseS(Connection->GetName().c_str(), "Recovered from retransmit.");
-            IsRetransmitting = false;
+            UpdateRtt(RttSample);
         }
-        else if (ElapsedTime > RETRANSMIT_CYCLE_INTERVAL)
+        else
         {
-            VerboseS(Connection->GetName().c_str(), 
-                "Retransmitting packet, initial retransmit has not been acknowledged: RetransmittingIndex=%u SequenceIndexAcked=%u RetransmitAttempts=%u ElapsedTime=%f LastHeardFrom=%f LastPacketLocalAck=%u LastPacketRemoteAck=%u", 
-                RetransmittingIndex, SequenceIndexAcked, RetransmitAttempts, ElapsedTime, ElapsedLastPacketTime, LastPacketLocalAck, LastPacketRemoteAck);
-            RetransmissionTimer = GetSeconds();
+            // Drop any backoff now we know the remote is still there.
+            RetransmitTimeout = HasRttSample ? std::clamp(SmoothedRtt + (4.0 * RttVariance), MIN_RETRANSMIT_TIMEOUT, MAX_RETRANSMIT_TIMEOUT) : INITIAL_RETRANSMIT_TIMEOUT;
+        }
 
-            RetransmitAttempts++;
-            if (RetransmitAttempts > RETRANSMIT_MAX_ATTEMPTS)
+        LastAckProgressTime = CurrentTime;
+        RetransmitDeadline = CurrentTime + RetransmitTimeout;
+        DuplicateAckCount = 0;
+
+        if (InRecovery)
+        {
+            if (RetransmitBuffer.Empty() || IsSequenceAcked(RecoverySequenceIndex))
             {
-                WarningS(Connection->GetName().c_str(), "Attempted retransmission of packet max number of times, assuming connection has died.");
-                InErrorState = true;
-                return;
+                VerboseS(Connection->GetName().c_str(), "Recovered from retransmit.");
+                InRecovery = false;
             }
             else
             {
-                SendRaw(RetransmitPacket);
+                // Only part of what was in flight when we started recovering has been acked, the 
+                // next packet along must have been lost as well so resend it now rather than waiting
+                // for another timeout.
+                RetransmitOldest("partial ack");
             }
         }
+
+        // The window is held while recovering, it was already cut when we entered recovery.
+        if (!InRecovery && WindowLimited)
+        {
+            GrowCongestionWindow(AckedCount);
+        }
+    }
+
+    if (!RetransmitBuffer.Empty())
+    {
+        if (CurrentTime - LastAckProgressTime > RETRANSMIT_GIVE_UP_TIME)
+        {
+            WarningS(Connection->GetName().c_str(), "Remote has not acknowledged any packets for %.1f seconds, assuming connection has died.", CurrentTime - LastAckProgressTime);
+            InErrorState = true;
+            return;
+        }
+
+        // The remote keeps acking the same packet, so the one after it has most likely been lost.
+        if (!InRecovery && DuplicateAckCount >= FAST_RETRANSMIT_DUPLICATE_ACKS)
+        {
+            DuplicateAckCount = 0;
+
+            ShrinkCongestionWindow(false);
+            RetransmitOldest("duplicate acks");
+            RetransmitDeadline = CurrentTime + RetransmitTimeout;
+        }
+        // Nothing has been acked in time, back off exponentially so we don't flood peers that have gone away.
+        else if (CurrentTime >= RetransmitDeadline)
+        {
+            RetransmitTimeout = std::min(RetransmitTimeout * 2.0, MAX_RETRANSMIT_TIMEOUT);
+
+            ShrinkCongestionWindow(true);
+            RetransmitOldest("timeout");
+            RetransmitDeadline = CurrentTime + RetransmitTimeout;
+        }
     }
 
-    // Do not send any packets if we have a lot of packets waiting for ack.
-    while (!IsRetransmitting && SendQueue.size() > 0 && RetransmitBuffer.size() < MAX_PACKETS_IN_FLIGHT)
+    // Do not send any packets if the congestion window is full.
+    while (!SendQueue.Empty() && RetransmitBuffer.Size() < (size_t)CongestionWindow)
     {
-        Frpg2ReliableUdpPacket Packet = SendQueue[0];
-        Packet.RawSendTime = GetSeconds();
-        SendQueue.erase(SendQueue.begin());
-        RetransmitBuffer.push_back(Packet);
+        uint32_t PacketSequence = SendQueue.FrontSequence();
+        std::unique_ptr<Frpg2ReliableUdpPacket> Packet = SendQueue.PopFront();
+        Packet->RawSendTime = CurrentTime;
+
+        // Timer starts when the first packet goes in flight.
+        if (RetransmitBuffer.Empty())
+        {
+            RetransmitDeadline = CurrentTime + RetransmitTimeout;
+            LastAckProgressTime = CurrentTime;
+        }
+
+        PiggybackDelayedAck(*Packet);
+        SendRaw(*Packet);
+
+        RetransmitBuffer.Insert(PacketSequence, std::move(Packet));
+        UpdateLossRate(false);
+    }
 
-        uint32_t InLocalAck, InRemoteAck;
-        Packet.Header.GetAckCounters(InLocalAck, InRemoteAck);
+    // Nothing was sent that we could attach the ack to in time, so send it on its own.
+    FlushDelayedAck(CurrentTime);
 
-        SendRaw(Packet);
+    // Make sure the server wakes up in time to retransmit anything that doesn't get acked.
+    if (!RetransmitBuffer.Empty())
+    {
+        NetEventLoop::Get().WakeAt(RetransmitDeadline);
     }
 }
 
@@ -786,7 +1074,7 @@ void Frpg2ReliableUdpPacketStream::Heartbeat()
 bool Frpg2ReliableUdpPacketStream::Pump()
 {
     // Mark as connection closed after we have sent everything in the queue.
-    if (State == Frpg2ReliableUdpStreamState::Closing && SendQueue.size() == 0)
+    if (State == Frpg2ReliableUdpStreamState::Closing && SendQueue.Empty())
     {
         LogS(Connection->GetName().c_str(), "Connection closed.");
         State = Frpg2ReliableUdpStreamState::Closed;
@@ -836,6 +1124,8 @@ bool Frpg2ReliableUdpPacketStream::Pump()
             State = Frpg2ReliableUdpStreamState::Closed;        
             return true;
         }
+
+        NetEventLoop::Get().WakeAt(CloseTimer + CONNECTION_CLOSE_TIMEOUT);
     }
 
     HandleIncoming();
@@ -872,7 +1162,7 @@ void Frpg2ReliableUdpPacketStream::HandledPacket(uint32_t AckSequence)
     }
     else
     {
-        Send_ACK(AckSequence);
+        QueueAck(AckSequence);
     }
 }
 
@@ -12,6 +12,8 @@
 #include "Server/Streams/Frpg2UdpPacketStream.h"
 #include "Server/Streams/Frpg2ReliableUdpPacket.h"
 
+#include "Shared/Core/Utils/SequenceRingBuffer.h"
+
 #include <unordered_set>
 
 struct Frpg2ReliableUdpPacket;
@@ -33,6 +35,10 @@ public:
     // is likely saturated or the packet is invalid.
     virtual bool Send(const Frpg2ReliableUdpPacket& Packet);
 
+    // Same as above, but takes the packet's payload rather than copying it. The packet is 
+    // given some previously used storage in its place which can be used to build the next packet.
+    bool Send(Frpg2ReliableUdpPacket&& Packet);
+
     // Notifies us that a packet has been handled and if a reply has been sent or not. This
     // allows us to know if we can now send an ACK for it or not. This is janky and only required
     // because of the stupid difference between ACK and DAT_ACK.
@@ -59,6 +65,22 @@ public:
     // Sends a heartbeat to the remote server.
     void Heartbeat();
 
+    // Smoothed round trip time to the remote end in seconds, 0 if we have no estimate yet.
+    double GetSmoothedRtt() { return SmoothedRtt; }
+
+    // Current time we wait for an ack before retransmitting, including any backoff.
+    double GetRetransmitTimeout() { return RetransmitTimeout; }
+
+    // Number of unacknowledged packets we currently allow in flight.
+    size_t GetCongestionWindow() { return (size_t)CongestionWindow; }
+
+    // Smoothed fraction of transmissions that have been retransmissions, 0 to 1.
+    double GetLossRate() { return LossRate; }
+
+    // Sets how long we can hold on to acks in the hope of piggybacking them on an outgoing
+    // data packet. 0 sends acks as soon as packets are recieved.
+    void SetAckDelay(double Delay) { AckDelay = Delay; }
+
 protected:
 
     bool DecodeReliablePacket(const Frpg2UdpPacket& Packet, Frpg2ReliableUdpPacket& Message);
@@ -66,7 +88,7 @@ protected:
 
     void HandleIncoming();
     void ConsumeIncomingPackets();
-    void HandleIncomingPacket(const Frpg2ReliableUdpPacket& Packet);
+    void HandleIncomingPacket(std::unique_ptr<Frpg2ReliableUdpPacket> Packet);
     void ProcessPacket(const Frpg2ReliableUdpPacket& Packet);
 
     void HandleOutgoing();
@@ -84,6 +106,40 @@ protected:
 
     bool SendRaw(const Frpg2ReliableUdpPacket& Packet);
 
+    // Does the work for both Send's. If Payload is provided its swapped into the queued packet rather than 
+    // the packet's payload being copied.
+    bool QueueSend(const Frpg2ReliableUdpPacket& Packet, std::vector<uint8_t>* Payload);
+
+    // Resends the oldest unacknowledged packet.
+    void RetransmitOldest(const char* Reason);
+
+    // Updates the round trip time estimate with a new sample.
+    void UpdateRtt(double Sample);
+
+    // Returns true if the remote has acknowledged the given local sequence index.
+    bool IsSequenceAcked(uint32_t Index);
+
+    // Acknowledges everything up to the given remote sequence index, either immediately or
+    // delayed depending on the ack delay.
+    void QueueAck(uint32_t RemoteIndex);
+
+    // Sends any delayed ack thats due, or attaches it to the packet if its a data packet.
+    void FlushDelayedAck(double CurrentTime);
+    void PiggybackDelayedAck(Frpg2ReliableUdpPacket& Packet);
+
+    // Returns true if remote sequence index A is after B, allowing for the sequence wrapping.
+    bool IsRemoteSequenceAfter(uint32_t A, uint32_t B);
+
+    // Grows the congestion window after AckedCount packets have been acknowledged.
+    void GrowCongestionWindow(size_t AckedCount);
+
+    // Shrinks the congestion window in response to loss. Timeouts are treated more harshly than
+    // duplicate acks, as they suggest nothing is getting through at all.
+    void ShrinkCongestionWindow(bool Timeout);
+
+    // Records if a transmission was a retransmit or not in the loss rate estimate.
+    void UpdateLossRate(bool Retransmit);
+
     void Send_SYN();
     void Send_SYN_ACK(uint32_t RemoteIndex);
     void Send_ACK(uint32_t RemoteIndex);
@@ -92,7 +148,11 @@ protected:
     void Send_FIN();
     void Send_HBT();
 
-    int GetPacketIndexByLocalSequence(const std::vector<Frpg2ReliableUdpPacket>& Queue, uint32_t SequenceIndex);
+    // Gets a packet from the free list, or allocates one if its empty.
+    std::unique_ptr<Frpg2ReliableUdpPacket> AllocatePacket();
+
+    // Returns a packet to the free list, its payload storage is kept for reuse.
+    void ReleasePacket(std::unique_ptr<Frpg2ReliableUdpPacket> Packet);
 
     bool IsOpcodeSequenced(Frpg2ReliableUdpOpCode Opcode);
 
@@ -129,44 +189,101 @@ protected:
     uint32_t RemoteSequenceIndex = 0;
     uint32_t RemoteSequenceIndexAcked = 0;
 
-    bool IsRetransmitting = false;
-    uint32_t RetransmittingIndex = 0;
-    double RetransmissionTimer = 0.0;
-    uint32_t RetransmitAttempts = 0;
-    Frpg2ReliableUdpPacket RetransmitPacket;
+    // Round trip time estimation, this follows RFC 6298. Samples are only taken from packets that have
+    // not been retransmitted, as we can't tell which transmission the ack was for (Karn's algorithm).
+    bool HasRttSample = false;
+    double SmoothedRtt = 0.0;
+    double RttVariance = 0.0;
+    double RetransmitTimeout = 0.0;
+
+    // Time at which the oldest unacknowledged packet is retransmitted if we don't get an ack.
+    double RetransmitDeadline = 0.0;
+
+    // Last time the remote acknowledged something new, used to decide when the connection has died.
+    double LastAckProgressTime = 0.0;
+
+    // Number of acks recieved in a row that didn't acknowledge anything new.
+    uint32_t DuplicateAckCount = 0;
+
+    // Set after we retransmit due to loss, until everything that was in flight at that
+    // point has been acknowledged. While set any partial ack immediately retransmits the
+    // next oldest packet, as that will have been lost as well.
+    bool InRecovery = false;
+    uint32_t RecoverySequenceIndex = 0;
+
+    // Congestion control, this is a fairly standard AIMD scheme along the lines of TCP Reno (RFC 5681).
+    // The window grows by one packet per ack until it reaches the slow start threshold, then by one packet 
+    // per round trip. Any loss halves it, and a retransmit timeout drops it back to the minimum.
+    double CongestionWindow = 0.0;
+    double SlowStartThreshold = 0.0;
+
+    // Exponentially weighted average of how many of our transmissions are retransmits.
+    double LossRate = 0.0;
+
+    // How many values ACK increases before it rolls over.
+    static constexpr uint32_t MAX_ACK_VALUE = 4096;
 
-    // TODO: All these should be shared pointers or something, we do way
-    //       too much data shuffling with raw packets.
+    // All the queues below are indexed by sequence number, incoming queues by the remote's
+    // sequence and outgoing ones by ours. Packets are moved between them rather than copied.
+    using PacketQueue = SequenceRingBuffer<Frpg2ReliableUdpPacket, MAX_ACK_VALUE>;
 
     // Packets that have been recieved and are awaiting processing. They will
     // stay in this queue until they are the next in the remote sequence index.
-    std::vector<Frpg2ReliableUdpPacket> PendingRecieveQueue;
+    PacketQueue PendingRecieveQueue;
 
     // Ordered packets read for whoever calls Recieve() to handle.
-    std::vector<Frpg2ReliableUdpPacket> RecieveQueue;
+    PacketQueue RecieveQueue;
 
     // Packets that are queued to send, will be sent when transmission is permitted.
-    std::vector<Frpg2ReliableUdpPacket> SendQueue;
+    PacketQueue SendQueue;
 
     // Queue of packets that have been send but not acknowledged yet, held on to 
     // until they have been acked.
-    std::vector<Frpg2ReliableUdpPacket> RetransmitBuffer; // Use priority queue.
+    PacketQueue RetransmitBuffer;
+
+    // Packets that have finished their trip through the queues, kept so their
+    // payload storage can be reused rather than reallocated.
+    std::vector<std::unique_ptr<Frpg2ReliableUdpPacket>> FreePackets;
+
+    // Maximum number of packets held on the free list.
+    const size_t MAX_FREE_PACKETS = 64;
 
     double ResendSynTimer = 0.0;
 
-    // We stop sending packets and queue them up until we start recieving acks.
-    const int MAX_PACKETS_IN_FLIGHT = 32;
+    // Delayed ack state, if set we owe the remote an ack for everything up to PendingAckSequence
+    // and it needs to be sent no later than PendingAckTime.
+    double AckDelay = 0.0;
+    bool AckPending = false;
+    uint32_t PendingAckSequence = 0;
+    double PendingAckTime = 0.0;
+
+    // Bounds of the congestion window, we stop sending packets and queue them up until we 
+    // start recieving acks once this many are in flight. The maximum needs to stay well inside
+    // a quarter of the ack range or the overflow handling gets confused.
+    const double INITIAL_CONGESTION_WINDOW = 16.0;
+    const double MIN_CONGESTION_WINDOW = 4.0;
+    const double MAX_CONGESTION_WINDOW = 256.0;
 
-    // We reeeeeeeaaaallly want this to be exponential backoff, but this works for now.
-    const float RETRANSMIT_INTERVAL = 1.0f;             // 1000 ms
+    // Weight each transmission has on the loss rate average.
+    const double LOSS_RATE_SMOOTHING = 1.0 / 64.0;
 
-    const float RETRANSMIT_CYCLE_INTERVAL = 0.2f;       // 200 ms
+    // Retransmit timeout used before we have any round trip time samples.
+    const double INITIAL_RETRANSMIT_TIMEOUT = 1.0;
+
+    // Bounds of the retransmit timeout. The timeout doubles each time it expires without the 
+    // remote acking anything, up to the maximum.
+    const double MIN_RETRANSMIT_TIMEOUT = 0.1;
+    const double MAX_RETRANSMIT_TIMEOUT = 8.0;
+
+    // Number of duplicate acks that cause us to retransmit without waiting for the timeout.
+    const uint32_t FAST_RETRANSMIT_DUPLICATE_ACKS = 3;
 
 #ifdef _DEBUG
     // Makes debugging easier.
-    const uint32_t RETRANSMIT_MAX_ATTEMPTS = std::numeric_limits<uint32_t>::max();        
+    const double RETRANSMIT_GIVE_UP_TIME = std::numeric_limits<double>::max();
 #else
-    const uint32_t RETRANSMIT_MAX_ATTEMPTS = 160;       // 160 * 0.2 = Will give up after trying to retransmiting for 30 seconds 
+    // Will give up if the remote hasn't acknowledged anything for 30 seconds.
+    const double RETRANSMIT_GIVE_UP_TIME = 30.0;
 #endif
 
     const float RESEND_SYN_INTERVAL = 0.5f;
@@ -176,9 +293,6 @@ protected:
     // How many seconds to wait for a graceful disconnection.
     const double CONNECTION_CLOSE_TIMEOUT = 5.0;
 
-    // How many values ACK increases before it rolls over.
-    const uint32_t MAX_ACK_VALUE = 4096;
-
     // Top quater ack range, used to handle overflows.
     const uint32_t MAX_ACK_VALUE_TOP_QUART = (4096 / 4) * 3;
 
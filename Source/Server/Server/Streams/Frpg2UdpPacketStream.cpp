@@ -11,6 +11,7 @@
 #include "Server/Streams/Frpg2UdpPacket.h"
 
 #include "Shared/Core/Network/NetConnection.h"
+#include "Shared/Core/Network/NetEventLoop.h"
 
 #include "Shared/Core/Utils/Logging.h"
 #include "Shared/Core/Utils/File.h"
@@ -41,11 +42,76 @@ Frpg2UdpPacketStream::Frpg2UdpPacketStream(std::shared_ptr<NetConnection> InConn
         DecryptionCipher = std::make_shared<CWCClientUDPCipher>(InCwcKey, AuthToken);
     }
 
-    RecieveBuffer.resize(64 * 1024);
-
     LastActivityTime = GetSeconds();
 }
 
+Frpg2UdpPacketStream::~Frpg2UdpPacketStream()
+{
+    // Tasks reference our ciphers and game interface, don't pull them out from under them.
+    if (IngressStrand)
+    {
+        IngressStrand->WaitIdle();
+    }
+}
+
+void Frpg2UdpPacketStream::SetParallelIngress(bool Enabled)
+{
+    if (Enabled && WorkerPool::Get().IsRunning())
+    {
+        if (!IngressStrand)
+        {
+            IngressStrand = WorkerPool::Get().CreateStrand();
+            Decrypted = std::make_shared<DecryptedPackets>();
+        }
+    }
+    else if (IngressStrand)
+    {
+        IngressStrand->WaitIdle();
+        IngressStrand = nullptr;
+
+        for (Frpg2UdpPacket& Packet : Decrypted->Packets)
+        {
+            RecieveQueue.push_back(std::move(Packet));
+        }
+        Decrypted = nullptr;
+    }
+}
+
+void Frpg2UdpPacketStream::SubmitDecrypt(std::vector<NetPacketHandle>&& Datagrams)
+{
+    IngressStrand->Submit([Output = Decrypted, DecryptionCipher = DecryptionCipher, Datagrams = std::move(Datagrams)]() mutable {
+
+        std::vector<Frpg2UdpPacket> Packets;
+        Packets.reserve(Datagrams.size());
+
+        bool Failed = false;
+        for (NetPacketHandle& Datagram : Datagrams)
+        {
+            size_t PayloadOffset = 0;
+            size_t PayloadLength = 0;
+            if (!DecryptionCipher->DecryptInPlace(Datagram->Data(), Datagram->Size(), PayloadOffset, PayloadLength))
+            {
+                Failed = true;
+                break;
+            }
+
+            Frpg2UdpPacket& Packet = Packets.emplace_back();
+            Packet.Payload.assign(Datagram->Data() + PayloadOffset, Datagram->Data() + PayloadOffset + PayloadLength);
+        }
+
+        // Hand the buffers back to the pool before waking the main thread.
+        Datagrams.clear();
+
+        {
+            std::scoped_lock lock(Output->Mutex);
+            Output->Packets.insert(Output->Packets.end(), std::make_move_iterator(Packets.begin()), std::make_move_iterator(Packets.end()));
+            Output->Failed |= Failed;
+        }
+
+        NetEventLoop::Get().Wake();
+    });
+}
+
 bool Frpg2UdpPacketStream::Pump()
 {
     // If we have got into an error state (due to failed send/recieves) then 
@@ -55,41 +121,50 @@ bool Frpg2UdpPacketStream::Pump()
         return true;
     }
 
+    std::vector<NetPacketHandle> DecryptBatch;
+
     // Recieve any pending packets.
     while (true)
     {
-        int BytesRecieved = 0;
-        RecieveBuffer.resize(RecieveBuffer.capacity());
-        if (!Connection->Recieve(RecieveBuffer, 0, (int)RecieveBuffer.size(), BytesRecieved))
+        // Datagrams are handed to us in the pooled buffer they were recieved into, we 
+        // decrypt straight out of that rather than copying it first.
+        NetPacketHandle Datagram;
+        if (!Connection->RecievePacket(Datagram))
         {
             WarningS(Connection->GetName().c_str(), "Failed to recieve on connection.");
             InErrorState = true;
             return true;
         }
 
-        if (BytesRecieved > 0)
+        if (Datagram)
         {
             LastActivityTime = GetSeconds();
 
-            RecieveBuffer.resize(BytesRecieved);
-
-            Frpg2UdpPacket Packet;
-            if (!BytesToPacket(RecieveBuffer, Packet))
+            if (IngressStrand && DecryptionCipher)
             {
-                WarningS(Connection->GetName().c_str(), "Failed to parse recieved packet.");
-                InErrorState = true;
-                return true;
+                DecryptBatch.push_back(std::move(Datagram));
+                continue;
             }
 
+            Frpg2UdpPacket Packet;
             if (DecryptionCipher)
             {        
-                std::vector<uint8_t> EncryptedBuffer = Packet.Payload;
-                if (!DecryptionCipher->Decrypt(EncryptedBuffer, Packet.Payload))
+                size_t PayloadOffset = 0;
+                size_t PayloadLength = 0;
+                if (!DecryptionCipher->DecryptInPlace(Datagram->Data(), Datagram->Size(), PayloadOffset, PayloadLength))
                 {
                     WarningS(Connection->GetName().c_str(), "Failed to decrypt packet payload.");
                     InErrorState = true;
                     return false;
                 }
+
+                Packet.Payload.assign(Datagram->Data() + PayloadOffset, Datagram->Data() + PayloadOffset + PayloadLength);
+            }
+            else if (!BytesToPacket(Datagram->Data(), Datagram->Size(), Packet))
+            {
+                WarningS(Connection->GetName().c_str(), "Failed to parse recieved packet.");
+                InErrorState = true;
+                return true;
             }
 
            /* static bool dumped = false;
@@ -99,7 +174,7 @@ bool Frpg2UdpPacketStream::Pump()
                 WriteBytesToFile("Z:\\ds3os\\Research\\Packet Traces\\game_login_compare\\from-game.dat", Packet.Payload);
             }*/
 
-            RecieveQueue.push_back(Packet);
+            RecieveQueue.push_back(std::move(Packet));
         }
         else
         {
@@ -107,43 +182,64 @@ bool Frpg2UdpPacketStream::Pump()
         }
     }
 
+    if (IngressStrand)
+    {
+        if (!DecryptBatch.empty())
+        {
+            SubmitDecrypt(std::move(DecryptBatch));
+        }
+
+        // Pick up anything the workers have finished decrypting.
+        std::scoped_lock lock(Decrypted->Mutex);
+
+        for (Frpg2UdpPacket& Packet : Decrypted->Packets)
+        {
+            RecieveQueue.push_back(std::move(Packet));
+        }
+        Decrypted->Packets.clear();
+
+        if (Decrypted->Failed)
+        {
+            WarningS(Connection->GetName().c_str(), "Failed to decrypt packet payload.");
+            InErrorState = true;
+            return false;
+        }
+    }
+
     return false;
 }
 
 bool Frpg2UdpPacketStream::Send(const Frpg2UdpPacket& Packet)
 {
-    Frpg2UdpPacket SendPacket = Packet;
+    // The payload is written straight into the buffer that gets handed to the connection, leaving
+    // space in front of it for the cipher to write its header into, and then encrypted in place.
+    size_t HeaderSize = EncryptionCipher ? EncryptionCipher->GetHeaderSize() : 0;
+
+    NetPacketHandle Datagram = NetPacketPool::Get().Acquire(HeaderSize + Packet.Payload.size());
+    Datagram->SetSize(HeaderSize + Packet.Payload.size());
+    memcpy(Datagram->Data() + HeaderSize, Packet.Payload.data(), Packet.Payload.size());
 
-    std::vector<uint8_t> DecryptedBuffer = SendPacket.Payload;
     if (EncryptionCipher)
     {
-        if (SendPacket.HasConnectionPrefix)
+        if (Packet.HasConnectionPrefix)
         {
             dynamic_cast<CWCClientUDPCipher*>(EncryptionCipher.get())->SetPacketsHaveConnectionPrefix(true);
         }
 
-        if (!EncryptionCipher->Encrypt(DecryptedBuffer, SendPacket.Payload))
+        if (!EncryptionCipher->EncryptInPlace(Datagram->Data(), Packet.Payload.size()))
         {
             WarningS(Connection->GetName().c_str(), "Failed to encrypt packet payload.");
             InErrorState = true;
             return false;
         }
 
-        if (SendPacket.HasConnectionPrefix)
+        if (Packet.HasConnectionPrefix)
         {
             dynamic_cast<CWCClientUDPCipher*>(EncryptionCipher.get())->SetPacketsHaveConnectionPrefix(false);
         }
     }
 
-    std::vector<uint8_t> Bytes;
-    if (!PacketToBytes(SendPacket, Bytes))
-    {
-        WarningS(Connection->GetName().c_str(), "Failed to send packet, unable to serialize.");
-        InErrorState = true;
-        return false;
-    }
-
-    if (!Connection->Send(Bytes, 0, (int)Bytes.size()))
+    if (!Connection->SendPacket(std::move(Datagram)))
     {
         WarningS(Connection->GetName().c_str(), "Failed to send packet.");
         InErrorState = true;
@@ -160,27 +256,15 @@ bool Frpg2UdpPacketStream::Recieve(Frpg2UdpPacket* OutputPacket)
         return false;
     }
 
-    *OutputPacket = RecieveQueue[0];
-    RecieveQueue.erase(RecieveQueue.begin());
+    *OutputPacket = std::move(RecieveQueue.front());
+    RecieveQueue.pop_front();
 
     return true;
 }
 
-bool Frpg2UdpPacketStream::BytesToPacket(const std::vector<uint8_t>& Buffer, Frpg2UdpPacket& Packet)
+bool Frpg2UdpPacketStream::BytesToPacket(const uint8_t* Buffer, size_t Length, Frpg2UdpPacket& Packet)
 {
-    int PayloadSize = (int)Buffer.size();
-
-    Packet.Payload.resize(PayloadSize);
-    memcpy(Packet.Payload.data(), Buffer.data(), PayloadSize);
-
-    return true;
-}
-
-bool Frpg2UdpPacketStream::PacketToBytes(const Frpg2UdpPacket& Packet, std::vector<uint8_t>& Buffer)
-{
-    Buffer.resize(Packet.Payload.size());
-
-    memcpy(Buffer.data(), Packet.Payload.data(), Packet.Payload.size());
+    Packet.Payload.assign(Buffer, Buffer + Length);
 
     return true;
 }
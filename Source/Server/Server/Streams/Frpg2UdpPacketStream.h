@@ -11,16 +11,27 @@
 
 #include <vector>
 #include <memory>
+#include <deque>
+#include <mutex>
 
 #include "Server/Streams/Frpg2UdpPacket.h"
 
+#include "Shared/Core/Utils/WorkerPool.h"
+
 class Cipher;
 class NetConnection;
+class NetPacketHandle;
 
 class Frpg2UdpPacketStream
 {
 public:
     Frpg2UdpPacketStream(std::shared_ptr<NetConnection> Connection, const std::vector<uint8_t>& CwcKey, uint64_t AuthToken, bool AsClient = false);
+    virtual ~Frpg2UdpPacketStream();
+
+    // When enabled (and the worker pool is running) incoming packets are decrypted on the worker 
+    // threads rather than in Pump. Derived streams also use this to move their own decoding off
+    // the calling thread. Work for a single stream is always done in the order it was recieved.
+    void SetParallelIngress(bool Enabled);
 
     // Returns true if send was successful, if false is returned the send queue
     // is likely saturated or the packet is invalid.
@@ -39,8 +50,7 @@ public:
 
 protected:
 
-    bool BytesToPacket(const std::vector<uint8_t>& Buffer, Frpg2UdpPacket& Packet);
-    bool PacketToBytes(const Frpg2UdpPacket& Packet, std::vector<uint8_t>& Buffer);
+    bool BytesToPacket(const uint8_t* Buffer, size_t Length, Frpg2UdpPacket& Packet);
 
 protected:
 
@@ -53,13 +63,28 @@ protected:
 
     bool IsClient = false;
 
+    // Strand all of this streams work on the worker pool is submitted to, null if
+    // parallel ingress is disabled.
+    std::shared_ptr<WorkerPool::Strand> IngressStrand;
+
 private:
+
+    // Decrypts a batch of datagrams on the worker pool.
+    void SubmitDecrypt(std::vector<NetPacketHandle>&& Datagrams);
+
+    // Packets decrypted on the worker pool waiting for Pump to pick them up.
+    struct DecryptedPackets
+    {
+        std::mutex Mutex;
+        std::vector<Frpg2UdpPacket> Packets;
+        bool Failed = false;
+    };
     
     double LastActivityTime;
 
-    std::vector<Frpg2UdpPacket> RecieveQueue;
+    std::deque<Frpg2UdpPacket> RecieveQueue;
 
-    std::vector<uint8_t> RecieveBuffer;
+    std::shared_ptr<DecryptedPackets> Decrypted;
 
     std::shared_ptr<Cipher> EncryptionCipher;
     std::shared_ptr<Cipher> DecryptionCipher;
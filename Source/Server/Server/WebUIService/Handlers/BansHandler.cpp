@@ -8,6 +8,7 @@
  */
 
 #include "Server/Server.h"
+#include "Server/ServerManager.h"
 #include "Server/GameService/GameService.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/WebUIService/Handlers/BansHandler.h"
@@ -34,7 +35,7 @@ bool BansHandler::handleGet(CivetServer* Server, struct mg_connection* Connectio
         return true;
     }
 
-    ServerDatabase& Database = Service->GetServer()->GetDatabase();
+    ServerDatabase& Database = Service->GetServer()->GetReadOnlyDatabase();
     std::vector<std::string> BannedSteamIds = Database.GetBannedSteamIds();
 
     nlohmann::json json;
@@ -96,10 +97,18 @@ bool BansHandler::handleDelete(CivetServer* Server, struct mg_connection* Connec
 
     std::string SteamId = json["steamId"];
 
-    ServerDatabase& Database = Service->GetServer()->GetDatabase();
-
     LogS("WebUI", "Unbanning player: %s", SteamId.c_str());
-    Database.UnbanPlayer(SteamId);
+
+    // The main database connection is only used from the main thread. The server may have been 
+    // pruned by the time the callback runs, so look it up again rather than holding onto it.
+    ServerManager& Manager = Service->GetServer()->GetManager();
+    std::string ServerId = Service->GetServer()->GetId();
+    Manager.QueueCallback([&Manager, ServerId, SteamId]() {
+        if (::Server* OwningServer = Manager.FindServer(ServerId))
+        {
+            OwningServer->GetDatabase().UnbanPlayer(SteamId);
+        }
+    });
 
     nlohmann::json responseJson;
     RespondJson(Connection, responseJson);
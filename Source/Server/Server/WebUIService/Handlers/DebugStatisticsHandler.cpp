@@ -32,6 +32,8 @@ void DebugStatisticsHandler::GatherData()
 {
     std::scoped_lock lock(DataMutex);
 
+    std::shared_ptr<GameService> Game = Service->GetServer()->GetService<GameService>();
+    MessageStatistics = Game->GetMessageDispatchTable().GetStatistics();
 }
 
 bool DebugStatisticsHandler::handleGet(CivetServer* Server, struct mg_connection* Connection)
@@ -67,6 +69,42 @@ bool DebugStatisticsHandler::handleGet(CivetServer* Server, struct mg_connection
             counters.push_back(stat);
         }
 
+        auto gauges = nlohmann::json::array();
+        for (DebugGauge* Gauge : DebugGauge::GetGauges())
+        {
+            auto stat = nlohmann::json::object();
+            stat["name"] = Gauge->GetName();
+            stat["current"] = StringFormat("%.0f", Gauge->GetCurrent());
+            stat["peak"] = StringFormat("%.0f", Gauge->GetPeak());
+            gauges.push_back(stat);
+        }
+
+        auto messages = nlohmann::json::array();
+        for (const MessageDispatchTable::MessageStatistics& Stats : MessageStatistics)
+        {
+            auto stat = nlohmann::json::object();
+            stat["name"] = Stats.Name.empty() ? StringFormat("0x%04x", (int)Stats.Type) : Stats.Name;
+            stat["calls"] = Stats.Calls;
+            stat["errors"] = Stats.Errors;
+            stat["average"] = StringFormat("%.3f ms", (Stats.TotalTime / Stats.Calls) * 1000.0);
+            stat["peak"] = StringFormat("%.3f ms", Stats.PeakTime * 1000.0);
+
+            auto histogram = nlohmann::json::array();
+            for (size_t i = 0; i < Stats.LatencyHistogram.size(); i++)
+            {
+                if (Stats.LatencyHistogram[i] > 0)
+                {
+                    auto bucket = nlohmann::json::object();
+                    bucket["bucket"] = MessageDispatchTable::GetLatencyBucketName(i);
+                    bucket["count"] = Stats.LatencyHistogram[i];
+                    histogram.push_back(bucket);
+                }
+            }
+            stat["histogram"] = histogram;
+
+            messages.push_back(stat);
+        }
+
         auto logs = nlohmann::json::array();
         if (Service->GetServer()->IsDefaultServer())
         {
@@ -82,6 +120,8 @@ bool DebugStatisticsHandler::handleGet(CivetServer* Server, struct mg_connection
 
         json["timers"] = timers;
         json["counters"] = counters;
+        json["gauges"] = gauges;
+        json["messages"] = messages;
         json["logs"] = logs;
     }
 
@@ -11,6 +11,7 @@
 
 #include "Server/WebUIService/Handlers/WebUIHandler.h"
 #include "Server/GameService/PlayerState.h"
+#include "Server/GameService/MessageDispatchTable.h"
 
 #include <mutex>
 
@@ -33,4 +34,6 @@ protected:
 
 	std::mutex DataMutex;
 
+	std::vector<MessageDispatchTable::MessageStatistics> MessageStatistics;
+
 };
\ No newline at end of file
@@ -8,6 +8,7 @@
  */
 
 #include "Server/Server.h"
+#include "Server/ServerManager.h"
 #include "Server/GameService/GameService.h"
 #include "Server/GameService/GameClient.h"
 #include "Server/WebUIService/Handlers/MessageHandler.h"
@@ -46,23 +47,32 @@ bool MessageHandler::handlePost(CivetServer* Server, struct mg_connection* Conne
     uint32_t playerId = json["playerId"];
     std::string message = json["message"];
 
-    std::shared_ptr<GameService> Game = Service->GetServer()->GetService<GameService>();
-    if (playerId == 0)
-    {
-        LogS("WebUI", "Sending message to all players: %s", message.c_str());
-        for (auto Client : Game->GetClients())
+    // Client message streams are only written to from the main thread. The server may have 
+    // been pruned by the time the callback runs, so look it up again rather than holding onto it.
+    ServerManager& Manager = Service->GetServer()->GetManager();
+    std::string ServerId = Service->GetServer()->GetId();
+    Manager.QueueCallback([&Manager, ServerId, playerId, message]() {
+        ::Server* OwningServer = Manager.FindServer(ServerId);
+        if (!OwningServer)
         {
-            Client->SendTextMessage(message);
+            return;
         }
-    }
-    else
-    {
-        if (std::shared_ptr<GameClient> Client = Game->FindClientByPlayerId(playerId))
+
+        std::shared_ptr<GameService> Game = OwningServer->GetService<GameService>();
+        if (playerId == 0)
         {
-            LogS("WebUI", "Sending message to %s: %s", Client->GetName().c_str(), message.c_str());
-            Client->SendTextMessage(message);
+            LogS("WebUI", "Sending message to all players: %s", message.c_str());
+            OwningServer->GetGameInterface().SendManagementMessage(*Game, Game->GetClients(), message);
         }
-    }
+        else
+        {
+            if (std::shared_ptr<GameClient> Client = Game->FindClientByPlayerId(playerId))
+            {
+                LogS("WebUI", "Sending message to %s: %s", Client->GetName().c_str(), message.c_str());
+                Client->SendTextMessage(message);
+            }
+        }
+    });
 
     nlohmann::json responseJson;
     RespondJson(Connection, responseJson);
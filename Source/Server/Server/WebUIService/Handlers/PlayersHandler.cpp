@@ -8,8 +8,10 @@
  */
 
 #include "Server/Server.h"
+#include "Server/ServerManager.h"
 #include "Server/GameService/GameService.h"
 #include "Server/GameService/GameClient.h"
+#include "Server/Streams/Frpg2ReliableUdpMessageStream.h"
 #include "Server/WebUIService/Handlers/PlayersHandler.h"
 #include "Shared/Core/Network/NetConnection.h"
 
@@ -47,6 +49,10 @@ void PlayersHandler::GatherPlayerInfo(PlayerInfo& Info, std::shared_ptr<GameClie
     Info.Status = "Unknown";
     Info.CovenantState = State.GetConvenantStatusDescription();
     Info.Status = State.GetStatusDescription();
+
+    Info.SendWindow = Client->MessageStream->GetCongestionWindow();
+    Info.RoundTripTime = Client->MessageStream->GetSmoothedRtt();
+    Info.LossRate = Client->MessageStream->GetLossRate();
 }
 
 void PlayersHandler::GatherData()
@@ -147,6 +153,9 @@ bool PlayersHandler::handleGet(CivetServer* Server, struct mg_connection* Connec
             playerJson["connectionTime"] = SecondsToString(Info.ConnectionDuration);
             playerJson["playTime"] = SecondsToString(Info.PlayTime);
             playerJson["antiCheatScore"] = Info.AntiCheatScore;
+            playerJson["sendWindow"] = Info.SendWindow;
+            playerJson["roundTripTime"] = StringFormat("%.0f ms", Info.RoundTripTime * 1000.0);
+            playerJson["lossRate"] = StringFormat("%.1f%%", Info.LossRate * 100.0);
 
             playerArray.push_back(playerJson);
         }
@@ -181,23 +190,35 @@ bool PlayersHandler::handleDelete(CivetServer* Server, struct mg_connection* Con
     uint32_t playerId = json["playerId"];
     bool ban = json["ban"];
 
-    ServerDatabase& Database = Service->GetServer()->GetDatabase();
-    std::shared_ptr<GameService> Game = Service->GetServer()->GetService<GameService>();    
-    if (std::shared_ptr<GameClient> Client = Game->FindClientByPlayerId(playerId))
-    {
-        if (ban)
+    // Clients and the main database connection are only used from the main thread. The server may have 
+    // been pruned by the time the callback runs, so look it up again rather than holding onto it.
+    ServerManager& Manager = Service->GetServer()->GetManager();
+    std::string ServerId = Service->GetServer()->GetId();
+    Manager.QueueCallback([&Manager, ServerId, playerId, ban]() {
+        ::Server* OwningServer = Manager.FindServer(ServerId);
+        if (!OwningServer)
         {
-            LogS("WebUI", "Banning player: %i", Client->GetPlayerState().GetPlayerId());
-
-            Database.BanPlayer(Client->GetPlayerState().GetSteamId());
+            return;
         }
-        else
+
+        ServerDatabase& Database = OwningServer->GetDatabase();
+        std::shared_ptr<GameService> Game = OwningServer->GetService<GameService>();    
+        if (std::shared_ptr<GameClient> Client = Game->FindClientByPlayerId(playerId))
         {
-            LogS("WebUI", "Disconnected player: %i", Client->GetPlayerState().GetPlayerId());
+            if (ban)
+            {
+                LogS("WebUI", "Banning player: %i", Client->GetPlayerState().GetPlayerId());
+
+                Database.BanPlayer(Client->GetPlayerState().GetSteamId());
+            }
+            else
+            {
+                LogS("WebUI", "Disconnected player: %i", Client->GetPlayerState().GetPlayerId());
+            }
+
+            Client->Connection->Disconnect();
         }
-
-        Client->Connection->Disconnect();
-    }
+    });
 
     nlohmann::json responseJson;
     RespondJson(Connection, responseJson);
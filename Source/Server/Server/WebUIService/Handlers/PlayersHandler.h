@@ -53,6 +53,10 @@ protected:
 		double AntiCheatScore;
 
 		double ConnectionDuration;
+
+		size_t SendWindow;
+		double RoundTripTime;
+		double LossRate;
 	};
 
 	void GatherPlayerInfo(PlayerInfo& Info, std::shared_ptr<GameClient> Client);
@@ -71,7 +71,7 @@ bool WebUIService::Init()
     Options.push_back("listening_ports");
     Options.push_back(StringFormat("%i", Port));
     Options.push_back("num_threads");
-    Options.push_back("5");
+    Options.push_back(ServerInstance->IsDefaultServer() ? "5" : StringFormat("%i", BuildConfig::WEBUI_SHARD_THREAD_COUNT));
 
     try
     {
@@ -24,44 +24,71 @@ CWCCipher::CWCCipher(const std::vector<uint8_t>& InKey)
 
 bool CWCCipher::Encrypt(const std::vector<uint8_t>& Input, std::vector<uint8_t>& Output)
 {
-    std::vector<uint8_t> IV(11, 0);
-    std::vector<uint8_t> Tag(16, 0);
-    std::vector<uint8_t> Payload = Input;
+    Output.resize(k_header_size + Input.size());
+    memcpy(Output.data() + k_header_size, Input.data(), Input.size());
 
-    FillRandomBytes(IV);
+    return EncryptInPlace(Output.data(), Input.size());
+}
+
+bool CWCCipher::Decrypt(const std::vector<uint8_t>& Input, std::vector<uint8_t>& Output)
+{
+    return Decrypt(Input.data(), Input.size(), Output);
+}
 
-    if (cwc_encrypt_message(IV.data(), 11, IV.data(), 11, (unsigned char*)Payload.data(), (unsigned long)Payload.size(), Tag.data(), 16, &CwcContext) == RETURN_ERROR)
+bool CWCCipher::Decrypt(const uint8_t* Input, size_t InputLength, std::vector<uint8_t>& Output)
+{
+    // Actually enough data for any data?
+    if (InputLength < k_header_size + 1)
     {
         return false;
     }
 
-    Output.resize(Payload.size() + 11 + 16);
+    Output.resize(InputLength - k_header_size);
+    memcpy(Output.data(), Input + k_header_size, Output.size());
 
-    memcpy(Output.data(), IV.data(), 11);
-    memcpy(Output.data() + 11, Tag.data(), 16);
-    memcpy(Output.data() + 11 + 16, Payload.data(), Payload.size());
+    return DecryptPayload(Input, Output.data(), Output.size());
+}
 
-    return true;
+bool CWCCipher::EncryptInPlace(uint8_t* Buffer, size_t PayloadLength)
+{
+    return EncryptPayload(Buffer, Buffer + k_header_size, PayloadLength);
 }
 
-bool CWCCipher::Decrypt(const std::vector<uint8_t>& Input, std::vector<uint8_t>& Output)
+bool CWCCipher::DecryptInPlace(uint8_t* Buffer, size_t Length, size_t& PayloadOffset, size_t& PayloadLength)
 {
-    std::vector<uint8_t> IV(11);
-    std::vector<uint8_t> Tag(16);
-    
     // Actually enough data for any data?
-    if (Input.size() < 11 + 16 + 1)
+    if (Length < k_header_size + 1)
+    {
+        return false;
+    }
+
+    PayloadOffset = k_header_size;
+    PayloadLength = Length - k_header_size;
+
+    return DecryptPayload(Buffer, Buffer + PayloadOffset, PayloadLength);
+}
+
+bool CWCCipher::EncryptPayload(uint8_t* Header, uint8_t* Payload, size_t PayloadLength)
+{
+    uint8_t* IV = Header;
+    uint8_t* Tag = Header + k_iv_size;
+
+    FillRandomBytes(IV, k_iv_size);
+
+    if (cwc_encrypt_message(IV, k_iv_size, IV, k_iv_size, Payload, (unsigned long)PayloadLength, Tag, k_tag_size, &CwcContext) == RETURN_ERROR)
     {
         return false;
     }
 
-    Output.resize(Input.size() - 11 - 16);
+    return true;
+}
 
-    memcpy(IV.data(), Input.data(), 11);
-    memcpy(Tag.data(), Input.data() + 11, 16);
-    memcpy(Output.data(), Input.data() + 11 + 16, Output.size());
+bool CWCCipher::DecryptPayload(const uint8_t* Header, uint8_t* Payload, size_t PayloadLength)
+{
+    const uint8_t* IV = Header;
+    const uint8_t* Tag = Header + k_iv_size;
 
-    if (cwc_decrypt_message(IV.data(), 11, IV.data(), 11, (unsigned char*)Output.data(), (unsigned long)Output.size(), Tag.data(), 16, &CwcContext) == RETURN_ERROR)
+    if (cwc_decrypt_message(IV, k_iv_size, IV, k_iv_size, Payload, (unsigned long)PayloadLength, Tag, k_tag_size, &CwcContext) == RETURN_ERROR)
     {
         return false;
     }
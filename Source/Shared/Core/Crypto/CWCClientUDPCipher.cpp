@@ -31,70 +31,91 @@ CWCClientUDPCipher::CWCClientUDPCipher(const std::vector<uint8_t>& InKey, uint64
 
 bool CWCClientUDPCipher::Encrypt(const std::vector<uint8_t>& Input, std::vector<uint8_t>& Output)
 {
-    std::vector<uint8_t> AuthToken = AuthTokenHeaderBytes;
-    std::vector<uint8_t> IV(11, 0);
-    std::vector<uint8_t> Tag(16, 0);
-    std::vector<uint8_t> Payload = Input;
-    std::vector<uint8_t> PacketType = { (uint8_t)PacketsHaveConnectionPrefix };
+    Output.resize(k_header_size + Input.size());
+    memcpy(Output.data() + k_header_size, Input.data(), Input.size());
 
-    FillRandomBytes(IV);
+    return EncryptInPlace(Output.data(), Input.size());
+}
 
-    // TODO: I have the distinct feeling this is different when replying as the packet type
-    //       doesn't get sent when going server->client ...
-    std::vector<uint8_t> Header;
-    Header.resize(20);
-    memcpy(Header.data(), IV.data(), 11);
-    memcpy(Header.data() + 11, AuthToken.data(), 8);
-    memcpy(Header.data() + 19, PacketType.data(), 1);
+bool CWCClientUDPCipher::Decrypt(const std::vector<uint8_t>& Input, std::vector<uint8_t>& Output)
+{
+    return Decrypt(Input.data(), Input.size(), Output);
+}
 
-    if (cwc_encrypt_message(IV.data(), 11, Header.data(), (unsigned long)Header.size(), (unsigned char*)Payload.data(), (unsigned long)Payload.size(), Tag.data(), 16, &CwcContext) == RETURN_ERROR)
+bool CWCClientUDPCipher::Decrypt(const uint8_t* Input, size_t InputLength, std::vector<uint8_t>& Output)
+{
+    // Actually enough data for any data?
+    if (InputLength < k_header_size + 1)
     {
         return false;
     }
 
-    Output.resize(Payload.size() + 8 + 11 + 16 + 1);
+    Output.resize(InputLength - k_header_size);
+    memcpy(Output.data(), Input + k_header_size, Output.size());
 
-    memcpy(Output.data(), AuthToken.data(), 8);
-    memcpy(Output.data() + 8, IV.data(), 11);
-    memcpy(Output.data() + 8 + 11, Tag.data(), 16);
-    memcpy(Output.data() + 8 + 11 + 16, PacketType.data(), 1);
-    memcpy(Output.data() + 8 + 11 + 16 + 1, Payload.data(), Payload.size());
+    return DecryptPayload(Input, Output.data(), Output.size());
+}
 
-    //Log("EncryptClient: PayloadSize=%i IV=%s Tag=%s Header=%s PacketType=%i", Payload.size(), BytesToHex(IV).c_str(), BytesToHex(Tag).c_str(), BytesToHex(Header).c_str(), PacketType[0]);
+bool CWCClientUDPCipher::EncryptInPlace(uint8_t* Buffer, size_t PayloadLength)
+{
+    return EncryptPayload(Buffer, Buffer + k_header_size, PayloadLength);
+}
 
-    return true;
+bool CWCClientUDPCipher::DecryptInPlace(uint8_t* Buffer, size_t Length, size_t& PayloadOffset, size_t& PayloadLength)
+{
+    // Actually enough data for any data?
+    if (Length < k_header_size + 1)
+    {
+        return false;
+    }
+
+    PayloadOffset = k_header_size;
+    PayloadLength = Length - k_header_size;
+
+    return DecryptPayload(Buffer, Buffer + PayloadOffset, PayloadLength);
 }
 
-bool CWCClientUDPCipher::Decrypt(const std::vector<uint8_t>& Input, std::vector<uint8_t>& Output)
+bool CWCClientUDPCipher::EncryptPayload(uint8_t* Header, uint8_t* Payload, size_t PayloadLength)
 {
-    std::vector<uint8_t> AuthToken(8);
-    std::vector<uint8_t> IV(11);
-    std::vector<uint8_t> Tag(16);
-    std::vector<uint8_t> PacketType(1);
+    uint8_t* AuthTokenBytes = Header;
+    uint8_t* IV = AuthTokenBytes + k_auth_token_size;
+    uint8_t* Tag = IV + k_iv_size;
+    uint8_t* PacketType = Tag + k_tag_size;
 
-    // Actually enough data for any data?
-    if (Input.size() < 8 + 11 + 16 + 1 + 1)
+    memcpy(AuthTokenBytes, AuthTokenHeaderBytes.data(), k_auth_token_size);
+    FillRandomBytes(IV, k_iv_size);
+    *PacketType = (uint8_t)PacketsHaveConnectionPrefix;
+
+    // TODO: I have the distinct feeling this is different when replying as the packet type
+    //       doesn't get sent when going server->client ...
+    uint8_t AuthHeader[k_iv_size + k_auth_token_size + k_packet_type_size];
+    memcpy(AuthHeader, IV, k_iv_size);
+    memcpy(AuthHeader + k_iv_size, AuthTokenBytes, k_auth_token_size);
+    memcpy(AuthHeader + k_iv_size + k_auth_token_size, PacketType, k_packet_type_size);
+
+    if (cwc_encrypt_message(IV, k_iv_size, AuthHeader, sizeof(AuthHeader), Payload, (unsigned long)PayloadLength, Tag, k_tag_size, &CwcContext) == RETURN_ERROR)
     {
         return false;
     }
 
-    Output.resize(Input.size() - 8 - 11 - 16 - 1);
+    return true;
+}
 
-    memcpy(AuthToken.data(), Input.data(), 8);
-    memcpy(IV.data(), Input.data() + 8, 11);
-    memcpy(Tag.data(), Input.data() + 8 + 11, 16);
-    memcpy(PacketType.data(), Input.data() + 8 + 11 + 16, 1);
-    memcpy(Output.data(), Input.data() + 8 + 11 + 16 + 1, Output.size());
+bool CWCClientUDPCipher::DecryptPayload(const uint8_t* Header, uint8_t* Payload, size_t PayloadLength)
+{
+    const uint8_t* AuthTokenBytes = Header;
+    const uint8_t* IV = AuthTokenBytes + k_auth_token_size;
+    const uint8_t* Tag = IV + k_iv_size;
+    const uint8_t* PacketType = Tag + k_tag_size;
 
-    std::vector<uint8_t> Header;
-    Header.resize(20);
-    memcpy(Header.data(), IV.data(), 11);
-    memcpy(Header.data() + 11, AuthToken.data(), 8);
-    memcpy(Header.data() + 19, PacketType.data(), 1);
+    uint8_t AuthHeader[k_iv_size + k_auth_token_size + k_packet_type_size];
+    memcpy(AuthHeader, IV, k_iv_size);
+    memcpy(AuthHeader + k_iv_size, AuthTokenBytes, k_auth_token_size);
+    memcpy(AuthHeader + k_iv_size + k_auth_token_size, PacketType, k_packet_type_size);
 
-    //Log("DecryptClient: PayloadSize=%i IV=%s Tag=%s Header=%s PacketType=%i", Output.size(), BytesToHex(IV).c_str(), BytesToHex(Tag).c_str(), BytesToHex(Header).c_str(), PacketType[0]);
+    //Log("DecryptClient: PayloadSize=%i PacketType=%i", PayloadLength, *PacketType);
 
-    if (cwc_decrypt_message(IV.data(), 11, Header.data(), (unsigned long)Header.size(), (unsigned char*)Output.data(), (unsigned long)Output.size(), Tag.data(), 16, &CwcContext) == RETURN_ERROR)
+    if (cwc_decrypt_message(IV, k_iv_size, AuthHeader, sizeof(AuthHeader), Payload, (unsigned long)PayloadLength, Tag, k_tag_size, &CwcContext) == RETURN_ERROR)
     {
         return false;
     }
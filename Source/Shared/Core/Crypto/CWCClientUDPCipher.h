@@ -24,9 +24,21 @@ public:
 
     bool Encrypt(const std::vector<uint8_t>& input, std::vector<uint8_t>& Output) override;
     bool Decrypt(const std::vector<uint8_t>& input, std::vector<uint8_t>& Output) override;
+    bool Decrypt(const uint8_t* Input, size_t InputLength, std::vector<uint8_t>& Output) override;
+
+    size_t GetHeaderSize() override { return k_header_size; }
+    bool EncryptInPlace(uint8_t* Buffer, size_t PayloadLength) override;
+    bool DecryptInPlace(uint8_t* Buffer, size_t Length, size_t& PayloadOffset, size_t& PayloadLength) override;
 
     void SetPacketsHaveConnectionPrefix(bool value) { PacketsHaveConnectionPrefix = value; }
 
+private:
+
+    // Header points at the k_header_size bytes that precede the payload, so the payload
+    // can be encrypted/decrypted without needing to be next to the header.
+    bool EncryptPayload(uint8_t* Header, uint8_t* Payload, size_t PayloadLength);
+    bool DecryptPayload(const uint8_t* Header, uint8_t* Payload, size_t PayloadLength);
+
 private:
     std::vector<uint8_t> Key;
 
@@ -37,4 +49,11 @@ private:
 
     bool PacketsHaveConnectionPrefix = false;
 
+    // Header is the auth token, IV, tag and then packet type.
+    static inline constexpr size_t k_auth_token_size = 8;
+    static inline constexpr size_t k_iv_size = 11;
+    static inline constexpr size_t k_tag_size = 16;
+    static inline constexpr size_t k_packet_type_size = 1;
+    static inline constexpr size_t k_header_size = k_auth_token_size + k_iv_size + k_tag_size + k_packet_type_size;
+
 };
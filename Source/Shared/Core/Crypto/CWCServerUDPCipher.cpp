@@ -31,56 +31,71 @@ CWCServerUDPCipher::CWCServerUDPCipher(const std::vector<uint8_t>& InKey, uint64
 
 bool CWCServerUDPCipher::Encrypt(const std::vector<uint8_t>& Input, std::vector<uint8_t>& Output)
 {
-    std::vector<uint8_t> IV(11, 0);
-    std::vector<uint8_t> Tag(16, 0);
-    std::vector<uint8_t> Payload = Input;
+    Output.resize(k_header_size + Input.size());
+    memcpy(Output.data() + k_header_size, Input.data(), Input.size());
 
-    FillRandomBytes(IV);
+    return EncryptInPlace(Output.data(), Input.size());
+}
 
-    std::vector<uint8_t> Header;
-    Header.resize(11);
-    memcpy(Header.data(), IV.data(), 11);
+bool CWCServerUDPCipher::Decrypt(const std::vector<uint8_t>& Input, std::vector<uint8_t>& Output)
+{
+    return Decrypt(Input.data(), Input.size(), Output);
+}
 
-    if (cwc_encrypt_message(IV.data(), 11, Header.data(), (unsigned long)Header.size(), (unsigned char*)Payload.data(), (unsigned long)Payload.size(), Tag.data(), 16, &CwcContext) == RETURN_ERROR)
+bool CWCServerUDPCipher::Decrypt(const uint8_t* Input, size_t InputLength, std::vector<uint8_t>& Output)
+{
+    // Actually enough data for any data?
+    if (InputLength < k_header_size + 1)
     {
         return false;
     }
 
-    Output.resize(Payload.size() + 11 + 16);
+    Output.resize(InputLength - k_header_size);
+    memcpy(Output.data(), Input + k_header_size, Output.size());
 
-    memcpy(Output.data(), IV.data(), 11);
-    memcpy(Output.data() + 11, Tag.data(), 16);
-    memcpy(Output.data() + 11 + 16, Payload.data(), Payload.size());
-
-    //Log("EncryptServer: PayloadSize=%i IV=%s Tag=%s Header=%s", Payload.size(), BytesToHex(IV).c_str(), BytesToHex(Tag).c_str(), BytesToHex(Header).c_str());
-
-    return true;
+    return DecryptPayload(Input, Output.data(), Output.size());
 }
 
-bool CWCServerUDPCipher::Decrypt(const std::vector<uint8_t>& Input, std::vector<uint8_t>& Output)
+bool CWCServerUDPCipher::EncryptInPlace(uint8_t* Buffer, size_t PayloadLength)
 {
-    std::vector<uint8_t> IV(11);
-    std::vector<uint8_t> Tag(16);
+    return EncryptPayload(Buffer, Buffer + k_header_size, PayloadLength);
+}
 
+bool CWCServerUDPCipher::DecryptInPlace(uint8_t* Buffer, size_t Length, size_t& PayloadOffset, size_t& PayloadLength)
+{
     // Actually enough data for any data?
-    if (Input.size() < 11 + 16 + 1)
+    if (Length < k_header_size + 1)
     {
         return false;
     }
 
-    Output.resize(Input.size() - 11 - 16);
+    PayloadOffset = k_header_size;
+    PayloadLength = Length - k_header_size;
 
-    memcpy(IV.data(), Input.data(), 11);
-    memcpy(Tag.data(), Input.data() + 11, 16);
-    memcpy(Output.data(), Input.data() + 11 + 16, Output.size());
+    return DecryptPayload(Buffer, Buffer + PayloadOffset, PayloadLength);
+}
+
+bool CWCServerUDPCipher::EncryptPayload(uint8_t* Header, uint8_t* Payload, size_t PayloadLength)
+{
+    uint8_t* IV = Header;
+    uint8_t* Tag = Header + k_iv_size;
 
-    std::vector<uint8_t> Header;
-    Header.resize(11);
-    memcpy(Header.data(), IV.data(), 11);
+    FillRandomBytes(IV, k_iv_size);
 
-    //Log("DecryptServer: PayloadSize=%i IV=%s Tag=%s Header=%s", Output.size(), BytesToHex(IV).c_str(), BytesToHex(Tag).c_str(), BytesToHex(Header).c_str());
+    if (cwc_encrypt_message(IV, k_iv_size, IV, k_iv_size, Payload, (unsigned long)PayloadLength, Tag, k_tag_size, &CwcContext) == RETURN_ERROR)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool CWCServerUDPCipher::DecryptPayload(const uint8_t* Header, uint8_t* Payload, size_t PayloadLength)
+{
+    const uint8_t* IV = Header;
+    const uint8_t* Tag = Header + k_iv_size;
 
-    if (cwc_decrypt_message(IV.data(), 11, Header.data(), (unsigned long)Header.size(), (unsigned char*)Output.data(), (unsigned long)Output.size(), Tag.data(), 16, &CwcContext) == RETURN_ERROR)
+    if (cwc_decrypt_message(IV, k_iv_size, IV, k_iv_size, Payload, (unsigned long)PayloadLength, Tag, k_tag_size, &CwcContext) == RETURN_ERROR)
     {
         return false;
     }
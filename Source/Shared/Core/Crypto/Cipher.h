@@ -10,7 +10,9 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 #include <vector>
+#include <cstring>
 
 class Cipher
 {
@@ -21,4 +23,47 @@ public:
     virtual bool Encrypt(const std::vector<uint8_t>& input, std::vector<uint8_t>& Output) = 0;
     virtual bool Decrypt(const std::vector<uint8_t>& input, std::vector<uint8_t>& Output) = 0;
 
+    // Decrypts directly from a raw buffer, lets callers avoid copying recieved data into a vector first.
+    virtual bool Decrypt(const uint8_t* Input, size_t InputLength, std::vector<uint8_t>& Output)
+    {
+        return Decrypt(std::vector<uint8_t>(Input, Input + InputLength), Output);
+    }
+
+    // Number of bytes the encrypted form of a payload has in front of it (iv, tag, etc). 
+    virtual size_t GetHeaderSize() { return 0; }
+
+    // Encrypts a payload in place. The payload must start GetHeaderSize() bytes into the buffer,
+    // the space before it is filled in with the header. Ciphers with a fixed size header
+    // override this to work without any allocation, the default goes through Encrypt.
+    virtual bool EncryptInPlace(uint8_t* Buffer, size_t PayloadLength)
+    {
+        size_t HeaderSize = GetHeaderSize();
+
+        std::vector<uint8_t> Output;
+        if (!Encrypt(std::vector<uint8_t>(Buffer + HeaderSize, Buffer + HeaderSize + PayloadLength), Output) ||
+            Output.size() != HeaderSize + PayloadLength)
+        {
+            return false;
+        }
+
+        memcpy(Buffer, Output.data(), Output.size());
+        return true;
+    }
+
+    // Decrypts a buffer in place, on success the decrypted payload is stored at PayloadOffset
+    // bytes into the buffer and is PayloadLength bytes long.
+    virtual bool DecryptInPlace(uint8_t* Buffer, size_t Length, size_t& PayloadOffset, size_t& PayloadLength)
+    {
+        std::vector<uint8_t> Output;
+        if (!Decrypt(Buffer, Length, Output) || Output.size() > Length)
+        {
+            return false;
+        }
+
+        memcpy(Buffer, Output.data(), Output.size());
+        PayloadOffset = 0;
+        PayloadLength = Output.size();
+        return true;
+    }
+
 };
@@ -31,6 +31,7 @@
 // that is used (TCP / UDP).
 
 #include "Shared/Core/Network/NetIPAddress.h"
+#include "Shared/Core/Network/NetPacketPool.h"
 
 class Cipher;
 
@@ -52,6 +53,18 @@ public:
     virtual bool Recieve(std::vector<uint8_t>& Buffer, int Offset, int Count, int& BytesRecieved) = 0; 
     virtual bool Send(const std::vector<uint8_t>& Buffer, int Offset, int Count) = 0;
 
+    // Recieves the next datagram without copying it, Packet is left empty if nothing is available.
+    // Only supported by datagram based connections.
+    virtual bool RecievePacket(NetPacketHandle& Packet) { return false; }
+
+    // Sends a datagram thats already been written into a pooled buffer, datagram based connections
+    // take ownership of the buffer rather than copying it.
+    virtual bool SendPacket(NetPacketHandle&& Packet)
+    {
+        std::vector<uint8_t> Buffer(Packet->Data(), Packet->Data() + Packet->Size());
+        return Send(Buffer, 0, (int)Buffer.size());
+    }
+
     virtual bool Disconnect() = 0;
 
     virtual bool IsConnected() = 0;
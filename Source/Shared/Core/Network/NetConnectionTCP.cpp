@@ -8,6 +8,7 @@
  */
 
 #include "Shared/Core/Network/NetConnectionTCP.h"
+#include "Shared/Core/Network/NetEventLoop.h"
 #include "Shared/Core/Utils/Logging.h"
 #include "Shared/Core/Utils/DebugObjects.h"
 #include "Shared/Core/Crypto/Cipher.h"
@@ -24,6 +25,9 @@ namespace {
     // Maximum backlog of data in a packet streams send queue. Sending
     // packets beyond this will result in disconnect.
     static inline constexpr size_t k_max_send_buffer_size = 512 * 1024;
+
+    // How long to wait before trying to send again when the socket buffer is full.
+    static inline constexpr double k_send_retry_interval = 0.001;
 };
 
 
@@ -37,6 +41,7 @@ NetConnectionTCP::NetConnectionTCP(SocketType InSocket, const std::string& InNam
     , Name(InName)
     , IPAddress(InAddress)
 {
+    NetEventLoop::Get().RegisterSocket(Socket);
 }
 
 NetConnectionTCP::~NetConnectionTCP()
@@ -117,6 +122,9 @@ bool NetConnectionTCP::Listen(int Port)
         return false;
     }
 
+    // Wake the server up when there are connections to accept.
+    NetEventLoop::Get().RegisterSocket(Socket);
+
     return true;
 }
 
@@ -274,6 +282,8 @@ bool NetConnectionTCP::Connect(std::string Hostname, int Port, bool ForceLastIpE
     }
 #endif
 
+    NetEventLoop::Get().RegisterSocket(Socket);
+
     return true;
 }
 
@@ -394,6 +404,8 @@ bool NetConnectionTCP::Disconnect()
     {
         return false;
     }
+
+    NetEventLoop::Get().UnregisterSocket(Socket);
     
 #if defined(_WIN32)
     closesocket(Socket);
@@ -459,5 +471,12 @@ bool NetConnectionTCP::Pump()
         }
     }
 
+    // We only wait on sockets becoming readable, so if the socket buffer is full make 
+    // sure we come back around shortly to try again.
+    if (SendQueue.size() > 0)
+    {
+        NetEventLoop::Get().WakeAfter(k_send_retry_interval);
+    }
+
     return false;
 }
\ No newline at end of file
@@ -8,12 +8,16 @@
  */
 
 #include "Shared/Core/Network/NetConnectionUDP.h"
+#include "Shared/Core/Network/NetEventLoop.h"
+#include "Shared/Core/Network/NetReactor.h"
 #include "Shared/Core/Utils/Logging.h"
 #include "Shared/Core/Utils/Random.h"
 #include "Shared/Core/Utils/DebugObjects.h"
 #include "Shared/Core/Crypto/Cipher.h"
 
 #include <cstring>
+#include <algorithm>
+#include <limits>
 
 #ifdef __linux__
 #include <arpa/inet.h>
@@ -32,7 +36,6 @@ namespace {
 NetConnectionUDP::NetConnectionUDP(const std::string& InName)
     : Name(InName)
 {
-    RecieveBuffer.resize(64 * 1024);
 }
 
 NetConnectionUDP::NetConnectionUDP(NetConnectionUDP* InParent, SocketType ParentSocket, sockaddr_in InDestination, const std::string& InName, const NetIPAddress& InAddress)
@@ -76,6 +79,20 @@ bool NetConnectionUDP::Listen(int Port)
         return false;        
     }
 
+    if (bReusePort)
+    {
+#if defined(__linux__)
+        if (setsockopt(Socket, SOL_SOCKET, SO_REUSEPORT, (const char*)&const_1, sizeof(const_1)))
+        {
+            ErrorS(GetName().c_str(), "Failed to set socket options: SO_REUSEPORT");
+            return false;
+        }
+#else
+        ErrorS(GetName().c_str(), "SO_REUSEPORT is not supported on this platform.");
+        return false;
+#endif
+    }
+
     // Boost buffer sizes 
     int BufferSize = 16 * 1024 * 1024;
     if (setsockopt(Socket, SOL_SOCKET, SO_RCVBUF, (const char*)&BufferSize, sizeof(BufferSize)))
@@ -101,17 +118,8 @@ bool NetConnectionUDP::Listen(int Port)
     }
 
     bListening = true;
-    bShuttingDownThreads = false;
-    bErrorOnThreads = false;
-
-    RecieveThread = std::make_unique<std::thread>([&]() {
-        RecieveThreadEntry();
-    });
-    SendThread = std::make_unique<std::thread>([&]() {
-        SendThreadEntry();
-    });
 
-    return true;
+    return StartIO();
 }
 
 std::shared_ptr<NetConnection> NetConnectionUDP::Accept()
@@ -188,17 +196,7 @@ bool NetConnectionUDP::Connect(std::string Hostname, int Port, bool ForceLastIpE
     memset(Destination.sin_zero, 0, sizeof(Destination.sin_zero));
     inet_pton(AF_INET, Hostname.c_str(), &(Destination.sin_addr));
     
-    bShuttingDownThreads = false;
-    bErrorOnThreads = false;
-
-    RecieveThread = std::make_unique<std::thread>([&]() {
-        RecieveThreadEntry();
-    });
-    SendThread = std::make_unique<std::thread>([&]() {
-        SendThreadEntry();
-    });
-
-    return true;
+    return StartIO();
 }
 
 bool NetConnectionUDP::Peek(std::vector<uint8_t>& Buffer, int Offset, int Count, int& BytesRecieved)
@@ -209,14 +207,14 @@ bool NetConnectionUDP::Peek(std::vector<uint8_t>& Buffer, int Offset, int Count,
         return true;
     }
 
-    std::vector<uint8_t>& NextPacket = RecieveQueue[0];
-    if (Count > NextPacket.size())
+    const NetPacketHandle& NextPacket = RecieveQueue.front();
+    if (Count > NextPacket->Size())
     {
         ErrorS(GetName().c_str(), "Unable to peek udp packet. Peek size is larger than datagram size.");
         return false;
     }
 
-    memcpy(Buffer.data() + Offset, NextPacket.data(), Count);
+    memcpy(Buffer.data() + Offset, NextPacket->Data(), Count);
     BytesRecieved = Count;
 
     return true;
@@ -230,39 +228,72 @@ bool NetConnectionUDP::Recieve(std::vector<uint8_t>& Buffer, int Offset, int Cou
         return true;
     }
 
-    std::vector<uint8_t> NextPacket = RecieveQueue[0];
-    if (NextPacket.size() > Count)
+    NetPacketHandle NextPacket = std::move(RecieveQueue.front());
+    if (NextPacket->Size() > Count)
     {
         ErrorS(GetName().c_str(), "Unable to recieve next udp packet, packet is larger than buffer. Packets must be recieved in their entirety.");
         return false;
     }
-    RecieveQueue.erase(RecieveQueue.begin());
+    RecieveQueue.pop_front();
+
+    memcpy(Buffer.data() + Offset, NextPacket->Data(), NextPacket->Size());
+    BytesRecieved = (int)NextPacket->Size();
+
+    return true;
+}
+
+bool NetConnectionUDP::RecievePacket(NetPacketHandle& Packet)
+{
+    if (RecieveQueue.empty())
+    {
+        Packet.Reset();
+        return true;
+    }
 
-    memcpy(Buffer.data() + Offset, NextPacket.data(), NextPacket.size());
-    BytesRecieved = (int)NextPacket.size();
+    Packet = std::move(RecieveQueue.front());
+    RecieveQueue.pop_front();
 
     return true;
 }
 
 bool NetConnectionUDP::Send(const std::vector<uint8_t>& Buffer, int Offset, int Count)
+{
+    NetPacketHandle Packet = NetPacketPool::Get().Acquire(Count);
+    Packet->SetSize(Count);
+    memcpy(Packet->Data(), Buffer.data() + Offset, Count);
+
+    return SendPacket(std::move(Packet));
+}
+
+bool NetConnectionUDP::SendPacket(NetPacketHandle&& Packet)
 {
     NetConnectionUDP* EnqueueConnection = this;
     if (bChild)
     {
+        // Parent has been torn down, nothing to send through.
+        if (Parent == nullptr)
+        {
+            return false;
+        }
+
         EnqueueConnection = Parent;    
     }
 
-    std::unique_ptr<PendingPacket> Pending = std::make_unique<PendingPacket>();
-    Pending->Data.resize(Count);
-    memcpy(Pending->Data.data(), Buffer.data() + Offset, Count);
-    Pending->SourceAddress = Destination;
-    Pending->ProcessTime = 0.0f;
+    PendingPacket Pending;
+    Pending.Data = std::move(Packet);
+    Pending.SourceAddress = Destination;
+    Pending.ProcessTime = 0.0f;
 
     {
         std::unique_lock lock(EnqueueConnection->SendQueueMutex);
         EnqueueConnection->SendQueue.push(std::move(Pending));
         EnqueueConnection->SendQueueCvar.notify_all();
     }
+
+    if (EnqueueConnection->ReactorThreadIndex >= 0 && !EnqueueConnection->bFlushRequested.exchange(true))
+    {
+        NetReactor::Get().RequestFlush(EnqueueConnection->ReactorThreadIndex, EnqueueConnection);
+    }
     
     return true;
 }
@@ -274,8 +305,21 @@ bool NetConnectionUDP::Disconnect()
         return false;
     }
 
-    if (!bChild)
+    if (bChild)
     {
+        if (Parent)
+        {
+            Parent->RemoveChildConnection(this);
+        }
+    }
+    else
+    {
+        if (ReactorThreadIndex >= 0)
+        {
+            NetReactor::Get().Unregister(ReactorThreadIndex, Socket, this);
+            ReactorThreadIndex = -1;
+        }
+
         {
             std::unique_lock lock(SendQueueMutex);
             bShuttingDownThreads = true;
@@ -298,6 +342,17 @@ bool NetConnectionUDP::Disconnect()
 #else
         close(Socket);
 #endif
+
+        // Orphan any children that are still alive so they don't try and 
+        // unregister themselves from us later.
+        for (auto& [Key, ChildWeakPtr] : ChildConnections)
+        {
+            if (std::shared_ptr<NetConnectionUDP> Child = ChildWeakPtr.lock())
+            {
+                Child->Parent = nullptr;
+            }
+        }
+        ChildConnections.clear();
     }
     Socket = INVALID_SOCKET_VALUE;
     
@@ -314,60 +369,102 @@ void NetConnectionUDP::Rename(const std::string& InName)
     Name = InName;
 }
 
+void NetConnectionUDP::SetBatchedIO(bool Enabled, int InBatchSize)
+{
+#if defined(__linux__)
+    bBatchedIO = Enabled && InBatchSize > 1;
+    BatchSize = std::max(1, InBatchSize);
+
+    if (bBatchedIO)
+    {
+        BatchRecieveBuffers.resize(BatchSize);
+        BatchRecieveAddresses.resize(BatchSize);
+        BatchRecieveIoVecs.resize(BatchSize);
+        BatchRecieveHeaders.resize(BatchSize);
+
+        BatchSendIoVecs.resize(BatchSize);
+        BatchSendHeaders.resize(BatchSize);
+    }
+#endif
+}
+
+void NetConnectionUDP::SetReusePort(bool Enabled)
+{
+    bReusePort = Enabled;
+}
+
 bool NetConnectionUDP::IsConnected()
 {
     // No way of telling with UDP, assume yes.
     return true;
 }
 
+uint64_t NetConnectionUDP::GetEndpointKey(const sockaddr_in& Address)
+{
+    return ((uint64_t)Address.sin_addr.s_addr << 16) | (uint64_t)Address.sin_port;
+}
+
+void NetConnectionUDP::RemoveChildConnection(NetConnectionUDP* Child)
+{
+    auto iter = ChildConnections.find(GetEndpointKey(Child->Destination));
+    if (iter == ChildConnections.end())
+    {
+        return;
+    }
+
+    // Only remove the entry if it still belongs to this child, a new connection from the 
+    // same endpoint may have already replaced it.
+    std::shared_ptr<NetConnectionUDP> Existing = iter->second.lock();
+    if (!Existing || Existing.get() == Child)
+    {
+        ChildConnections.erase(iter);
+    }
+}
+
 void NetConnectionUDP::ProcessPacket(const PendingPacket& Packet)
 {
     if (bListening)
     {
         // See if this came from a source we have an existing connection for.
-        bool bRoutedPacket = false;
-        for (auto ConnectionWeakPtr : ChildConnections)
+        uint64_t EndpointKey = GetEndpointKey(Packet.SourceAddress);
+        if (auto iter = ChildConnections.find(EndpointKey); iter != ChildConnections.end())
         {
-            if (std::shared_ptr<NetConnectionUDP> Connection = ConnectionWeakPtr.lock())
+            if (std::shared_ptr<NetConnectionUDP> Connection = iter->second.lock())
             {
-                if (Connection->Destination.sin_addr.s_addr == Packet.SourceAddress.sin_addr.s_addr &&
-                    Connection->Destination.sin_port == Packet.SourceAddress.sin_port)
-                {
-                    Connection->RecieveQueue.push_back(Packet.Data);
-                    bRoutedPacket = true;
-                    break;
-                }
+                Connection->RecieveQueue.push_back(Packet.Data);
+                return;
             }
+
+            // Child was destroyed without disconnecting, drop the stale entry and treat 
+            // this as a new connection.
+            ChildConnections.erase(iter);
         }
 
         // Otherwise create a new connection and use that.
-        if (!bRoutedPacket)
-        {
-            std::vector<char> ClientName;
-            ClientName.resize(64);
-            snprintf(ClientName.data(), ClientName.size(), "%s:%s:%i", Name.c_str(), inet_ntoa(Packet.SourceAddress.sin_addr), Packet.SourceAddress.sin_port);
+        std::vector<char> ClientName;
+        ClientName.resize(64);
+        snprintf(ClientName.data(), ClientName.size(), "%s:%s:%i", Name.c_str(), inet_ntoa(Packet.SourceAddress.sin_addr), Packet.SourceAddress.sin_port);
 
 #ifdef _WIN32
-            NetIPAddress NetClientAddress(
-                Packet.SourceAddress.sin_addr.S_un.S_un_b.s_b1,
-                Packet.SourceAddress.sin_addr.S_un.S_un_b.s_b2,
-                Packet.SourceAddress.sin_addr.S_un.S_un_b.s_b3,
-                Packet.SourceAddress.sin_addr.S_un.S_un_b.s_b4);
+        NetIPAddress NetClientAddress(
+            Packet.SourceAddress.sin_addr.S_un.S_un_b.s_b1,
+            Packet.SourceAddress.sin_addr.S_un.S_un_b.s_b2,
+            Packet.SourceAddress.sin_addr.S_un.S_un_b.s_b3,
+            Packet.SourceAddress.sin_addr.S_un.S_un_b.s_b4);
 #else
 
-            NetIPAddress NetClientAddress(
-                (Packet.SourceAddress.sin_addr.s_addr) & 0xFF,
-                (Packet.SourceAddress.sin_addr.s_addr >> 8) & 0xFF,
-                (Packet.SourceAddress.sin_addr.s_addr >> 16) & 0xFF,
-                (Packet.SourceAddress.sin_addr.s_addr >> 24) & 0xFF
-            );
+        NetIPAddress NetClientAddress(
+            (Packet.SourceAddress.sin_addr.s_addr) & 0xFF,
+            (Packet.SourceAddress.sin_addr.s_addr >> 8) & 0xFF,
+            (Packet.SourceAddress.sin_addr.s_addr >> 16) & 0xFF,
+            (Packet.SourceAddress.sin_addr.s_addr >> 24) & 0xFF
+        );
 #endif
 
-            std::shared_ptr<NetConnectionUDP> NewConnection = std::make_shared<NetConnectionUDP>(this, Socket, Packet.SourceAddress, ClientName.data(), NetClientAddress);
-            NewConnection->RecieveQueue.push_back(Packet.Data);
-            NewConnections.push_back(NewConnection);
-            ChildConnections.push_back(NewConnection);
-        }
+        std::shared_ptr<NetConnectionUDP> NewConnection = std::make_shared<NetConnectionUDP>(this, Socket, Packet.SourceAddress, ClientName.data(), NetClientAddress);
+        NewConnection->RecieveQueue.push_back(Packet.Data);
+        NewConnections.push_back(NewConnection);
+        ChildConnections[EndpointKey] = NewConnection;
     }
     else
     {
@@ -379,10 +476,6 @@ void NetConnectionUDP::RecieveThreadEntry()
 {
     while (!bShuttingDownThreads)
     {
-        // Recieve any pending datagrams and route to the appropriate child recieve queue.
-        socklen_t SourceAddressSize = sizeof(struct sockaddr);
-        sockaddr_in SourceAddress = { 0 };
-
         timeval Timeout;
         Timeout.tv_sec = 0;
         Timeout.tv_usec = 1000 * 10;
@@ -398,97 +491,301 @@ void NetConnectionUDP::RecieveThreadEntry()
             continue;
         }
 
-        // Recieve the next message on the socket.
-        int Flags = 0;
-        int Result = recvfrom(Socket, (char*)RecieveBuffer.data(), (int)RecieveBuffer.size(), Flags, (sockaddr*)&SourceAddress, &SourceAddressSize);
-        if (Result < 0)
+#if defined(__linux__)
+        if (bBatchedIO)
         {
+            // Nothing else runs on this thread, so drain everything that's waiting.
+            RecieveBatch(std::numeric_limits<int>::max());
+            continue;
+        }
+#endif
+
+        RecieveSingle(0);
+    }
+}
+
+bool NetConnectionUDP::RecieveSingle(int Flags)
+{
+    // Recieve any pending datagrams and route to the appropriate child recieve queue.
+    socklen_t SourceAddressSize = sizeof(struct sockaddr);
+    sockaddr_in SourceAddress = { 0 };
+
+    // Recieve the next message on the socket, straight into a pooled buffer.
+    NetPacketHandle Buffer = NetPacketPool::Get().Acquire();
+#if defined(__linux__)
+    // Returns the real length of the datagram even if it was truncated, so we can detect it.
+    Flags |= MSG_TRUNC;
+#endif
+    int Result = recvfrom(Socket, (char*)Buffer->Data(), (int)Buffer->Capacity(), Flags, (sockaddr*)&SourceAddress, &SourceAddressSize);
+    if (Result < 0)
+    {
 #if defined(_WIN32)
-            int error = WSAGetLastError();
+        int error = WSAGetLastError();
 #else
-            int error = errno;
+        int error = errno;
 #endif
 
-            // Blocking is fine, just return.
+        // Blocking is fine, just return.
 #if defined(_WIN32)
-            if (error == WSAEWOULDBLOCK)
+        if (error != WSAEWOULDBLOCK)
 #else        
-            if (error == EWOULDBLOCK || error == EAGAIN)
+        if (error != EWOULDBLOCK && error != EAGAIN)
 #endif
+        {
+            ErrorS(GetName().c_str(), "Failed to recieve with error 0x%08x.", error);
+            // We ignore the error and keep continuing to try and recieve.
+        }
+
+        return false;
+    }
+    else if (Result > (int)Buffer->Capacity())
+    {
+        WarningS(GetName().c_str(), "Dropping datagram larger than packet buffer (%i bytes).", Result);
+    }
+    else if (Result > 0)
+    {
+        Buffer->SetSize(Result);
+
+        PendingPacket Pending;
+        if (CreatePendingPacket(std::move(Buffer), SourceAddress, Pending))
+        {
+            std::unique_lock lock(PendingPacketsMutex);
+            PendingPackets.push(std::move(Pending));
+        }
+
+        NetEventLoop::Get().Wake();
+
+        //Log("<< %zi bytes", (size_t)Result);
+
+        Debug::UdpBytesRecieved.Add(Result);
+    }
+
+    return true;
+}
+
+bool NetConnectionUDP::CreatePendingPacket(NetPacketHandle&& Data, const sockaddr_in& SourceAddress, PendingPacket& Output)
+{
+    if constexpr (k_emulate_dropped_backs)
+    {
+        if (FRandRange(0.0f, 1.0f) <= k_drop_packet_probability)
+        {
+            return false;
+        }
+    }
+
+    double Latency = k_latency_minimum + FRandRange(-k_latency_variance, k_latency_variance);
+
+    Output.Data = std::move(Data);
+    Output.SourceAddress = SourceAddress;
+    Output.ProcessTime = GetSeconds() + (Latency / 1000.0f);
+
+    return true;
+}
+
+#if defined(__linux__)
+
+void NetConnectionUDP::RecieveBatch(int MaxBatches)
+{
+    std::vector<PendingPacket> Recieved;
+
+    // Keep draining the socket until we get a partial batch, that means there is nothing
+    // more waiting and we can go back to sleeping, or until we've done as many batches as allowed.
+    for (int Batch = 0; Batch < MaxBatches && !bShuttingDownThreads; Batch++)
+    {
+        for (int i = 0; i < BatchSize; i++)
+        {
+            // Slots handed off to the pending queue in the last batch need refilling.
+            if (!BatchRecieveBuffers[i])
             {
-                continue;
+                BatchRecieveBuffers[i] = NetPacketPool::Get().Acquire();
             }
 
-            ErrorS(GetName().c_str(), "Failed to recieve with error 0x%08x.", error);
-            // We ignore the error and keep continuing to try and recieve.
+            BatchRecieveIoVecs[i].iov_base = BatchRecieveBuffers[i]->Data();
+            BatchRecieveIoVecs[i].iov_len = BatchRecieveBuffers[i]->Capacity();
+
+            msghdr& Header = BatchRecieveHeaders[i].msg_hdr;
+            memset(&Header, 0, sizeof(Header));
+            Header.msg_name = &BatchRecieveAddresses[i];
+            Header.msg_namelen = sizeof(sockaddr_in);
+            Header.msg_iov = &BatchRecieveIoVecs[i];
+            Header.msg_iovlen = 1;
+
+            BatchRecieveHeaders[i].msg_len = 0;
         }
-        else if (Result > 0)
+
+        int Result = recvmmsg(Socket, BatchRecieveHeaders.data(), BatchSize, MSG_DONTWAIT, nullptr);
+        if (Result < 0)
         {
-            std::vector<uint8_t> Packet(RecieveBuffer.data(), RecieveBuffer.data() + Result);
+            int error = errno;
+            if (error != EWOULDBLOCK && error != EAGAIN && error != EINTR)
+            {
+                ErrorS(GetName().c_str(), "Failed to recieve with error 0x%08x.", error);
+                // We ignore the error and keep continuing to try and recieve.
+            }
+            break;
+        }
 
-            bool bDropPacket = false;
+        Debug::UdpRecieveBatches.Add(1);
+        Debug::UdpDatagramsRecieved.Add(Result);
 
-            if constexpr (k_emulate_dropped_backs)
+        for (int i = 0; i < Result; i++)
+        {
+            const mmsghdr& Message = BatchRecieveHeaders[i];
+            if ((Message.msg_hdr.msg_flags & MSG_TRUNC) != 0)
             {
-                if (FRandRange(0.0f, 1.0f) <= k_drop_packet_probability)
+                WarningS(GetName().c_str(), "Dropping datagram larger than packet buffer (%zi bytes).", BatchRecieveBuffers[i]->Capacity());
+                continue;
+            }
+
+            if (Message.msg_len > 0)
+            {
+                BatchRecieveBuffers[i]->SetSize(Message.msg_len);
+
+                PendingPacket Pending;
+                if (CreatePendingPacket(std::move(BatchRecieveBuffers[i]), BatchRecieveAddresses[i], Pending))
                 {
-                    bDropPacket = true;
+                    Recieved.push_back(std::move(Pending));
                 }
+
+                Debug::UdpBytesRecieved.Add(Message.msg_len);
             }
+        }
 
-            if (!bDropPacket)
-            {
-                double Latency = k_latency_minimum + FRandRange(-k_latency_variance, k_latency_variance);
+        if (Result < BatchSize)
+        {
+            break;
+        }
+    }
+
+    if (!Recieved.empty())
+    {
+        std::unique_lock lock(PendingPacketsMutex);
+        for (auto& Pending : Recieved)
+        {
+            PendingPackets.push(std::move(Pending));
+        }
+    }
+
+    NetEventLoop::Get().Wake();
+}
+
+bool NetConnectionUDP::SendBatch(std::vector<PendingPacket>& Packets)
+{
+    size_t Offset = 0;
+    while (Offset < Packets.size())
+    {
+        int Count = (int)std::min<size_t>(BatchSize, Packets.size() - Offset);
+        for (int i = 0; i < Count; i++)
+        {
+            PendingPacket& Packet = Packets[Offset + i];
+
+            BatchSendIoVecs[i].iov_base = Packet.Data->Data();
+            BatchSendIoVecs[i].iov_len = Packet.Data->Size();
 
-                std::unique_ptr<PendingPacket> Pending = std::make_unique<PendingPacket>();
-                Pending->Data = Packet;
-                Pending->SourceAddress = SourceAddress;
-                Pending->ProcessTime = GetSeconds() + (Latency / 1000.0f);
+            msghdr& Header = BatchSendHeaders[i].msg_hdr;
+            memset(&Header, 0, sizeof(Header));
+            Header.msg_name = &Packet.SourceAddress;
+            Header.msg_namelen = sizeof(sockaddr_in);
+            Header.msg_iov = &BatchSendIoVecs[i];
+            Header.msg_iovlen = 1;
 
-                std::unique_lock lock(PendingPacketsMutex);
-                PendingPackets.push(std::move(Pending));
+            BatchSendHeaders[i].msg_len = 0;
+        }
+
+        int Result = sendmmsg(Socket, BatchSendHeaders.data(), Count, 0);
+        if (Result < 0)
+        {
+            int error = errno;
+
+            // Blocking is fine, just try again.
+            if (error == EWOULDBLOCK || error == EAGAIN || error == EINTR)
+            {
+                continue;
             }
 
-            //Log("<< %zi bytes", (size_t)Result);
+            ErrorS(GetName().c_str(), "Failed to send with error 0x%08x.", error);
+            return false;
+        }
+
+        Debug::UdpSendBatches.Add(1);
+        Debug::UdpDatagramsSent.Add(Result);
 
-            Debug::UdpBytesRecieved.Add(Result);
+        for (int i = 0; i < Result; i++)
+        {
+            const PendingPacket& Packet = Packets[Offset + i];
+            if (BatchSendHeaders[i].msg_len != Packet.Data->Size())
+            {
+                ErrorS(GetName().c_str(), "Failed to send packet in its entirety, wanted to send %i but sent %i. Datagram larger than MTU?", Packet.Data->Size(), BatchSendHeaders[i].msg_len);
+                return false;
+            }
+
+            Debug::UdpBytesSent.Add(Packet.Data->Size());
         }
+
+        // sendmmsg can return early if it would block partway through the batch, just 
+        // carry on from where it got to.
+        Offset += Result;
     }
+
+    return true;
 }
 
+#endif
+
 void NetConnectionUDP::SendThreadEntry()
 {
     while (!bShuttingDownThreads)
     {
-        std::unique_ptr<PendingPacket> SendPacket;
-
-        // Grab next packet to send.
         {
             std::unique_lock lock(SendQueueMutex);
-            while (true)
+            while (SendQueue.empty())
             {
                 if (bShuttingDownThreads)
                 {
                     return;
                 }
 
-                if (!SendQueue.empty())
-                {
-                    SendPacket = std::move(SendQueue.front());
-                    SendQueue.pop();
-                    break;
-                }
-                else
-                {
-                    SendQueueCvar.wait(lock);
-                }
+                SendQueueCvar.wait(lock);
             }
         }
 
+        if (!FlushSendQueue())
+        {
+            bErrorOnThreads = true;
+            return;
+        }
+    }
+}
+
+bool NetConnectionUDP::FlushSendQueue()
+{
+    // Grab everything thats currently queued in one go.
+    {
+        std::unique_lock lock(SendQueueMutex);
+        while (!SendQueue.empty())
+        {
+            PacketsToSend.push_back(std::move(SendQueue.front()));
+            SendQueue.pop();
+        }
+    }
+
+    bool Success = true;
+
+#if defined(__linux__)
+    if (bBatchedIO)
+    {
+        Success = SendBatch(PacketsToSend);
+        PacketsToSend.clear();
+        return Success;
+    }
+#endif
+
+    for (PendingPacket& SendPacket : PacketsToSend)
+    {
         // Send the packet!
         while (true)
         {
-            int Result = sendto(Socket, (char*)SendPacket->Data.data(), SendPacket->Data.size(), 0, (sockaddr*)&SendPacket->SourceAddress, sizeof(sockaddr_in));
+            int Result = sendto(Socket, (char*)SendPacket.Data->Data(), SendPacket.Data->Size(), 0, (sockaddr*)&SendPacket.SourceAddress, sizeof(sockaddr_in));
             if (Result < 0)
             {
     #if defined(_WIN32)
@@ -508,22 +805,88 @@ void NetConnectionUDP::SendThreadEntry()
                 }
 
                 ErrorS(GetName().c_str(), "Failed to send with error 0x%08x.", error);
-                bErrorOnThreads = true;
-                return;
+                Success = false;
+                break;
             }
-            else if (Result != SendPacket->Data.size())
+            else if (Result != SendPacket.Data->Size())
             {
-                ErrorS(GetName().c_str(), "Failed to send packet in its entirety, wanted to send %i but sent %i. Datagram larger than MTU?", SendPacket->Data.size(), Result);
-                bErrorOnThreads = true;
-                return;
+                ErrorS(GetName().c_str(), "Failed to send packet in its entirety, wanted to send %i but sent %i. Datagram larger than MTU?", SendPacket.Data->Size(), Result);
+                Success = false;
+                break;
             }
 
-            Debug::UdpBytesSent.Add(SendPacket->Data.size());
+            Debug::UdpBytesSent.Add(SendPacket.Data->Size());
             break;
         }
 
-        //Log(">> %zi bytes", SendPacket->Data.size());
+        //Log(">> %zi bytes", SendPacket.Data->Size());
+
+        if (!Success)
+        {
+            break;
+        }
     }
+
+    PacketsToSend.clear();
+    return Success;
+}
+
+void NetConnectionUDP::OnReadable()
+{
+#if defined(__linux__)
+    // Bounded so one busy socket can't starve the others on this thread, epoll will
+    // tell us again if there is still data waiting.
+    if (bBatchedIO)
+    {
+        RecieveBatch(std::max(1, k_max_reactor_recieves / BatchSize));
+        return;
+    }
+
+    for (int i = 0; i < k_max_reactor_recieves; i++)
+    {
+        if (!RecieveSingle(MSG_DONTWAIT))
+        {
+            break;
+        }
+    }
+#endif
+}
+
+void NetConnectionUDP::OnFlush()
+{
+    bFlushRequested = false;
+
+    if (!FlushSendQueue())
+    {
+        bErrorOnThreads = true;
+    }
+}
+
+bool NetConnectionUDP::StartIO()
+{
+    bShuttingDownThreads = false;
+    bErrorOnThreads = false;
+
+    // Share the process-wide network threads if they are running, otherwise fall back to our own.
+    if (NetReactor::Get().IsRunning())
+    {
+        ReactorThreadIndex = NetReactor::Get().Register(Socket, this);
+        if (ReactorThreadIndex >= 0)
+        {
+            return true;
+        }
+
+        WarningS(GetName().c_str(), "Failed to register with network threads, falling back to dedicated threads.");
+    }
+
+    RecieveThread = std::make_unique<std::thread>([&]() {
+        RecieveThreadEntry();
+    });
+    SendThread = std::make_unique<std::thread>([&]() {
+        SendThreadEntry();
+    });
+
+    return true;
 }
 
 bool NetConnectionUDP::Pump()
@@ -543,8 +906,6 @@ bool NetConnectionUDP::Pump()
 
     // Recieve pending packets.
     {
-        std::vector<std::unique_ptr<PendingPacket>> PacketsToProcess;
-        
         // Grab all the packets in the recieve queue that currently need processing.
         // Keep this code slim so we don't hold the mutex longer than neccessary (as we don't currently do this lock-free)
         {
@@ -552,7 +913,7 @@ bool NetConnectionUDP::Pump()
             while (!PendingPackets.empty())
             {
                 bool Process = true;
-                PendingPacket* NextPacket = PendingPackets.front().get();                
+                PendingPacket* NextPacket = &PendingPackets.front();
 
                 if constexpr (k_emulate_latency)
                 {
@@ -566,6 +927,7 @@ bool NetConnectionUDP::Pump()
                 }
                 else
                 {
+                    NetEventLoop::Get().WakeAt(NextPacket->ProcessTime);
                     break;
                 }
             }
@@ -574,21 +936,11 @@ bool NetConnectionUDP::Pump()
         // Process away.
         for (auto& packet : PacketsToProcess)
         {
-            ProcessPacket(*packet);
+            ProcessPacket(packet);
         }
-    }
 
-    // Clear out and children who have gone stale.
-    for (auto iter = ChildConnections.begin(); iter != ChildConnections.end(); /*empty*/)
-    {
-        if ((*iter).expired())
-        {
-            iter = ChildConnections.erase(iter);
-        }
-        else
-        {
-            iter++;
-        }
+        // Cleared rather than reallocated so we keep the capacity between pumps.
+        PacketsToProcess.clear();
     }
 
     return false;
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "Shared/Core/Network/NetConnection.h"
+#include "Shared/Core/Network/NetReactor.h"
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -31,9 +32,12 @@
 #include <queue>
 #include <mutex>
 #include <condition_variable>
+#include <unordered_map>
+#include <deque>
 
 class NetConnectionUDP
     : public NetConnection
+    , public NetReactorHandler
 {
 public:
 #if defined(_WIN32)
@@ -62,6 +66,8 @@ public:
     virtual bool Peek(std::vector<uint8_t>& Buffer, int Offset, int Count, int& BytesRecieved) override;
     virtual bool Recieve(std::vector<uint8_t>& Buffer, int Offset, int Count, int& BytesRecieved) override;
     virtual bool Send(const std::vector<uint8_t>& Buffer, int Offset, int Count) override;
+    virtual bool SendPacket(NetPacketHandle&& Packet) override;
+    virtual bool RecievePacket(NetPacketHandle& Packet) override;
 
     virtual bool Disconnect() override;
 
@@ -71,19 +77,54 @@ public:
     virtual std::string GetName() override;
     virtual void Rename(const std::string& Name) override;
 
+    // Enables batched datagram IO (recvmmsg/sendmmsg) on platforms that support it. Up to
+    // BatchSize datagrams will be recieved or sent per syscall. Must be called before Listen/Connect.
+    void SetBatchedIO(bool Enabled, int BatchSize);
+
+    // Allows multiple sockets to listen on the same port (SO_REUSEPORT), the kernel then hashes incoming
+    // datagrams between them by source address so a given remote endpoint always arrives on the same
+    // socket. Only supported on linux. Must be called before Listen.
+    void SetReusePort(bool Enabled);
+
 protected:
     struct PendingPacket
     {
-        std::vector<uint8_t> Data;
+        NetPacketHandle Data;
         sockaddr_in SourceAddress;
         double ProcessTime = 0.0f;
     };
 
     void ProcessPacket(const PendingPacket& Packet);
 
+    // Packs an ip address and port into a single key used to look up child connections.
+    static uint64_t GetEndpointKey(const sockaddr_in& Address);
+
+    void RemoveChildConnection(NetConnectionUDP* Child);
+
+    // Returns false if the packet should be dropped (only when emulating packet loss).
+    bool CreatePendingPacket(NetPacketHandle&& Data, const sockaddr_in& SourceAddress, PendingPacket& Output);
+
+    // Starts recieving/sending on the socket, either on the shared network threads or our own.
+    bool StartIO();
+
     void RecieveThreadEntry();
     void SendThreadEntry();
 
+    // Returns true if a datagram was read from the socket.
+    bool RecieveSingle(int Flags);
+
+    // Sends everything currently in the send queue, returns false on error.
+    bool FlushSendQueue();
+
+    virtual void OnReadable() override;
+    virtual void OnFlush() override;
+
+#if defined(__linux__)
+    // Recieves up to MaxBatches batches of datagrams, stopping early once the socket is drained.
+    void RecieveBatch(int MaxBatches);
+    bool SendBatch(std::vector<PendingPacket>& Packets);
+#endif
+
 private:
 
     std::string Name;
@@ -97,22 +138,48 @@ private:
 
     sockaddr_in Destination = {};
 
-    std::vector<uint8_t> RecieveBuffer;
-    std::vector<std::vector<uint8_t>> RecieveQueue;
+    std::deque<NetPacketHandle> RecieveQueue;
 
     std::vector<std::shared_ptr<NetConnectionUDP>> NewConnections;
-    std::vector<std::weak_ptr<NetConnectionUDP>> ChildConnections;
+    // Children of a listening connection keyed by their endpoint (see GetEndpointKey). Children
+    // remove themselves from this when they are disconnected or destroyed.
+    std::unordered_map<uint64_t, std::weak_ptr<NetConnectionUDP>> ChildConnections;
 
     std::mutex PendingPacketsMutex;
-    std::queue<std::unique_ptr<PendingPacket>> PendingPackets;
+    std::queue<PendingPacket> PendingPackets;
+    std::vector<PendingPacket> PacketsToProcess;
 
-    std::queue<std::unique_ptr<PendingPacket>> SendQueue;
+    std::queue<PendingPacket> SendQueue;
     std::mutex SendQueueMutex;
     std::condition_variable SendQueueCvar;
+    std::vector<PendingPacket> PacketsToSend;
+
+    // Index of the network thread we are registered with, or -1 if using our own threads.
+    int ReactorThreadIndex = -1;
+    std::atomic<bool> bFlushRequested = false;
+
+    // Maximum datagrams read per readable notification when using the shared network threads. With batched 
+    // io this is rounded down to whole batches, but at least one batch is always read.
+    static inline constexpr int k_max_reactor_recieves = 64;
 
     std::unique_ptr<std::thread> RecieveThread;
     std::unique_ptr<std::thread> SendThread;
     bool bShuttingDownThreads = false;
     bool bErrorOnThreads = false;
 
+    bool bBatchedIO = false;
+    int BatchSize = 1;
+
+    bool bReusePort = false;
+
+#if defined(__linux__)
+    std::vector<NetPacketHandle> BatchRecieveBuffers;
+    std::vector<sockaddr_in> BatchRecieveAddresses;
+    std::vector<iovec> BatchRecieveIoVecs;
+    std::vector<mmsghdr> BatchRecieveHeaders;
+
+    std::vector<iovec> BatchSendIoVecs;
+    std::vector<mmsghdr> BatchSendHeaders;
+#endif
+
 };
\ No newline at end of file
@@ -0,0 +1,161 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#include "Shared/Core/Network/NetEventLoop.h"
+#include "Shared/Core/Utils/Logging.h"
+#include "Shared/Core/Utils/DebugObjects.h"
+#include "Shared/Platform/Platform.h"
+
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+NetEventLoop::NetEventLoop()
+{
+#if defined(__linux__)
+    EpollHandle = epoll_create1(EPOLL_CLOEXEC);
+    if (EpollHandle < 0)
+    {
+        Error("Failed to create epoll instance, error %i.", errno);
+    }
+
+    EventHandle = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (EventHandle < 0)
+    {
+        Error("Failed to create eventfd, error %i.", errno);
+    }
+    else
+    {
+        RegisterSocket(EventHandle);
+    }
+#endif
+
+    Timers.Advance(GetSeconds());
+}
+
+NetEventLoop::~NetEventLoop()
+{
+#if defined(__linux__)
+    if (EventHandle >= 0)
+    {
+        close(EventHandle);
+    }
+    if (EpollHandle >= 0)
+    {
+        close(EpollHandle);
+    }
+#endif
+}
+
+NetEventLoop& NetEventLoop::Get()
+{
+    static NetEventLoop Instance;
+    return Instance;
+}
+
+void NetEventLoop::Wake()
+{
+    if (WakePending.exchange(true))
+    {
+        return;
+    }
+
+#if defined(__linux__)
+    uint64_t Value = 1;
+    if (write(EventHandle, &Value, sizeof(Value)) < 0 && errno != EAGAIN)
+    {
+        Warning("Failed to signal event loop, error %i.", errno);
+    }
+#else
+    std::scoped_lock lock(WakeMutex);
+    WakeCvar.notify_one();
+#endif
+}
+
+void NetEventLoop::WakeAt(double Time)
+{
+    std::scoped_lock lock(TimerMutex);
+    Timers.RequestWake(Time);
+}
+
+void NetEventLoop::WakeAfter(double Delay)
+{
+    WakeAt(GetSeconds() + Delay);
+}
+
+void NetEventLoop::RegisterSocket(intptr_t Socket)
+{
+#if defined(__linux__)
+    epoll_event Event = {};
+    Event.events = EPOLLIN;
+    Event.data.fd = (int)Socket;
+
+    if (epoll_ctl(EpollHandle, EPOLL_CTL_ADD, (int)Socket, &Event) < 0 && errno != EEXIST)
+    {
+        Warning("Failed to register socket with event loop, error %i.", errno);
+    }
+#endif
+}
+
+void NetEventLoop::UnregisterSocket(intptr_t Socket)
+{
+#if defined(__linux__)
+    epoll_ctl(EpollHandle, EPOLL_CTL_DEL, (int)Socket, nullptr);
+#endif
+}
+
+void NetEventLoop::Wait(double MaxWaitTime)
+{
+    double Timeout = 0.0;
+    {
+        std::scoped_lock lock(TimerMutex);
+        Timeout = Timers.GetTimeUntilNextExpiry(GetSeconds(), MaxWaitTime);
+    }
+
+#if defined(__linux__)
+    if (!WakePending.load())
+    {
+        // We don't care what became ready, the caller polls everything once we return.
+        epoll_event Events[64];
+        int TimeoutMs = (int)std::ceil(Timeout * 1000.0);
+        epoll_wait(EpollHandle, Events, 64, TimeoutMs);
+    }
+
+    uint64_t Value = 0;
+    while (read(EventHandle, &Value, sizeof(Value)) > 0)
+    {
+        // Drain.
+    }
+#else
+    {
+        std::unique_lock lock(WakeMutex);
+        WakeCvar.wait_for(lock, std::chrono::duration<double>(std::min(Timeout, k_max_socket_poll_interval)), [this]() {
+            return WakePending.load();
+        });
+    }
+#endif
+
+    // Anything that wakes us after this point will signal again, anything before will be picked up
+    // by the poll that the caller does after we return.
+    WakePending = false;
+
+    Debug::EventLoopWakeups.Add(1);
+
+    {
+        std::scoped_lock lock(TimerMutex);
+        Timers.Advance(GetSeconds());
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include "Shared/Core/Utils/TimerWheel.h"
+
+#include <cstdint>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+// The event loop is what the main server thread blocks on between updates. Rather than
+// spinning, the thread sleeps until something actually needs doing:
+//
+//  - A registered socket becomes readable (tcp listeners and connections).
+//  - Something explicitly wakes it (udp recieve threads, webui callbacks, etc).
+//  - A wake request on the timer wheel expires (retransmits, acks, timeouts).
+//
+// On linux this is implemented with epoll and an eventfd. Other platforms fall back to a
+// condition variable, as sockets cannot be waited on they are woken at a fixed short interval.
+
+class NetEventLoop
+{
+public:
+    NetEventLoop();
+    ~NetEventLoop();
+
+    static NetEventLoop& Get();
+
+    // Wakes up the thread blocked in Wait. Safe to call from any thread.
+    void Wake();
+
+    // Makes sure the thread blocked in Wait is woken no later than the given time (in GetSeconds time).
+    void WakeAt(double Time);
+    void WakeAfter(double Delay);
+
+    // Registers a socket that should wake the loop when it has data available to read.
+    void RegisterSocket(intptr_t Socket);
+    void UnregisterSocket(intptr_t Socket);
+
+    // Blocks until the loop is woken, or until MaxWaitTime seconds has elapsed.
+    void Wait(double MaxWaitTime);
+
+private:
+
+    std::mutex TimerMutex;
+    TimerWheel Timers;
+
+    // Set when a wake has been signalled but not yet consumed by Wait, avoids
+    // redundant syscalls when lots of threads are waking us.
+    std::atomic<bool> WakePending = false;
+
+#if defined(__linux__)
+    int EpollHandle = -1;
+    int EventHandle = -1;
+#else
+    std::mutex WakeMutex;
+    std::condition_variable WakeCvar;
+
+    // Sockets can't be waited on without epoll, so never sleep longer than this.
+    inline static const double k_max_socket_poll_interval = 0.001;
+#endif
+
+};
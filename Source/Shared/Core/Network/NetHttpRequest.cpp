@@ -8,6 +8,7 @@
  */
 
 #include "Shared/Core/Network/NetHttpRequest.h"
+#include "Shared/Core/Network/NetEventLoop.h"
 #include "Shared/Core/Utils/Logging.h"
 
 #include <thread>
@@ -16,6 +17,11 @@
 
 using namespace std::chrono_literals;
 
+namespace {
+    // Longest we will go between polling an in-flight request.
+    static inline constexpr long k_max_poll_interval_ms = 10;
+};
+
 NetHttpRequest::~NetHttpRequest()
 {
     Response = nullptr;
@@ -121,6 +127,18 @@ void NetHttpRequest::PollRequest()
     {
         FinishRequest();
     }
+    else
+    {
+        // We don't wait on curl's sockets, so ask to be woken when curl next wants polling.
+        long TimeoutMs = -1;
+        curl_multi_timeout(HandleMulti, &TimeoutMs);
+        if (TimeoutMs < 0 || TimeoutMs > k_max_poll_interval_ms)
+        {
+            TimeoutMs = k_max_poll_interval_ms;
+        }
+
+        NetEventLoop::Get().WakeAfter(TimeoutMs / 1000.0);
+    }
 }
 
 bool NetHttpRequest::FinishRequest()
@@ -0,0 +1,145 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#include "Shared/Core/Network/NetPacketPool.h"
+#include "Shared/Core/Utils/DebugObjects.h"
+
+NetPacketHandle::NetPacketHandle(NetPacketBuffer* InBuffer)
+    : Buffer(InBuffer)
+{
+    if (Buffer)
+    {
+        Buffer->RefCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+NetPacketHandle::NetPacketHandle(const NetPacketHandle& Other)
+    : NetPacketHandle(Other.Buffer)
+{
+}
+
+NetPacketHandle::NetPacketHandle(NetPacketHandle&& Other) noexcept
+    : Buffer(Other.Buffer)
+{
+    Other.Buffer = nullptr;
+}
+
+NetPacketHandle::~NetPacketHandle()
+{
+    Reset();
+}
+
+NetPacketHandle& NetPacketHandle::operator=(const NetPacketHandle& Other)
+{
+    if (this != &Other)
+    {
+        Reset();
+
+        Buffer = Other.Buffer;
+        if (Buffer)
+        {
+            Buffer->RefCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    return *this;
+}
+
+NetPacketHandle& NetPacketHandle::operator=(NetPacketHandle&& Other) noexcept
+{
+    if (this != &Other)
+    {
+        Reset();
+
+        Buffer = Other.Buffer;
+        Other.Buffer = nullptr;
+    }
+    return *this;
+}
+
+void NetPacketHandle::Reset()
+{
+    if (Buffer)
+    {
+        if (Buffer->RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            NetPacketPool::Get().Release(Buffer);
+        }
+        Buffer = nullptr;
+    }
+}
+
+NetPacketPool& NetPacketPool::Get()
+{
+    static NetPacketPool Instance;
+    return Instance;
+}
+
+NetPacketHandle NetPacketPool::Acquire(size_t MinCapacity)
+{
+    if (MinCapacity > k_slab_size)
+    {
+        NetPacketBuffer* Buffer = new NetPacketBuffer();
+        Buffer->Storage.resize(MinCapacity);
+        Buffer->Pooled = false;
+
+        Debug::PacketPoolAllocations.Add(1);
+
+        return NetPacketHandle(Buffer);
+    }
+
+    std::scoped_lock lock(Mutex);
+
+    NetPacketBuffer* Buffer = nullptr;
+    if (FreeBuffers.empty())
+    {
+        std::unique_ptr<NetPacketBuffer> NewBuffer = std::make_unique<NetPacketBuffer>();
+        NewBuffer->Storage.resize(k_slab_size);
+
+        Buffer = NewBuffer.get();
+        Buffers.push_back(std::move(NewBuffer));
+
+        // Make sure the free list can hold every buffer so releasing never has to allocate.
+        FreeBuffers.reserve(Buffers.capacity());
+
+        Debug::PacketPoolAllocations.Add(1);
+    }
+    else
+    {
+        Buffer = FreeBuffers.back();
+        FreeBuffers.pop_back();
+    }
+
+    Buffer->Length = 0;
+
+    return NetPacketHandle(Buffer);
+}
+
+void NetPacketPool::Release(NetPacketBuffer* Buffer)
+{
+    if (!Buffer->Pooled)
+    {
+        delete Buffer;
+        return;
+    }
+
+    std::scoped_lock lock(Mutex);
+    FreeBuffers.push_back(Buffer);
+}
+
+size_t NetPacketPool::GetTotalCount()
+{
+    std::scoped_lock lock(Mutex);
+    return Buffers.size();
+}
+
+size_t NetPacketPool::GetFreeCount()
+{
+    std::scoped_lock lock(Mutex);
+    return FreeBuffers.size();
+}
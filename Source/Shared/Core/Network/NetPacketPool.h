@@ -0,0 +1,107 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+// Datagrams are recieved directly into fixed size slabs taken from a shared pool,
+// the slab is then passed by reference up through the connection and stream layers
+// rather than being copied at each step. Once the last handle to a slab is released
+// it goes back into the pool, so once the pool has warmed up the recieve path
+// doesn't touch the allocator.
+
+class NetPacketPool;
+
+class NetPacketBuffer
+{
+public:
+    uint8_t* Data()                 { return Storage.data(); }
+    const uint8_t* Data() const     { return Storage.data(); }
+
+    // Number of valid bytes in the buffer.
+    size_t Size() const             { return Length; }
+    void SetSize(size_t InLength)   { Length = InLength; }
+
+    // Maximum number of bytes the buffer can hold.
+    size_t Capacity() const         { return Storage.size(); }
+
+private:
+    friend class NetPacketPool;
+    friend class NetPacketHandle;
+
+    std::vector<uint8_t> Storage;
+    size_t Length = 0;
+
+    std::atomic<uint32_t> RefCount = 0;
+
+    // Oversized buffers are allocated on demand and freed rather than returned to the pool.
+    bool Pooled = true;
+};
+
+// Reference counted handle to a buffer owned by the packet pool.
+class NetPacketHandle
+{
+public:
+    NetPacketHandle() = default;
+    NetPacketHandle(const NetPacketHandle& Other);
+    NetPacketHandle(NetPacketHandle&& Other) noexcept;
+    ~NetPacketHandle();
+
+    NetPacketHandle& operator=(const NetPacketHandle& Other);
+    NetPacketHandle& operator=(NetPacketHandle&& Other) noexcept;
+
+    NetPacketBuffer* Get() const            { return Buffer; }
+    NetPacketBuffer* operator->() const     { return Buffer; }
+    NetPacketBuffer& operator*() const      { return *Buffer; }
+    explicit operator bool() const          { return Buffer != nullptr; }
+
+    void Reset();
+
+private:
+    friend class NetPacketPool;
+
+    explicit NetPacketHandle(NetPacketBuffer* InBuffer);
+
+    NetPacketBuffer* Buffer = nullptr;
+};
+
+class NetPacketPool
+{
+public:
+
+    // Size of each pooled slab. This is sized to comfortably hold a full MTU worth
+    // of data, the game fragments everything well below this.
+    static inline constexpr size_t k_slab_size = 2048;
+
+    static NetPacketPool& Get();
+
+    // Gets a buffer capable of holding at least the given number of bytes. Requests larger
+    // than a slab are serviced by a one-off allocation that is not returned to the pool.
+    NetPacketHandle Acquire(size_t MinCapacity = k_slab_size);
+
+    size_t GetTotalCount();
+    size_t GetFreeCount();
+
+private:
+    friend class NetPacketHandle;
+
+    void Release(NetPacketBuffer* Buffer);
+
+    std::mutex Mutex;
+
+    std::vector<std::unique_ptr<NetPacketBuffer>> Buffers;
+    std::vector<NetPacketBuffer*> FreeBuffers;
+
+};
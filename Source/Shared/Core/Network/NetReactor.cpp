@@ -0,0 +1,282 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#include "Shared/Core/Network/NetReactor.h"
+#include "Shared/Core/Utils/Logging.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+NetReactor::~NetReactor()
+{
+    Stop();
+}
+
+NetReactor& NetReactor::Get()
+{
+    static NetReactor Instance;
+    return Instance;
+}
+
+bool NetReactor::Start(int ThreadCount)
+{
+#if defined(__linux__)
+    std::scoped_lock lock(Mutex);
+
+    if (Running)
+    {
+        return true;
+    }
+
+    if (ThreadCount <= 0)
+    {
+        ThreadCount = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+
+    ShuttingDown = false;
+
+    for (int i = 0; i < ThreadCount; i++)
+    {
+        std::unique_ptr<IoThread> State = std::make_unique<IoThread>();
+
+        State->EpollHandle = epoll_create1(EPOLL_CLOEXEC);
+        if (State->EpollHandle < 0)
+        {
+            Error("Failed to create epoll instance for network thread, error %i.", errno);
+            return false;
+        }
+
+        State->EventHandle = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (State->EventHandle < 0)
+        {
+            Error("Failed to create eventfd for network thread, error %i.", errno);
+            close(State->EpollHandle);
+            return false;
+        }
+
+        // The eventfd is registered with a null handler, that's how the thread tells it apart from sockets.
+        epoll_event Event = {};
+        Event.events = EPOLLIN;
+        Event.data.ptr = nullptr;
+        epoll_ctl(State->EpollHandle, EPOLL_CTL_ADD, State->EventHandle, &Event);
+
+        IoThread* StatePtr = State.get();
+        State->Thread = std::make_unique<std::thread>([this, StatePtr]() {
+            ThreadEntry(*StatePtr);
+        });
+
+        Threads.push_back(std::move(State));
+    }
+
+    Running = true;
+
+    Log("Started %i network threads.", ThreadCount);
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+void NetReactor::Stop()
+{
+#if defined(__linux__)
+    std::scoped_lock lock(Mutex);
+
+    if (!Running)
+    {
+        return;
+    }
+
+    ShuttingDown = true;
+
+    for (auto& State : Threads)
+    {
+        uint64_t Value = 1;
+        write(State->EventHandle, &Value, sizeof(Value));
+    }
+
+    for (auto& State : Threads)
+    {
+        State->Thread->join();
+
+        close(State->EventHandle);
+        close(State->EpollHandle);
+    }
+
+    Threads.clear();
+    Running = false;
+#endif
+}
+
+int NetReactor::Register(intptr_t Socket, NetReactorHandler* Handler)
+{
+#if defined(__linux__)
+    std::scoped_lock lock(Mutex);
+
+    if (!Running)
+    {
+        return -1;
+    }
+
+    // Put the socket on whichever thread is servicing the fewest sockets.
+    int ThreadIndex = 0;
+    size_t LowestCount = std::numeric_limits<size_t>::max();
+    for (size_t i = 0; i < Threads.size(); i++)
+    {
+        std::scoped_lock dispatch_lock(Threads[i]->DispatchMutex);
+        if (Threads[i]->Handlers.size() < LowestCount)
+        {
+            LowestCount = Threads[i]->Handlers.size();
+            ThreadIndex = (int)i;
+        }
+    }
+
+    IoThread& State = *Threads[ThreadIndex];
+    {
+        std::scoped_lock dispatch_lock(State.DispatchMutex);
+        State.Handlers.insert(Handler);
+    }
+
+    epoll_event Event = {};
+    Event.events = EPOLLIN;
+    Event.data.ptr = Handler;
+    if (epoll_ctl(State.EpollHandle, EPOLL_CTL_ADD, (int)Socket, &Event) < 0)
+    {
+        Error("Failed to register socket with network thread, error %i.", errno);
+
+        std::scoped_lock dispatch_lock(State.DispatchMutex);
+        State.Handlers.erase(Handler);
+        return -1;
+    }
+
+    return ThreadIndex;
+#else
+    return -1;
+#endif
+}
+
+void NetReactor::Unregister(int ThreadIndex, intptr_t Socket, NetReactorHandler* Handler)
+{
+#if defined(__linux__)
+    std::scoped_lock lock(Mutex);
+
+    if (ThreadIndex < 0 || ThreadIndex >= (int)Threads.size())
+    {
+        return;
+    }
+
+    IoThread& State = *Threads[ThreadIndex];
+
+    epoll_ctl(State.EpollHandle, EPOLL_CTL_DEL, (int)Socket, nullptr);
+
+    // Waits for the thread to finish with the handler if its currently dispatching to it.
+    {
+        std::scoped_lock dispatch_lock(State.DispatchMutex);
+        State.Handlers.erase(Handler);
+    }
+    {
+        std::scoped_lock flush_lock(State.FlushMutex);
+        State.FlushRequests.erase(std::remove(State.FlushRequests.begin(), State.FlushRequests.end(), Handler), State.FlushRequests.end());
+    }
+#endif
+}
+
+void NetReactor::RequestFlush(int ThreadIndex, NetReactorHandler* Handler)
+{
+#if defined(__linux__)
+    // Threads are only created/destroyed when the reactor is started/stopped, which
+    // happens outside the lifetime of any registered sockets, so no lock here.
+    IoThread& State = *Threads[ThreadIndex];
+
+    {
+        std::scoped_lock flush_lock(State.FlushMutex);
+        State.FlushRequests.push_back(Handler);
+    }
+
+    uint64_t Value = 1;
+    if (write(State.EventHandle, &Value, sizeof(Value)) < 0 && errno != EAGAIN)
+    {
+        Warning("Failed to signal network thread, error %i.", errno);
+    }
+#endif
+}
+
+void NetReactor::ThreadEntry(IoThread& State)
+{
+#if defined(__linux__)
+    epoll_event Events[64];
+
+    while (!ShuttingDown)
+    {
+        int Count = epoll_wait(State.EpollHandle, Events, 64, -1);
+        if (Count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            Error("Network thread failed to wait on sockets, error %i.", errno);
+            return;
+        }
+
+        bool FlushRequested = false;
+
+        std::scoped_lock lock(State.DispatchMutex);
+
+        for (int i = 0; i < Count; i++)
+        {
+            NetReactorHandler* Handler = static_cast<NetReactorHandler*>(Events[i].data.ptr);
+            if (Handler == nullptr)
+            {
+                uint64_t Value = 0;
+                while (read(State.EventHandle, &Value, sizeof(Value)) > 0)
+                {
+                    // Drain.
+                }
+
+                FlushRequested = true;
+                continue;
+            }
+
+            // May have been unregistered between the wait and us taking the lock.
+            if (State.Handlers.find(Handler) != State.Handlers.end())
+            {
+                Handler->OnReadable();
+            }
+        }
+
+        if (FlushRequested)
+        {
+            {
+                std::scoped_lock flush_lock(State.FlushMutex);
+                State.FlushRequestsProcessing.swap(State.FlushRequests);
+            }
+
+            for (NetReactorHandler* Handler : State.FlushRequestsProcessing)
+            {
+                if (State.Handlers.find(Handler) != State.Handlers.end())
+                {
+                    Handler->OnFlush();
+                }
+            }
+
+            State.FlushRequestsProcessing.clear();
+        }
+    }
+#endif
+}
@@ -0,0 +1,97 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <unordered_set>
+
+// The reactor is a process-wide pool of network IO threads that sockets are registered with,
+// rather than each connection spinning up its own recieve and send threads. When the server is
+// running lots of shards this keeps the number of threads (and context switches) fixed regardless
+// of how many sockets are open.
+//
+// Each socket is owned by a single IO thread for its lifetime, the thread waits on all of its
+// sockets with epoll and calls back into the handler when they are readable, or when the owner
+// has requested a flush of its send queue.
+//
+// Only supported on linux, on other platforms IsRunning always returns false and connections
+// fall back to using their own threads.
+
+class NetReactorHandler
+{
+public:
+    virtual ~NetReactorHandler() = default;
+
+    // Called on the owning IO thread when the socket has data available to read.
+    virtual void OnReadable() = 0;
+
+    // Called on the owning IO thread after RequestFlush has been called.
+    virtual void OnFlush() = 0;
+};
+
+class NetReactor
+{
+public:
+    ~NetReactor();
+
+    static NetReactor& Get();
+
+    // Starts the IO threads. 0 creates one thread per hardware thread.
+    bool Start(int ThreadCount);
+
+    // Stops all IO threads, anything still registered will no longer be serviced.
+    void Stop();
+
+    bool IsRunning() { return Running; }
+
+    size_t GetThreadCount() { return Threads.size(); }
+
+    // Registers a socket with the least loaded IO thread, returns the index of that thread which
+    // must be passed to the other functions, or -1 on failure.
+    int Register(intptr_t Socket, NetReactorHandler* Handler);
+
+    // Unregisters a socket. Once this returns the handler will not be called again and is safe to destroy.
+    void Unregister(int ThreadIndex, intptr_t Socket, NetReactorHandler* Handler);
+
+    // Asks the IO thread to call OnFlush on the handler. Safe to call from any thread.
+    void RequestFlush(int ThreadIndex, NetReactorHandler* Handler);
+
+private:
+    struct IoThread
+    {
+        std::unique_ptr<std::thread> Thread;
+
+        int EpollHandle = -1;
+        int EventHandle = -1;
+
+        // Held while handlers are being called, Unregister takes this to guarantee
+        // the handler isn't in use once it returns.
+        std::mutex DispatchMutex;
+        std::unordered_set<NetReactorHandler*> Handlers;
+
+        std::mutex FlushMutex;
+        std::vector<NetReactorHandler*> FlushRequests;
+        std::vector<NetReactorHandler*> FlushRequestsProcessing;
+    };
+
+    void ThreadEntry(IoThread& State);
+
+    std::mutex Mutex;
+    std::vector<std::unique_ptr<IoThread>> Threads;
+
+    std::atomic<bool> Running = false;
+    std::atomic<bool> ShuttingDown = false;
+
+};
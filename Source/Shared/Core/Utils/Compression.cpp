@@ -11,54 +11,247 @@
 
 #include "zlib.h"
 
-bool Compress(const std::vector<uint8_t>& Input, std::vector<uint8_t>& Output)
+namespace 
 {
-    uLongf DestinationLength = (uLongf)Output.size();
-
-    Output.resize(compressBound((uLong)Input.size()));
-
-    z_stream defstream;
-    defstream.zalloc = Z_NULL;
-    defstream.zfree = Z_NULL;
-    defstream.opaque = Z_NULL;
-    defstream.avail_in = (uInt)Input.size();
-    defstream.next_in = (Bytef*)Input.data();
-    defstream.avail_out = (uInt)Output.size();
-    defstream.next_out = (Bytef*)Output.data();
-
-    // Match these settings EXACTLY or ds3 has a fit. I think its doing a hard-check on the header
-    // generated which changes based on the settings.
-    if (deflateInit2(&defstream, 7, Z_DEFLATED, 13, 9, Z_DEFAULT_STRATEGY) != Z_OK)
+    // Initializing a zlib stream allocates and clears a few hundred KB of state, which is far more 
+    // work than compressing a typical message. So we keep a stream per thread and reset it between 
+    // uses, a reset keeps the settings the stream was initialized with.
+
+    struct DeflateContext
     {
-        return false;
+        z_stream Stream = {};
+        bool Valid = false;
+
+        DeflateContext()
+        {
+            // Match these settings EXACTLY or ds3 has a fit. I think its doing a hard-check on the header
+            // generated which changes based on the settings.
+            Valid = (deflateInit2(&Stream, 7, Z_DEFLATED, 13, 9, Z_DEFAULT_STRATEGY) == Z_OK);
+        }
+
+        ~DeflateContext()
+        {
+            if (Valid)
+            {
+                deflateEnd(&Stream);
+            }
+        }
+    };
+
+    // Same as DeflateContext but produces raw deflate data with no zlib header or trailer, used for
+    // compressing chunks that get spliced into other streams.
+    struct RawDeflateContext
+    {
+        z_stream Stream = {};
+        bool Valid = false;
+
+        RawDeflateContext()
+        {
+            Valid = (deflateInit2(&Stream, 7, Z_DEFLATED, -13, 9, Z_DEFAULT_STRATEGY) == Z_OK);
+        }
+
+        ~RawDeflateContext()
+        {
+            if (Valid)
+            {
+                deflateEnd(&Stream);
+            }
+        }
+    };
+
+    struct InflateContext
+    {
+        z_stream Stream = {};
+        bool Valid = false;
+
+        InflateContext()
+        {
+            Valid = (inflateInit(&Stream) == Z_OK);
+        }
+
+        ~InflateContext()
+        {
+            if (Valid)
+            {
+                inflateEnd(&Stream);
+            }
+        }
+    };
+
+    thread_local DeflateContext ThreadDeflateContext;
+    thread_local RawDeflateContext ThreadRawDeflateContext;
+    thread_local InflateContext ThreadInflateContext;
+
+    // An empty fixed huffman block with the final block bit set, terminates a spliced stream.
+    const uint8_t k_final_empty_block[] = { 0x03, 0x00 };
+
+    // Deflates everything in the stream's input with a sync flush, growing the output as needed. A sync
+    // flush leaves the output on a byte boundary without ending the stream, so more blocks can follow it.
+    bool DeflateSyncFlush(z_stream& Stream, std::vector<uint8_t>& Output)
+    {
+        // Sync flushes add an empty stored block, so leave a little more room than deflateBound suggests.
+        Output.resize(deflateBound(&Stream, Stream.avail_in) + 16);
+
+        Stream.next_out = (Bytef*)Output.data();
+        Stream.avail_out = (uInt)Output.size();
+
+        while (true)
+        {
+            int Result = deflate(&Stream, Z_SYNC_FLUSH);
+            if (Result != Z_OK && Result != Z_BUF_ERROR)
+            {
+                return false;
+            }
+
+            // Flush is only complete if it didn't fill the output buffer.
+            if (Stream.avail_out > 0 && Stream.avail_in == 0)
+            {
+                break;
+            }
+
+            size_t Written = Output.size() - Stream.avail_out;
+            Output.resize(Output.size() * 2);
+            Stream.next_out = (Bytef*)Output.data() + Written;
+            Stream.avail_out = (uInt)(Output.size() - Written);
+        }
+
+        Output.resize(Output.size() - Stream.avail_out);
+
+        return true;
     }
-    if (deflate(&defstream, Z_FINISH) != Z_STREAM_END)
+}
+
+bool Compress(const std::vector<uint8_t>& Input, std::vector<uint8_t>& Output)
+{
+    return Compress(Input.data(), Input.size(), Output);
+}
+
+bool Compress(const uint8_t* Input, size_t InputLength, std::vector<uint8_t>& Output)
+{
+    DeflateContext& Context = ThreadDeflateContext;
+    if (!Context.Valid || deflateReset(&Context.Stream) != Z_OK)
     {
         return false;
     }
-    if (deflateEnd(&defstream) != Z_OK)
+
+    Output.resize(deflateBound(&Context.Stream, (uLong)InputLength));
+
+    z_stream& Stream = Context.Stream;
+    Stream.avail_in = (uInt)InputLength;
+    Stream.next_in = (Bytef*)Input;
+    Stream.avail_out = (uInt)Output.size();
+    Stream.next_out = (Bytef*)Output.data();
+
+    if (deflate(&Stream, Z_FINISH) != Z_STREAM_END)
     {
         return false;
     }
 
-    Output.resize(defstream.total_out);
+    Output.resize(Stream.total_out);
 
     return true;
 }
 
 bool Decompress(const std::vector<uint8_t>& Input, std::vector<uint8_t>& Output, uint32_t DecompressedSize)
 {
+    return Decompress(Input.data(), Input.size(), Output, DecompressedSize);
+}
+
+bool Decompress(const uint8_t* Input, size_t InputLength, std::vector<uint8_t>& Output, uint32_t DecompressedSize)
+{
+    InflateContext& Context = ThreadInflateContext;
+    if (!Context.Valid || inflateReset(&Context.Stream) != Z_OK)
+    {
+        return false;
+    }
+
     Output.resize(DecompressedSize);
 
-    uLongf DestinationLength = (uLongf)Output.size();
-    uLongf SourceLength = (uLongf)Input.size();
+    // zlib treats a null output buffer as an error even if there is nothing to write.
+    Bytef Empty = 0;
+
+    z_stream& Stream = Context.Stream;
+    Stream.avail_in = (uInt)InputLength;
+    Stream.next_in = (Bytef*)Input;
+    Stream.avail_out = Output.empty() ? 0 : (uInt)Output.size();
+    Stream.next_out = Output.empty() ? &Empty : (Bytef*)Output.data();
+
+    if (inflate(&Stream, Z_FINISH) != Z_STREAM_END)
+    {
+        return false;
+    }
+
+    Output.resize(Stream.total_out);
+
+    return true;
+}
+
+
+bool CompressChunk(const uint8_t* Input, size_t InputLength, CompressedChunk& Output)
+{
+    Output.Data.clear();
+    Output.Checksum = (uint32_t)adler32(adler32(0, Z_NULL, 0), (const Bytef*)Input, (uInt)InputLength);
+    Output.UncompressedLength = InputLength;
+
+    if (InputLength == 0)
+    {
+        return true;
+    }
+
+    RawDeflateContext& Context = ThreadRawDeflateContext;
+    if (!Context.Valid || deflateReset(&Context.Stream) != Z_OK)
+    {
+        return false;
+    }
+
+    z_stream& Stream = Context.Stream;
+    Stream.avail_in = (uInt)InputLength;
+    Stream.next_in = (Bytef*)Input;
+
+    return DeflateSyncFlush(Stream, Output.Data);
+}
 
-    if (uncompress2(Output.data(), &DestinationLength, Input.data(), &SourceLength) != Z_OK)
+bool CompressSpliced(const uint8_t* Prefix, size_t PrefixLength, const std::vector<const CompressedChunk*>& Chunks, std::vector<uint8_t>& Output)
+{
+    DeflateContext& Context = ThreadDeflateContext;
+    if (!Context.Valid || deflateReset(&Context.Stream) != Z_OK)
     {
         return false;
     }
 
-    Output.resize(DestinationLength);
+    // The prefix is compressed as normal, which also writes the zlib header, but rather than finishing the
+    // stream we flush it so the chunks' blocks can be appended directly after it.
+    z_stream& Stream = Context.Stream;
+    Stream.avail_in = (uInt)PrefixLength;
+    Stream.next_in = (Bytef*)Prefix;
+
+    if (!DeflateSyncFlush(Stream, Output))
+    {
+        return false;
+    }
+
+    uLong Checksum = adler32(adler32(0, Z_NULL, 0), (const Bytef*)Prefix, (uInt)PrefixLength);
+
+    size_t ChunksLength = 0;
+    for (const CompressedChunk* Chunk : Chunks)
+    {
+        ChunksLength += Chunk->Data.size();
+    }
+    Output.reserve(Output.size() + ChunksLength + sizeof(k_final_empty_block) + 4);
+
+    for (const CompressedChunk* Chunk : Chunks)
+    {
+        Output.insert(Output.end(), Chunk->Data.begin(), Chunk->Data.end());
+        Checksum = adler32_combine(Checksum, Chunk->Checksum, (z_off_t)Chunk->UncompressedLength);
+    }
+
+    Output.insert(Output.end(), k_final_empty_block, k_final_empty_block + sizeof(k_final_empty_block));
+
+    // zlib trailer is the checksum of all the uncompressed data, big endian.
+    Output.push_back((uint8_t)(Checksum >> 24));
+    Output.push_back((uint8_t)(Checksum >> 16));
+    Output.push_back((uint8_t)(Checksum >> 8));
+    Output.push_back((uint8_t)(Checksum));
 
     return true;
 }
\ No newline at end of file
@@ -14,5 +14,32 @@
 #include <vector>
 #include <cstdint>
 
+// Compresses/decompresses zlib streams with the settings the game expects. Each thread keeps its own
+// zlib contexts which are reset between calls rather than being created from scratch each time, so 
+// these are safe to call from multiple threads at once.
+
 bool Compress(const std::vector<uint8_t>& Input, std::vector<uint8_t>& Output);
-bool Decompress(const std::vector<uint8_t>& Input, std::vector<uint8_t>& Output, uint32_t DecompressedSize);
\ No newline at end of file
+bool Compress(const uint8_t* Input, size_t InputLength, std::vector<uint8_t>& Output);
+
+bool Decompress(const std::vector<uint8_t>& Input, std::vector<uint8_t>& Output, uint32_t DecompressedSize);
+bool Decompress(const uint8_t* Input, size_t InputLength, std::vector<uint8_t>& Output, uint32_t DecompressedSize);
+
+// A block of data compressed on its own so it can later be spliced into larger compressed streams
+// by CompressSpliced, without having to be compressed again. Useful when the same data ends up in
+// lots of messages that otherwise differ, eg. the same list response sent to many clients.
+struct CompressedChunk
+{
+    // Raw deflate blocks, flushed to a byte boundary and without a final block.
+    std::vector<uint8_t> Data;
+
+    // Adler-32 checksum and length of the uncompressed data.
+    uint32_t Checksum = 1;
+    size_t UncompressedLength = 0;
+};
+
+bool CompressChunk(const uint8_t* Input, size_t InputLength, CompressedChunk& Output);
+
+// Produces a zlib stream (with the same settings as Compress) of Prefix followed by the contents of each
+// chunk. Only the prefix is actually compressed, the output is a little larger than compressing it all 
+// in one go as back references can't cross chunk boundaries.
+bool CompressSpliced(const uint8_t* Prefix, size_t PrefixLength, const std::vector<const CompressedChunk*>& Chunks, std::vector<uint8_t>& Output);
\ No newline at end of file
@@ -0,0 +1,72 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#include "Shared/Core/Utils/DebugGauge.h"
+
+#include <algorithm>
+
+DebugGauge::DebugGauge(const std::string& InName, double InRollingWindow)
+    : Name(InName)
+    , RollingWindow(InRollingWindow)
+{
+    Registry.push_back(this);
+}
+
+DebugGauge::~DebugGauge()
+{
+    if (auto Iter = std::find(Registry.begin(), Registry.end(), this); Iter != Registry.end())
+    {
+        Registry.erase(Iter);
+    }
+}
+
+std::vector<DebugGauge*> DebugGauge::GetGauges()
+{
+    return Registry;
+}
+
+std::string DebugGauge::GetName()
+{
+    return Name;
+}
+
+double DebugGauge::GetCurrent()
+{
+    return Current;
+}
+
+double DebugGauge::GetPeak()
+{
+    return Peak;
+}
+
+void DebugGauge::Set(double Value)
+{
+    Current = Value;
+    PeakTracker = std::max(PeakTracker, Value);
+}
+
+void DebugGauge::Poll()
+{
+    double CurrentTime = GetHighResolutionSeconds();
+    if (CurrentTime - PeakTimer > RollingWindow)
+    {
+        Peak = PeakTracker;
+        PeakTracker = Current;
+        PeakTimer = CurrentTime;
+    }
+}
+
+void DebugGauge::PollAll()
+{
+    for (DebugGauge* instance : Registry)
+    {
+        instance->Poll();
+    }
+}
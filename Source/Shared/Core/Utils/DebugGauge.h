@@ -0,0 +1,49 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <list>
+
+#include "Shared/Platform/Platform.h"
+
+// Tracks the current value of something that goes up and down (queue depths, etc) rather 
+// than something that accumulates, along with the peak value seen over a rolling window.
+
+class DebugGauge
+{
+public:
+    DebugGauge(const std::string& name, double RollingWindow = 5.0);
+    ~DebugGauge();
+
+    std::string GetName();
+    double GetCurrent();
+    double GetPeak();
+
+    void Set(double Value);
+
+    void Poll();
+
+    static std::vector<DebugGauge*> GetGauges();
+    static void PollAll();
+
+private:
+    inline static std::vector<DebugGauge*> Registry;
+
+    std::string Name;
+    double RollingWindow;
+
+    double Current = 0.0;
+    double Peak = 0.0;
+    double PeakTracker = 0.0;
+    double PeakTimer = 0.0;
+
+};
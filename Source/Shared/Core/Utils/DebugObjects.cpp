@@ -13,9 +13,11 @@ namespace Debug
 {
 #define TIMER(Name, Description) DebugTimer Name(Description);
 #define COUNTER(Name, Description) DebugCounter Name(Description);
+#define GAUGE(Name, Description) DebugGauge Name(Description);
 
 #include "Shared/Core/Utils/DebugObjects.inc"
 
 #undef TIMER
 #undef COUNTER
+#undef GAUGE
 };
@@ -10,15 +10,18 @@
 #pragma once
 
 #include "Shared/Core/Utils/DebugCounter.h"
+#include "Shared/Core/Utils/DebugGauge.h"
 #include "Shared/Core/Utils/DebugTimer.h"
 
 namespace Debug
 {
 #define TIMER(Name, Description) extern DebugTimer Name;
 #define COUNTER(Name, Description) extern DebugCounter Name;
+#define GAUGE(Name, Description) extern DebugGauge Name;
 
 #include "Shared/Core/Utils/DebugObjects.inc"
 
 #undef TIMER
 #undef COUNTER
+#undef GAUGE
 }; 
@@ -28,14 +28,12 @@ public:
 
     void Poll();
 
+    // Adds a sample timed somewhere other than a DebugTimerScope, eg. on another thread.
+    void AddSample(double Interval);
+
     static std::vector<DebugTimer*> GetTimers();
     static void PollAll();
 
-protected:
-    friend struct DebugTimerScope;
-
-    void AddSample(double Interval);
-
 private:    
     inline static std::vector<DebugTimer*> Registry;
 
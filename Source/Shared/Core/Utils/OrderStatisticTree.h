@@ -0,0 +1,244 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include <memory>
+#include <random>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+// Ordered map of unique keys that can also find the position of a key, and the entry at a position,
+// in O(log N). Useful for anything rank-like where a sorted vector would need shifting on every
+// change and a std::map would need walking to find positions.
+//
+// Implemented as a treap, a binary search tree where each node also has a random priority that
+// is kept heap ordered, which keeps the tree balanced with high probability. Each node tracks the
+// size of its subtree so positions can be found on the way down.
+
+template <typename KeyType, typename ValueType, typename CompareType = std::less<KeyType>>
+class OrderStatisticTree
+{
+public:
+
+    // Inserts an entry, returns false if the key already exists.
+    bool Insert(const KeyType& Key, ValueType Value)
+    {
+        if (Find(Key) != nullptr)
+        {
+            return false;
+        }
+
+        std::unique_ptr<Node> Before;
+        std::unique_ptr<Node> After;
+        Split(std::move(Root), Key, Before, After);
+
+        std::unique_ptr<Node> NewNode = std::make_unique<Node>(Key, std::move(Value), PriorityGenerator());
+        Root = Merge(Merge(std::move(Before), std::move(NewNode)), std::move(After));
+
+        return true;
+    }
+
+    // Removes the entry with the given key, returns false if it doesn't exist.
+    bool Erase(const KeyType& Key)
+    {
+        return Erase(Root, Key);
+    }
+
+    // Returns the value for the given key, or nullptr if it doesn't exist.
+    ValueType* Find(const KeyType& Key)
+    {
+        Node* Current = Root.get();
+        while (Current != nullptr)
+        {
+            if (Compare(Key, Current->Key))
+            {
+                Current = Current->Left.get();
+            }
+            else if (Compare(Current->Key, Key))
+            {
+                Current = Current->Right.get();
+            }
+            else
+            {
+                return &Current->Value;
+            }
+        }
+        return nullptr;
+    }
+
+    // Number of entries ordered before the given key, which doesn't have to exist. For
+    // a key that does exist this is its 0-based position.
+    size_t CountBefore(const KeyType& Key) const
+    {
+        size_t Count = 0;
+
+        Node* Current = Root.get();
+        while (Current != nullptr)
+        {
+            if (Compare(Current->Key, Key))
+            {
+                Count += GetSize(Current->Left) + 1;
+                Current = Current->Right.get();
+            }
+            else
+            {
+                Current = Current->Left.get();
+            }
+        }
+
+        return Count;
+    }
+
+    // Returns the value at the given 0-based position, or nullptr if its out of range.
+    ValueType* At(size_t Index)
+    {
+        Node* Current = Root.get();
+        while (Current != nullptr)
+        {
+            size_t LeftSize = GetSize(Current->Left);
+            if (Index < LeftSize)
+            {
+                Current = Current->Left.get();
+            }
+            else if (Index == LeftSize)
+            {
+                return &Current->Value;
+            }
+            else
+            {
+                Index -= LeftSize + 1;
+                Current = Current->Right.get();
+            }
+        }
+        return nullptr;
+    }
+
+    size_t Size() const
+    {
+        return GetSize(Root);
+    }
+
+private:
+
+    struct Node
+    {
+        Node(const KeyType& InKey, ValueType&& InValue, uint32_t InPriority)
+            : Key(InKey)
+            , Value(std::move(InValue))
+            , Priority(InPriority)
+        {
+        }
+
+        KeyType Key;
+        ValueType Value;
+        uint32_t Priority;
+        size_t Size = 1;
+
+        std::unique_ptr<Node> Left;
+        std::unique_ptr<Node> Right;
+    };
+
+    static size_t GetSize(const std::unique_ptr<Node>& Current)
+    {
+        return Current ? Current->Size : 0;
+    }
+
+    static void UpdateSize(Node* Current)
+    {
+        Current->Size = GetSize(Current->Left) + GetSize(Current->Right) + 1;
+    }
+
+    // Splits a subtree into the nodes ordered before the key and those that are not.
+    void Split(std::unique_ptr<Node> Current, const KeyType& Key, std::unique_ptr<Node>& Before, std::unique_ptr<Node>& After)
+    {
+        if (!Current)
+        {
+            Before = nullptr;
+            After = nullptr;
+            return;
+        }
+
+        if (Compare(Current->Key, Key))
+        {
+            Split(std::move(Current->Right), Key, Current->Right, After);
+            UpdateSize(Current.get());
+            Before = std::move(Current);
+        }
+        else
+        {
+            Split(std::move(Current->Left), Key, Before, Current->Left);
+            UpdateSize(Current.get());
+            After = std::move(Current);
+        }
+    }
+
+    // Joins two subtrees, everything in Before has to be ordered before everything in After.
+    std::unique_ptr<Node> Merge(std::unique_ptr<Node> Before, std::unique_ptr<Node> After)
+    {
+        if (!Before)
+        {
+            return After;
+        }
+        if (!After)
+        {
+            return Before;
+        }
+
+        if (Before->Priority > After->Priority)
+        {
+            Before->Right = Merge(std::move(Before->Right), std::move(After));
+            UpdateSize(Before.get());
+            return Before;
+        }
+        else
+        {
+            After->Left = Merge(std::move(Before), std::move(After->Left));
+            UpdateSize(After.get());
+            return After;
+        }
+    }
+
+    bool Erase(std::unique_ptr<Node>& Current, const KeyType& Key)
+    {
+        if (!Current)
+        {
+            return false;
+        }
+
+        bool Erased = false;
+        if (Compare(Key, Current->Key))
+        {
+            Erased = Erase(Current->Left, Key);
+        }
+        else if (Compare(Current->Key, Key))
+        {
+            Erased = Erase(Current->Right, Key);
+        }
+        else
+        {
+            Current = Merge(std::move(Current->Left), std::move(Current->Right));
+            return true;
+        }
+
+        if (Erased)
+        {
+            UpdateSize(Current.get());
+        }
+        return Erased;
+    }
+
+private:
+
+    std::unique_ptr<Node> Root;
+    CompareType Compare;
+    std::minstd_rand PriorityGenerator;
+
+};
@@ -0,0 +1,121 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <memory>
+
+// Fixed capacity queue of entries keyed by a sequence number that wraps at Capacity. Each
+// sequence number maps directly to a slot, so inserting, looking up and popping entries are
+// all constant time and never move the entries themselves around.
+//
+// Entries are held as unique pointers, so whatever owns the queue can recycle them rather
+// than reallocating. Sequence numbers do not need to be contiguous, but all entries must
+// fit within a single Capacity sized window starting at the oldest entry.
+//
+// Slots are allocated the first time an entry is inserted, so empty queues cost next to nothing.
+
+template <typename T, uint32_t Capacity>
+class SequenceRingBuffer
+{
+public:
+
+    size_t Size() const     { return Count; }
+    bool Empty() const      { return Count == 0; }
+
+    // Sequence number of the oldest and newest entries, only valid if not empty.
+    uint32_t FrontSequence() const  { return Head; }
+    uint32_t BackSequence() const   { return Tail; }
+
+    T& Front()              { return *Slots[Head]; }
+    T& Back()               { return *Slots[Tail]; }
+
+    // Returns the entry with the given sequence number, or nullptr if we don't have it.
+    T* Find(uint32_t Sequence)
+    {
+        if (Count == 0)
+        {
+            return nullptr;
+        }
+        return Slots[Sequence % Capacity].get();
+    }
+
+    // Adds an entry, returns false if the slot for this sequence is already taken, which
+    // means either a duplicate or that the queue has wrapped all the way around.
+    bool Insert(uint32_t Sequence, std::unique_ptr<T> Value)
+    {
+        Sequence %= Capacity;
+
+        if (Slots.empty())
+        {
+            Slots.resize(Capacity);
+        }
+
+        if (Slots[Sequence])
+        {
+            return false;
+        }
+
+        if (Count == 0)
+        {
+            Head = Sequence;
+            Tail = Sequence;
+        }
+        else if (Distance(Head, Sequence) > Distance(Head, Tail))
+        {
+            Tail = Sequence;
+        }
+
+        Slots[Sequence] = std::move(Value);
+        Count++;
+
+        return true;
+    }
+
+    // Removes the oldest entry and returns it.
+    std::unique_ptr<T> PopFront()
+    {
+        if (Count == 0)
+        {
+            return nullptr;
+        }
+
+        std::unique_ptr<T> Result = std::move(Slots[Head]);
+        Count--;
+
+        // Skip over any gaps in the sequence to the next entry.
+        while (Count > 0)
+        {
+            Head = (Head + 1) % Capacity;
+            if (Slots[Head])
+            {
+                break;
+            }
+        }
+
+        return Result;
+    }
+
+private:
+
+    static uint32_t Distance(uint32_t From, uint32_t To)
+    {
+        return (To + Capacity - From) % Capacity;
+    }
+
+    std::vector<std::unique_ptr<T>> Slots;
+
+    uint32_t Head = 0;
+    uint32_t Tail = 0;
+    size_t Count = 0;
+
+};
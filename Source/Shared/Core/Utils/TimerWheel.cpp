@@ -0,0 +1,88 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#include "Shared/Core/Utils/TimerWheel.h"
+
+#include <algorithm>
+
+TimerWheel::TimerWheel(double InResolution, size_t SlotCount)
+    : Resolution(InResolution)
+{
+    Slots.resize(std::max((size_t)1, SlotCount));
+}
+
+uint64_t TimerWheel::GetTick(double Time)
+{
+    return (uint64_t)(std::max(0.0, Time) / Resolution);
+}
+
+void TimerWheel::RequestWake(double Time)
+{
+    uint64_t Tick = GetTick(Time);
+    if (HasAdvanced)
+    {
+        uint64_t LastTick = CurrentTick + Slots.size() - 1;
+        if (Tick < CurrentTick)
+        {
+            Tick = CurrentTick;
+        }
+        else if (Tick > LastTick)
+        {
+            Tick = LastTick;
+            Time = LastTick * Resolution;
+        }
+    }
+
+    Slot& WakeSlot = Slots[Tick % Slots.size()];
+    if (!WakeSlot.HasWake || Time < WakeSlot.WakeTime)
+    {
+        WakeSlot.WakeTime = Time;
+        WakeSlot.HasWake = true;
+    }
+}
+
+void TimerWheel::Advance(double CurrentTime)
+{
+    uint64_t NowTick = GetTick(CurrentTime);
+    if (!HasAdvanced)
+    {
+        CurrentTick = NowTick;
+        HasAdvanced = true;
+    }
+
+    // If we've fallen more than a full rotation behind every slot needs checking, but only once.
+    uint64_t TickCount = std::min((uint64_t)Slots.size(), (NowTick - std::min(NowTick, CurrentTick)) + 1);
+    for (uint64_t i = 0; i < TickCount; i++)
+    {
+        Slot& TickSlot = Slots[(CurrentTick + i) % Slots.size()];
+
+        if (TickSlot.HasWake && TickSlot.WakeTime <= CurrentTime)
+        {
+            TickSlot.HasWake = false;
+        }
+    }
+
+    CurrentTick = std::max(CurrentTick, NowTick);
+}
+
+double TimerWheel::GetTimeUntilNextExpiry(double CurrentTime, double MaxTime)
+{
+    uint64_t EndTick = std::min(GetTick(CurrentTime + MaxTime), CurrentTick + Slots.size() - 1);
+
+    for (uint64_t Tick = CurrentTick; Tick <= EndTick; Tick++)
+    {
+        Slot& TickSlot = Slots[Tick % Slots.size()];
+        if (TickSlot.HasWake)
+        {
+            return std::clamp(TickSlot.WakeTime - CurrentTime, 0.0, MaxTime);
+        }
+    }
+
+    return MaxTime;
+}
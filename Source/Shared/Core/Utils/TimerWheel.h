@@ -0,0 +1,56 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Hashed timer wheel of wake requests. Time is divided into fixed resolution ticks, each tick 
+// maps onto a slot in a circular array, so requesting a wake is constant time regardless of 
+// how many are outstanding. This is used for the large number of short lived deadlines
+// (retransmits, acks, timeouts, etc) the server has at any point.
+
+class TimerWheel
+{
+public:
+    TimerWheel(double Resolution = 0.001, size_t SlotCount = 1024);
+
+    // Requests that whoever is waiting on the wheel is woken up no later than the given
+    // time. Nothing is run, this just bounds the wait. Requests landing in the same slot are
+    // merged so this is cheap to call every frame. Requests beyond the end of the wheel are
+    // clamped to it, the caller is expected to re-request when woken.
+    void RequestWake(double Time);
+
+    // Clears any expired wake requests.
+    void Advance(double CurrentTime);
+
+    // Gets the number of seconds until the next wake request is due, or MaxTime if nothing is
+    // due before then.
+    double GetTimeUntilNextExpiry(double CurrentTime, double MaxTime);
+
+private:
+    struct Slot
+    {
+        double WakeTime = 0.0;
+        bool HasWake = false;
+    };
+
+    uint64_t GetTick(double Time);
+
+    double Resolution;
+
+    std::vector<Slot> Slots;
+
+    // Tick that was last processed by Advance.
+    uint64_t CurrentTick = 0;
+    bool HasAdvanced = false;
+
+};
@@ -0,0 +1,203 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#include "Shared/Core/Utils/WorkerPool.h"
+#include "Shared/Core/Utils/Logging.h"
+
+#include <algorithm>
+
+WorkerPool::Strand::Strand(WorkerPool& InPool)
+    : Pool(InPool)
+{
+}
+
+void WorkerPool::Strand::Submit(Task InTask)
+{
+    // Nothing to run it on, so just run it now. Keeps things working if the pool
+    // has been stopped while connections are still being torn down.
+    if (!Pool.IsRunning())
+    {
+        WaitIdle();
+        InTask();
+        return;
+    }
+
+    {
+        std::scoped_lock lock(Mutex);
+
+        Tasks.push_back(std::move(InTask));
+        if (Scheduled)
+        {
+            return;
+        }
+
+        Scheduled = true;
+    }
+
+    Pool.Schedule(shared_from_this());
+}
+
+void WorkerPool::Strand::WaitIdle()
+{
+    std::unique_lock lock(Mutex);
+    IdleCvar.wait(lock, [this]() { return !Scheduled && Tasks.empty(); });
+}
+
+void WorkerPool::Strand::Run()
+{
+    for (size_t i = 0; i < k_max_tasks_per_run; i++)
+    {
+        Task NextTask;
+        {
+            std::scoped_lock lock(Mutex);
+            if (Tasks.empty())
+            {
+                Scheduled = false;
+                IdleCvar.notify_all();
+                return;
+            }
+
+            NextTask = std::move(Tasks.front());
+            Tasks.pop_front();
+        }
+
+        NextTask();
+    }
+
+    // Still got work, go to the back of the queue so other strands get a look in.
+    {
+        std::scoped_lock lock(Mutex);
+        if (Tasks.empty())
+        {
+            Scheduled = false;
+            IdleCvar.notify_all();
+            return;
+        }
+    }
+
+    Pool.Schedule(shared_from_this());
+}
+
+WorkerPool::~WorkerPool()
+{
+    Stop();
+}
+
+WorkerPool& WorkerPool::Get()
+{
+    static WorkerPool Instance;
+    return Instance;
+}
+
+bool WorkerPool::Start(int ThreadCount)
+{
+    std::scoped_lock lock(Mutex);
+
+    if (Running)
+    {
+        return true;
+    }
+
+    if (ThreadCount <= 0)
+    {
+        ThreadCount = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+
+    ShuttingDown = false;
+
+    for (int i = 0; i < ThreadCount; i++)
+    {
+        Threads.push_back(std::make_unique<std::thread>([this]() {
+            ThreadEntry();
+        }));
+    }
+
+    Running = true;
+
+    Log("Started %i worker threads.", ThreadCount);
+
+    return true;
+}
+
+void WorkerPool::Stop()
+{
+    {
+        std::scoped_lock lock(Mutex);
+
+        if (!Running)
+        {
+            return;
+        }
+
+        ShuttingDown = true;
+    }
+
+    WorkCvar.notify_all();
+
+    // Threads only exit once the ready queue is empty, so anything already submitted still runs.
+    for (auto& Thread : Threads)
+    {
+        Thread->join();
+    }
+
+    std::scoped_lock lock(Mutex);
+    Threads.clear();
+    Running = false;
+}
+
+std::shared_ptr<WorkerPool::Strand> WorkerPool::CreateStrand()
+{
+    return std::make_shared<Strand>(*this);
+}
+
+void WorkerPool::Schedule(std::shared_ptr<Strand> InStrand)
+{
+    {
+        std::scoped_lock lock(Mutex);
+
+        // Once stopping the workers may have already seen an empty queue and exited, so anything
+        // queued now might never be run. Run it on the calling thread instead, the strand is marked
+        // as scheduled so nothing else will be running it.
+        if (!ShuttingDown)
+        {
+            ReadyStrands.push_back(std::move(InStrand));
+            InStrand = nullptr;
+        }
+    }
+
+    if (InStrand)
+    {
+        InStrand->Run();
+        return;
+    }
+
+    WorkCvar.notify_one();
+}
+
+void WorkerPool::ThreadEntry()
+{
+    while (true)
+    {
+        std::shared_ptr<Strand> NextStrand;
+        {
+            std::unique_lock lock(Mutex);
+            WorkCvar.wait(lock, [this]() { return !ReadyStrands.empty() || ShuttingDown; });
+
+            if (ReadyStrands.empty())
+            {
+                return;
+            }
+
+            NextStrand = std::move(ReadyStrands.front());
+            ReadyStrands.pop_front();
+        }
+
+        NextStrand->Run();
+    }
+}
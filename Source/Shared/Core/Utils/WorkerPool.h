@@ -0,0 +1,96 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+
+// Process-wide pool of worker threads used to take cpu heavy but self contained work (decrypting,
+// decompressing and parsing incoming packets, etc) off the main server thread.
+//
+// Work is submitted through strands rather than to the pool directly. Tasks submitted to the same
+// strand run one at a time in the order they were submitted, while different strands run in parallel.
+// Giving each connection its own strand keeps its packets in order without any locking in the tasks.
+
+class WorkerPool
+{
+public:
+    using Task = std::function<void()>;
+
+    class Strand
+        : public std::enable_shared_from_this<Strand>
+    {
+    public:
+        Strand(WorkerPool& InPool);
+
+        // Queues a task to run after all tasks previously submitted to this strand. Safe to call from any thread.
+        void Submit(Task InTask);
+
+        // Blocks until every task submitted to this strand has finished running.
+        void WaitIdle();
+
+    private:
+        friend class WorkerPool;
+
+        // Runs queued tasks on the calling worker thread.
+        void Run();
+
+        WorkerPool& Pool;
+
+        std::mutex Mutex;
+        std::condition_variable IdleCvar;
+        std::deque<Task> Tasks;
+
+        // True while the strand is queued on, or being run by, a worker thread.
+        bool Scheduled = false;
+
+        // Maximum tasks run in one go before the strand gives other strands a turn.
+        static inline constexpr size_t k_max_tasks_per_run = 16;
+    };
+
+public:
+    ~WorkerPool();
+
+    static WorkerPool& Get();
+
+    // Starts the worker threads. 0 creates one thread per hardware thread.
+    bool Start(int ThreadCount);
+
+    // Finishes any queued work and stops all worker threads.
+    void Stop();
+
+    bool IsRunning() { return Running; }
+
+    size_t GetThreadCount() { return Threads.size(); }
+
+    std::shared_ptr<Strand> CreateStrand();
+
+private:
+
+    void Schedule(std::shared_ptr<Strand> InStrand);
+
+    void ThreadEntry();
+
+    std::mutex Mutex;
+    std::condition_variable WorkCvar;
+    std::deque<std::shared_ptr<Strand>> ReadyStrands;
+
+    std::vector<std::unique_ptr<std::thread>> Threads;
+
+    std::atomic<bool> Running = false;
+    bool ShuttingDown = false;
+
+};
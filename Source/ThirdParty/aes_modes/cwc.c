@@ -27,6 +27,7 @@ Issue Date: 21/07/2009
 
 
 #include "cwc.h"
+#include "cwc_ni.h"
 #include "mode_hdr.h"
 
 #if defined(__cplusplus)
@@ -956,6 +957,11 @@ ret_type cwc_encrypt_message(               /* encrypt an entire message    */
             unsigned long tag_len,          /* and its length in bytes      */
             cwc_ctx ctx[1])                 /* the mode context             */
 {
+#if defined( CWC_NI_POSSIBLE )
+    if(cwc_ni_available())
+        return cwc_ni_encrypt_message(iv, iv_len, hdr, hdr_len, msg, msg_len, tag, tag_len, ctx);
+#endif
+
     cwc_init_message(iv, iv_len, ctx);
     cwc_auth_header(hdr, hdr_len, ctx);
     cwc_encrypt(msg, msg_len, ctx);
@@ -975,6 +981,11 @@ ret_type cwc_decrypt_message(               /* decrypt an entire message    */
 {   uint8_t local_tag[CBLK_LEN];
     ret_type rr;
 
+#if defined( CWC_NI_POSSIBLE )
+    if(cwc_ni_available())
+        return cwc_ni_decrypt_message(iv, iv_len, hdr, hdr_len, msg, msg_len, tag, tag_len, ctx);
+#endif
+
     cwc_init_message(iv, iv_len, ctx);
     cwc_auth_header(hdr, hdr_len, ctx);
     cwc_decrypt(msg, msg_len, ctx);
@@ -0,0 +1,274 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+/*
+    See cwc_ni.h. The hash arithmetic here deliberately mirrors do_cwc and
+    cwc_compute_tag in cwc.c step for step (including their partial modular
+    reductions) so the tags produced are identical, not just congruent.
+*/
+
+#include "cwc_ni.h"
+
+#if defined( CWC_NI_POSSIBLE )
+
+#include <string.h>
+#include <cpuid.h>
+#include <x86intrin.h>
+
+#define CWC_NI_TARGET   __attribute__((target("aes,sse4.1")))
+
+#define ABLK_LEN        CWC_ABLK_SIZE
+#define CBLK_LEN        CWC_CBLK_SIZE
+#define CTR_PARALLEL    4
+
+/* the nonce length cwc defines, cwc_init_message always reads this many  */
+#define CWC_NI_IV_LEN   11
+
+typedef unsigned __int128 cwc_u128;
+
+#define TOP_BIT         ((cwc_u128)1 << 127)
+
+int cwc_ni_available(void)
+{
+    static int test = -1;
+    if(test < 0)
+    {
+        unsigned int a, b, c, d;
+        if(!__get_cpuid(1, &a, &b, &c, &d))
+            test = 0;
+        else
+            test = (c & bit_AES) && (c & bit_SSE4_1);
+    }
+    return test;
+}
+
+/* Carter-Wegman hash state, in the same form do_cwc uses   */
+
+typedef struct
+{   cwc_u128    hash;
+    cwc_u128    zval;
+} cwc_ni_hash;
+
+static cwc_u128 load_be_words(const uint32_t w[4])
+{
+    return ((cwc_u128)w[0] << 96) | ((cwc_u128)w[1] << 64)
+         | ((cwc_u128)w[2] << 32) | (cwc_u128)w[3];
+}
+
+/* one iteration of the hash on a 12 byte block, see do_cwc */
+
+static inline void hash_block(cwc_ni_hash* h, const unsigned char in[ABLK_LEN])
+{   uint32_t w[3];
+    cwc_u128 s, ll, lh, hl, hh, mid, lo, hi;
+    uint64_t s0, s1, z0, z1;
+
+    /* do_cwc treats the block as native order 32 bit words */
+    memcpy(w, in, sizeof(w));
+    s = (((cwc_u128)w[0] << 64) | ((cwc_u128)w[1] << 32) | (cwc_u128)w[2]) + h->hash;
+
+    /* full 256 bit product of the sum and the hash key     */
+    s0 = (uint64_t)s; s1 = (uint64_t)(s >> 64);
+    z0 = (uint64_t)h->zval; z1 = (uint64_t)(h->zval >> 64);
+
+    ll = (cwc_u128)s0 * z0;
+    lh = (cwc_u128)s0 * z1;
+    hl = (cwc_u128)s1 * z0;
+    hh = (cwc_u128)s1 * z1;
+
+    mid = (ll >> 64) + (uint64_t)lh + (uint64_t)hl;
+    lo = (mid << 64) | (uint64_t)ll;
+    hi = hh + (lh >> 64) + (hl >> 64) + (mid >> 64);
+
+    /* reduce mod 2^127 - 1 as 2 * hi + lo                  */
+    hi <<= 1;
+    if(lo & TOP_BIT)
+    {
+        lo &= ~TOP_BIT;
+        hi |= 1;
+    }
+
+    h->hash = hi + lo;
+    if(h->hash & TOP_BIT)
+    {
+        h->hash &= ~TOP_BIT;
+        h->hash += 1;
+    }
+}
+
+/* hash a buffer, zero padding the final partial block      */
+
+static void hash_buffer(cwc_ni_hash* h, const unsigned char data[], unsigned long len)
+{   unsigned char last[ABLK_LEN];
+    unsigned long cnt = 0;
+
+    for(; cnt + ABLK_LEN <= len; cnt += ABLK_LEN)
+        hash_block(h, data + cnt);
+
+    if(cnt < len)
+    {
+        memset(last, 0, sizeof(last));
+        memcpy(last, data + cnt, len - cnt);
+        hash_block(h, last);
+    }
+}
+
+CWC_NI_TARGET
+static inline __m128i encrypt_block(__m128i b, const __m128i* ks, unsigned int rounds)
+{   unsigned int r;
+
+    b = _mm_xor_si128(b, _mm_loadu_si128(ks));
+    for(r = 1; r < rounds; ++r)
+        b = _mm_aesenc_si128(b, _mm_loadu_si128(ks + r));
+    return _mm_aesenclast_si128(b, _mm_loadu_si128(ks + rounds));
+}
+
+/* xor the CTR keystream into the data, block 1 onwards     */
+
+CWC_NI_TARGET
+static void crypt_buffer(const unsigned char iv[], unsigned char data[], unsigned long len, const cwc_ctx ctx[1])
+{   const __m128i* ks = (const __m128i*)ctx->enc_ctx->ks;
+    unsigned int rounds = ctx->enc_ctx->inf.b[0] >> 4, r, i;
+    unsigned char ctr[CBLK_LEN], last[CBLK_LEN];
+    __m128i base, b[CTR_PARALLEL], k;
+    unsigned long cnt = 0;
+    uint32_t counter = 1;
+
+    ctr[0] = 0x80;
+    memcpy(ctr + 1, iv, CWC_NI_IV_LEN);
+    memset(ctr + 12, 0, 4);
+    base = _mm_loadu_si128((const __m128i*)ctr);
+
+    /* several independent blocks at a time keeps the aes unit busy */
+    for(; cnt + CTR_PARALLEL * CBLK_LEN <= len; cnt += CTR_PARALLEL * CBLK_LEN)
+    {
+        k = _mm_loadu_si128(ks);
+        for(i = 0; i < CTR_PARALLEL; ++i)
+            b[i] = _mm_xor_si128(_mm_insert_epi32(base, (int)__builtin_bswap32(counter + i), 3), k);
+        counter += CTR_PARALLEL;
+
+        for(r = 1; r < rounds; ++r)
+        {
+            k = _mm_loadu_si128(ks + r);
+            for(i = 0; i < CTR_PARALLEL; ++i)
+                b[i] = _mm_aesenc_si128(b[i], k);
+        }
+
+        k = _mm_loadu_si128(ks + rounds);
+        for(i = 0; i < CTR_PARALLEL; ++i)
+        {
+            __m128i* p = (__m128i*)(data + cnt + i * CBLK_LEN);
+            b[i] = _mm_aesenclast_si128(b[i], k);
+            _mm_storeu_si128(p, _mm_xor_si128(_mm_loadu_si128(p), b[i]));
+        }
+    }
+
+    for(; cnt + CBLK_LEN <= len; cnt += CBLK_LEN)
+    {
+        __m128i* p = (__m128i*)(data + cnt);
+        __m128i e = encrypt_block(_mm_insert_epi32(base, (int)__builtin_bswap32(counter++), 3), ks, rounds);
+        _mm_storeu_si128(p, _mm_xor_si128(_mm_loadu_si128(p), e));
+    }
+
+    if(cnt < len)
+    {
+        __m128i e = encrypt_block(_mm_insert_epi32(base, (int)__builtin_bswap32(counter), 3), ks, rounds);
+        _mm_storeu_si128((__m128i*)last, e);
+        for(i = 0; cnt < len; ++i, ++cnt)
+            data[cnt] ^= last[i];
+    }
+}
+
+/* finish the hash and encrypt it with block 0 of the keystream */
+
+CWC_NI_TARGET
+static void compute_tag(const unsigned char iv[], cwc_ni_hash* h, unsigned long hdr_len, unsigned long msg_len,
+                        unsigned char tag[CBLK_LEN], const cwc_ctx ctx[1])
+{   const __m128i* ks = (const __m128i*)ctx->enc_ctx->ks;
+    unsigned int rounds = ctx->enc_ctx->inf.b[0] >> 4, i;
+    unsigned char ctr[CBLK_LEN], hh[CBLK_LEN];
+    __m128i e;
+
+    /* 32 bit lengths, as in cwc_compute_tag    */
+    h->hash += ((cwc_u128)(uint32_t)hdr_len << 64) | (uint32_t)msg_len;
+    if(h->hash & TOP_BIT)
+    {
+        h->hash &= ~TOP_BIT;
+        h->hash += 1;
+    }
+
+    for(i = 0; i < CBLK_LEN; ++i)
+        hh[i] = (unsigned char)(h->hash >> (8 * (CBLK_LEN - 1 - i)));
+
+    ctr[0] = 0x80;
+    memcpy(ctr + 1, iv, CWC_NI_IV_LEN);
+    memset(ctr + 12, 0, 4);
+
+    e = _mm_xor_si128(encrypt_block(_mm_loadu_si128((const __m128i*)hh), ks, rounds),
+                      encrypt_block(_mm_loadu_si128((const __m128i*)ctr), ks, rounds));
+    _mm_storeu_si128((__m128i*)tag, e);
+}
+
+static void init_hash(cwc_ni_hash* h, const cwc_ctx ctx[1])
+{
+    h->hash = 0;
+    h->zval = load_be_words(ctx->zval);
+}
+
+ret_type cwc_ni_encrypt_message(
+            const unsigned char iv[],
+            unsigned long iv_len,
+            const unsigned char hdr[],
+            unsigned long hdr_len,
+            unsigned char msg[],
+            unsigned long msg_len,
+            unsigned char tag[],
+            unsigned long tag_len,
+            const cwc_ctx ctx[1])
+{   unsigned char local_tag[CBLK_LEN];
+    cwc_ni_hash h;
+
+    if(iv_len != CWC_NI_IV_LEN || tag_len > CBLK_LEN)
+        return RETURN_ERROR;
+
+    init_hash(&h, ctx);
+    hash_buffer(&h, hdr, hdr_len);
+    crypt_buffer(iv, msg, msg_len, ctx);
+    hash_buffer(&h, msg, msg_len);
+    compute_tag(iv, &h, hdr_len, msg_len, local_tag, ctx);
+
+    memcpy(tag, local_tag, tag_len);
+    return RETURN_GOOD;
+}
+
+ret_type cwc_ni_decrypt_message(
+            const unsigned char iv[],
+            unsigned long iv_len,
+            const unsigned char hdr[],
+            unsigned long hdr_len,
+            unsigned char msg[],
+            unsigned long msg_len,
+            const unsigned char tag[],
+            unsigned long tag_len,
+            const cwc_ctx ctx[1])
+{   unsigned char local_tag[CBLK_LEN];
+    cwc_ni_hash h;
+
+    if(iv_len != CWC_NI_IV_LEN || tag_len > CBLK_LEN)
+        return RETURN_ERROR;
+
+    init_hash(&h, ctx);
+    hash_buffer(&h, hdr, hdr_len);
+    hash_buffer(&h, msg, msg_len);
+    crypt_buffer(iv, msg, msg_len, ctx);
+    compute_tag(iv, &h, hdr_len, msg_len, local_tag, ctx);
+
+    return memcmp(tag, local_tag, tag_len) ? RETURN_ERROR : RETURN_GOOD;
+}
+
+#endif
@@ -0,0 +1,69 @@
+/*
+ * Dark Souls 3 - Open Server
+ * Copyright (C) 2021 Tim Leonard
+ *
+ * This program is free software; licensed under the MIT license.
+ * You should have received a copy of the license along with this program.
+ * If not, see <https://opensource.org/licenses/MIT>.
+ */
+
+/*
+    Accelerated backend for whole message CWC encryption and decryption.
+
+    The CTR keystream is generated with AES-NI several blocks at a time, and
+    the Carter-Wegman hash is evaluated with 64x64->128 bit multiplies rather
+    than the 32 bit limbs used by the portable code. The hash is mod 2^127-1
+    (not a binary field) so carry-less multiplication is of no use here.
+
+    The results are bit-for-bit identical to cwc_encrypt_message and
+    cwc_decrypt_message, which dispatch here when cwc_ni_available() is true.
+*/
+
+#ifndef _CWC_NI_H
+#define _CWC_NI_H
+
+#include "cwc.h"
+
+#if defined(__cplusplus)
+extern "C"
+{
+#endif
+
+#if defined( USE_LONGS ) && defined( __GNUC__ ) && defined( __x86_64__ )
+#  define CWC_NI_POSSIBLE
+#endif
+
+#if defined( CWC_NI_POSSIBLE )
+
+/* non-zero if the cpu supports the instructions this backend requires  */
+int cwc_ni_available(void);
+
+ret_type cwc_ni_encrypt_message(            /* encrypt an entire message    */
+            const unsigned char iv[],       /* the initialisation vector    */
+            unsigned long iv_len,           /* and its length in bytes      */
+            const unsigned char hdr[],      /* the header buffer            */
+            unsigned long hdr_len,          /* and its length in bytes      */
+            unsigned char msg[],            /* the message buffer           */
+            unsigned long msg_len,          /* and its length in bytes      */
+            unsigned char tag[],            /* the buffer for the tag       */
+            unsigned long tag_len,          /* and its length in bytes      */
+            const cwc_ctx ctx[1]);          /* the keyed mode context       */
+
+ret_type cwc_ni_decrypt_message(            /* decrypt an entire message    */
+            const unsigned char iv[],       /* the initialisation vector    */
+            unsigned long iv_len,           /* and its length in bytes      */
+            const unsigned char hdr[],      /* the header buffer            */
+            unsigned long hdr_len,          /* and its length in bytes      */
+            unsigned char msg[],            /* the message buffer           */
+            unsigned long msg_len,          /* and its length in bytes      */
+            const unsigned char tag[],      /* the buffer for the tag       */
+            unsigned long tag_len,          /* and its length in bytes      */
+            const cwc_ctx ctx[1]);          /* the keyed mode context       */
+
+#endif
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
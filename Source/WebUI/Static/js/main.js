@@ -484,6 +484,9 @@ function refreshPlayersTab()
                     <td>${player["playTime"]}</td>
                     <td>${player["connectionTime"]}</td>
                     <td>${player["antiCheatScore"]}</td>
+                    <td>${player["sendWindow"]}</td>
+                    <td>${player["roundTripTime"]}</td>
+                    <td>${player["lossRate"]}</td>
                     <td>
                         <button class="mdl-button mdl-js-button mdl-button--raised mdl-button--colored" onclick="disconnectUser(${player["playerId"]})">
                             Disconnect
@@ -679,6 +682,8 @@ function refreshDebugTab()
     {
         var timerTable = document.querySelector("#debug-timer-table-body");   
         var counterTable = document.querySelector("#debug-counter-table-body");   
+        var gaugeTable = document.querySelector("#debug-gauge-table-body");   
+        var messageTable = document.querySelector("#debug-message-table-body");   
         var logTable = document.querySelector("#debug-log-table-body");   
 
         // Update the timer list.      
@@ -712,6 +717,46 @@ function refreshDebugTab()
         }
         counterTable.innerHTML = newHtml;
         
+        // Update the gauge list.      
+        newHtml = "";
+        for (var i = 0; i < data.gauges.length; i++) 
+        {
+            var stat = data.gauges[i];
+            newHtml += `        
+                <tr>
+                    <td class="mdl-data-table__cell--non-numeric">${stat["name"]}</td>
+                    <td>${stat["current"]}</td>
+                    <td>${stat["peak"]}</td>
+                </tr>
+            `;
+        }
+        gaugeTable.innerHTML = newHtml;
+        
+        // Update the message handler list.      
+        newHtml = "";
+        for (var i = 0; i < data.messages.length; i++) 
+        {
+            var stat = data.messages[i];
+
+            var histogram = [];
+            for (var j = 0; j < stat["histogram"].length; j++)
+            {
+                histogram.push(`${stat["histogram"][j]["bucket"]}: ${stat["histogram"][j]["count"]}`);
+            }
+
+            newHtml += `        
+                <tr>
+                    <td class="mdl-data-table__cell--non-numeric">${stat["name"]}</td>
+                    <td>${stat["calls"]}</td>
+                    <td>${stat["errors"]}</td>
+                    <td>${stat["average"]}</td>
+                    <td>${stat["peak"]}</td>
+                    <td style="text-align:left;">${histogram.join(", ")}</td>
+                </tr>
+            `;
+        }
+        messageTable.innerHTML = newHtml;
+        
         // Update the debug log list.    
         newHtml = "";
         for (var i = 0; i < data.logs.length; i++) 